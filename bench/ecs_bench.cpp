@@ -0,0 +1,454 @@
+// SDL's main is not needed (components only pull SDL types in)
+#define SDL_MAIN_HANDLED
+
+// Components under test
+#include "Components/Physics.hpp"
+#include "Components/Drawing.hpp"
+
+// Entity-component systems' manager
+#include "ECS/ECS.hpp"
+
+// Timekeeping
+#include <chrono>
+
+// Result output
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+
+// Command line options
+#include <cstring>
+#include <string>
+
+// Storage and sample statistics
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <thread>
+
+/// @brief Mock timekeeping service (read-only from systems)
+struct BenchClock : public Service {
+    /// @brief Seconds simulated per sweep
+    double step = 1.0 / 120.0;
+};
+
+/// @brief Mock output service (written onto, so its systems stay on the
+/// sweeping thread)
+struct BenchSink : public Service {
+    /// @brief Entities drawn so far
+    std::size_t drawn = 0;
+};
+
+/// @brief Batch system: integrate positions over dense storage
+void IntegrateBench(std::span<Physics> bodies, std::tuple<const BenchClock&> services) {
+    const double step = std::get<0>(services).step;
+    for (Physics& body : bodies) {
+        body.position += body.velocity * step;
+    }
+}
+
+/// @brief Per-entity system: derive drawings from physics
+void FollowBench(std::tuple<const Physics&, Drawing&> components, std::tuple<> /*services*/) {
+    const Physics& body = std::get<0>(components);
+    std::get<1>(components).imageSize = body.size;
+}
+
+/// @brief Per-entity system taking IDs, writing onto a service
+void TallyBench(std::uint64_t /*entity*/, std::tuple<const Drawing&> components,
+    std::tuple<BenchSink&> services) {
+    std::get<0>(services).drawn += std::get<0>(components).imageSize.x != 0;
+}
+
+/// @brief ECS under test, shaped after the game's
+using BenchECS = ECS<
+    Physics,
+    Drawing
+>::WithServices<
+    BenchClock,
+    BenchSink
+>::WithSystems<
+    IntegrateBench,
+    FollowBench,
+    TallyBench
+>;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Measurement of a single benchmark
+    struct Result {
+        /// @brief Name of the benchmark (including entity count)
+        std::string name;
+        /// @brief Entities the ECS held
+        std::size_t entities;
+        /// @brief Samples taken
+        std::size_t samples;
+        /// @brief Median nanoseconds per operation
+        double median;
+        /// @brief Least nanoseconds per operation
+        double best;
+    };
+
+    /// @brief Options provided through the command line
+    struct Options {
+        /// @brief Most entities to benchmark with
+        std::size_t maxEntities = 1000000;
+        /// @brief Least seconds to sample each benchmark for
+        double minSeconds = 0.5;
+        /// @brief C-string path to write JSON results onto (if any)
+        const char* jsonPath = nullptr;
+        /// @brief Only run benchmarks whose names contain this (if any)
+        const char* filter = nullptr;
+    };
+
+    /// @brief Physics component of the n-th benchmark entity
+    Physics MakePhysics(std::size_t which) {
+        // (Value-initialized first, so every field is, base included)
+        Physics physics{};
+        physics.velocity = {(which % 200) - 100.0, (which % 150) - 75.0};
+        physics.position = {(which % 800) * 1.0, (which % 600) * 1.0};
+        physics.previousPosition = physics.position;
+        physics.size = {32, 32};
+        physics.angle = 0;
+
+        return physics;
+    }
+
+    /// @brief Drawing component of a benchmark entity
+    Drawing MakeDrawing() {
+        // (Value-initialized first, so every field is, base included)
+        Drawing drawing{};
+        drawing.imageSize = {32, 32};
+        drawing.textSize = {0, 0};
+
+        return drawing;
+    }
+
+    /// @brief ECS populated with entities, along with their IDs
+    struct Fixture {
+        std::unique_ptr<BenchECS> ecs = std::make_unique<BenchECS>();
+        std::vector<std::uint64_t> entities;
+
+        /// @brief Construct an ECS with its services installed
+        /// @param threads Worker threads to sweep with
+        explicit Fixture(unsigned threads = 0) {
+            ecs->InstallService(BenchClock());
+            ecs->InstallService(BenchSink());
+            ecs->SetWorkerThreads(threads);
+        }
+
+        /// @brief Add some entities, every one with both components
+        void Populate(std::size_t count) {
+            entities.reserve(count);
+            for (std::size_t which = 0; which < count; ++which) {
+                entities.push_back(ecs->AddEntity(MakePhysics(which), MakeDrawing()));
+            }
+        }
+    };
+
+    /// @brief Runs benchmarks and collects their results
+    class Suite {
+        private:
+            /// @brief Options provided through the command line
+            const Options& _options;
+
+            /// @brief Results collected so far
+            std::vector<Result> _results;
+
+        public:
+            explicit Suite(const Options& options) : _options(options) {}
+
+            /// @brief Sample a benchmark until enough time has passed
+            /// @param name Name of the benchmark
+            /// @param entities Entities the ECS holds
+            /// @param operations Operations performed by every sample
+            /// @param setup Builds the state for a sample (not timed)
+            /// @param body Performs the operations on the state (timed)
+            template <typename Setup, typename Body>
+            void Run(const std::string& name, std::size_t entities,
+                std::size_t operations, Setup&& setup, Body&& body) {
+                const std::string fullName = name + "/" + std::to_string(entities);
+                if (_options.filter != nullptr &&
+                    fullName.find(_options.filter) == std::string::npos) {
+                    return;
+                }
+
+                std::vector<double> samples;
+                double spent = 0;
+
+                // Take at least a few samples, and keep going while short
+                // on time (but don't take forever on tiny benchmarks)
+                while (samples.size() < 3 ||
+                    (spent < _options.minSeconds && samples.size() < 10000)) {
+                    auto state = setup();
+
+                    const Clock::time_point start = Clock::now();
+                    body(state);
+                    const double seconds =
+                        std::chrono::duration<double>(Clock::now() - start).count();
+
+                    spent += seconds;
+                    samples.push_back(seconds * 1E9 / std::max<std::size_t>(1, operations));
+                }
+
+                std::sort(samples.begin(), samples.end());
+                _results.push_back(Result{
+                    fullName, entities, samples.size(),
+                    samples[samples.size() / 2], samples.front()
+                });
+
+                const Result& result = _results.back();
+                std::cout
+                    << std::left << std::setw(36) << result.name << std::right
+                    << std::fixed << std::setprecision(2)
+                    << std::setw(14) << result.median
+                    << std::setw(14) << result.best
+                    << std::setw(10) << result.samples << std::endl;
+            }
+
+            /// @brief Write the results down in Google Benchmark's JSON
+            /// format (so its comparison tools apply)
+            /// @param output Stream to write onto
+            void WriteJson(std::ostream& output) const {
+                output << "{\n  \"context\": {\n"
+                    << "    \"executable\": \"ecs_bench\",\n"
+                    << "    \"num_cpus\": " << std::thread::hardware_concurrency() << "\n"
+                    << "  },\n  \"benchmarks\": [\n";
+
+                for (std::size_t which = 0; which < _results.size(); ++which) {
+                    const Result& result = _results[which];
+                    output << std::fixed << std::setprecision(3)
+                        << "    {\"name\": \"" << result.name << "\", "
+                        << "\"run_type\": \"iteration\", "
+                        << "\"iterations\": " << result.samples << ", "
+                        << "\"entities\": " << result.entities << ", "
+                        << "\"real_time\": " << result.median << ", "
+                        << "\"cpu_time\": " << result.median << ", "
+                        << "\"best_time\": " << result.best << ", "
+                        << "\"time_unit\": \"ns\"}"
+                        << (which + 1 < _results.size() ? ",\n" : "\n");
+                }
+
+                output << "  ]\n}\n";
+            }
+    };
+
+    /// @brief Run every benchmark for a given amount of entities
+    void RunAll(Suite& suite, std::size_t count) {
+        const unsigned threads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+        // Entity creation (per entity)
+        suite.Run("AddEntity", count, count,
+            [] { return Fixture(); },
+            [count](Fixture& fixture) { fixture.Populate(count); }
+        );
+
+        // Entity creation with room reserved upfront (per entity)
+        suite.Run("AddEntity/reserved", count, count,
+            [count] { Fixture fixture; fixture.ecs->ReserveEntities(count); return fixture; },
+            [count](Fixture& fixture) { fixture.Populate(count); }
+        );
+
+        // Entity destruction (per entity)
+        suite.Run("RemoveEntity", count, count,
+            [count] { Fixture fixture; fixture.Populate(count); return fixture; },
+            [](Fixture& fixture) {
+                for (std::uint64_t entity : fixture.entities) {
+                    fixture.ecs->RemoveEntity(entity);
+                }
+            }
+        );
+
+        // Iteration over every system (per entity), serially and across
+        // workers. Systems get scheduled on a first sweep beforehand
+        for (const unsigned workers : {0u, threads}) {
+            std::shared_ptr<Fixture> warm = std::make_shared<Fixture>(workers);
+            warm->Populate(count);
+            warm->ecs->Sweep();
+
+            suite.Run(workers == 0 ? "Sweep/serial" : "Sweep/parallel", count, count,
+                [warm] { return warm; },
+                [](std::shared_ptr<Fixture>& fixture) { fixture->ecs->Sweep(); }
+            );
+
+            if (threads == 0) {
+                break;
+            }
+        }
+
+        // Iteration with nine out of ten bodies asleep, so batches only
+        // cover the rest (per entity)
+        {
+            std::shared_ptr<Fixture> warm = std::make_shared<Fixture>();
+            warm->Populate(count);
+            for (std::size_t which = 0; which < warm->entities.size(); ++which) {
+                if (which % 10 != 0) {
+                    warm->ecs->SleepComponent<Physics>(warm->entities[which]);
+                }
+            }
+            warm->ecs->Sweep();
+
+            suite.Run("Sweep/sleeping", count, count,
+                [warm] { return warm; },
+                [](std::shared_ptr<Fixture>& fixture) { fixture->ecs->Sweep(); }
+            );
+        }
+
+        // Component churn: uninstall and reinstall drawings from every
+        // other entity, keeping queries up to date (per change)
+        {
+            std::shared_ptr<Fixture> warm = std::make_shared<Fixture>();
+            warm->Populate(count);
+            warm->ecs->Sweep();
+
+            suite.Run("ComponentChurn", count, count,
+                [warm] { return warm; },
+                [](std::shared_ptr<Fixture>& fixture) {
+                    BenchECS& ecs = *fixture->ecs;
+                    const std::vector<std::uint64_t>& entities = fixture->entities;
+
+                    for (std::size_t which = 0; which < entities.size(); which += 2) {
+                        ecs.UninstallComponent<Drawing>(entities[which]);
+                    }
+                    for (std::size_t which = 0; which < entities.size(); which += 2) {
+                        ecs.InstallComponent(entities[which], MakeDrawing());
+                    }
+                }
+            );
+
+            // Sweeping right after churn, with half the drawings moved
+            // around within dense storage (per entity)
+            suite.Run("Sweep/after-churn", count, count,
+                [warm] {
+                    BenchECS& ecs = *warm->ecs;
+                    for (std::size_t which = 0; which < warm->entities.size(); which += 2) {
+                        ecs.UninstallComponent<Drawing>(warm->entities[which]);
+                        ecs.InstallComponent(warm->entities[which], MakeDrawing());
+                    }
+                    return warm;
+                },
+                [](std::shared_ptr<Fixture>& fixture) { fixture->ecs->Sweep(); }
+            );
+        }
+
+        // Entity churn: destroy and recreate every other entity, recycling
+        // slots (per entity)
+        {
+            std::shared_ptr<Fixture> warm = std::make_shared<Fixture>();
+            warm->Populate(count);
+            warm->ecs->Sweep();
+
+            suite.Run("EntityChurn", count, count,
+                [warm] { return warm; },
+                [](std::shared_ptr<Fixture>& fixture) {
+                    BenchECS& ecs = *fixture->ecs;
+                    std::vector<std::uint64_t>& entities = fixture->entities;
+
+                    for (std::size_t which = 0; which < entities.size(); which += 2) {
+                        ecs.RemoveEntity(entities[which]);
+                    }
+                    for (std::size_t which = 0; which < entities.size(); which += 2) {
+                        entities[which] = ecs.AddEntity(MakePhysics(which), MakeDrawing());
+                    }
+                }
+            );
+        }
+
+        // World snapshots onto a warmed-up arena, plain and delta encoded
+        // against a sweep before, then restoring one (per entity)
+        for (const bool delta : {false, true}) {
+            std::shared_ptr<Fixture> warm = std::make_shared<Fixture>();
+            warm->Populate(count);
+            warm->ecs->Sweep();
+
+            std::shared_ptr<SnapshotArena> arena = std::make_shared<SnapshotArena>();
+            arena->SetDeltaEncoding(delta);
+            warm->ecs->Snapshot(*arena);
+
+            suite.Run(delta ? "Snapshot/delta" : "Snapshot", count, count,
+                [warm, arena] {
+                    warm->ecs->Snapshot(*arena);
+                    warm->ecs->Sweep();
+                    return std::make_pair(warm, arena);
+                },
+                [](std::pair<std::shared_ptr<Fixture>, std::shared_ptr<SnapshotArena>>& state) {
+                    state.first->ecs->Snapshot(*state.second);
+                }
+            );
+
+            if (!delta) {
+                suite.Run("Restore", count, count,
+                    [warm, arena] { return std::make_pair(warm, arena); },
+                    [](std::pair<std::shared_ptr<Fixture>, std::shared_ptr<SnapshotArena>>& state) {
+                        state.first->ecs->Restore(*state.second);
+                    }
+                );
+            }
+        }
+    }
+}
+
+/// @brief Benchmark the ECS at growing entity counts
+/// @param argc Amount of CLI arguments
+/// @param args Vector of c-string CLI arguments
+/// @return 0 on success, negative status code on error
+int main(int argc, char* args[]) {
+    // Collect the options provided
+    Options options;
+    bool validOptions = true;
+
+    for (int which = 1; validOptions && which < argc; ++which) {
+        const bool hasValue = which + 1 < argc;
+
+        try {
+            if (std::strcmp(args[which], "--max") == 0 && hasValue) {
+                options.maxEntities = std::stoull(args[++which]);
+            } else if (std::strcmp(args[which], "--min-time") == 0 && hasValue) {
+                options.minSeconds = std::stod(args[++which]);
+            } else if (std::strcmp(args[which], "--json") == 0 && hasValue) {
+                options.jsonPath = args[++which];
+            } else if (std::strcmp(args[which], "--filter") == 0 && hasValue) {
+                options.filter = args[++which];
+            } else {
+                validOptions = false;
+            }
+        } catch (const std::exception&) {
+            validOptions = false;
+        }
+    }
+
+    if (!validOptions) {
+        std::cout
+            << "Usage: " << std::endl
+            << args[0] << " [--max <entities>] [--min-time <seconds>] "
+            << "[--json <path>] [--filter <name>]" << std::endl;
+
+        return -2;
+    }
+
+    // Sweep 1k, 10k, 100k, 1M... entities (up to the most requested)
+    std::cout
+        << std::left << std::setw(36) << "Benchmark" << std::right
+        << std::setw(14) << "Median (ns)" << std::setw(14) << "Best (ns)"
+        << std::setw(10) << "Samples" << std::endl;
+
+    Suite suite(options);
+    for (std::size_t count = 1000; count <= options.maxEntities; count *= 10) {
+        RunAll(suite, count);
+    }
+
+    // Write the results down, if requested
+    if (options.jsonPath != nullptr) {
+        std::ofstream json(options.jsonPath);
+        suite.WriteJson(json);
+
+        if (!json) {
+            std::cerr << "Unable to write results onto \""
+                << options.jsonPath << "\"" << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
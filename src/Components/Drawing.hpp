@@ -9,20 +9,60 @@
 // SDL texture type
 #include <SDL.h>
 
+// Asset handles
+#include "Services/AssetID.hpp"
+
 // Fixed-size trivial array
 #include <array>
 
+// Label offset math and culling extent
+#include <cmath>
+#include <algorithm>
+
 /// @brief Size, image and display text
 class Drawing : public Component {
     public:
+        /// @brief Longest display text held (null terminator included)
+        static constexpr size_t LabelCapacity = 32;
+
         /// @brief Dimensions of given drawing
         glm::uvec2 imageSize;
         /// @brief Dimensions of given display text
         glm::uvec2 textSize;
-        /// @brief Non-owning reference to image texture
-        SDL_Texture* imageRef;
-        /// @brief Non-owning reference to display text texture
-        SDL_Texture* textRef;
+        /// @brief Handle to image asset (resolved by the asset store when
+        /// drawn, so it may still be loading)
+        AssetID image;
+        /// @brief Display text (null-terminated), laid out glyph by glyph
+        /// when drawn so it may change on any frame
+        std::array<char, LabelCapacity> label;
+        /// @brief Top-left corner of the display text, relative to the
+        /// image's center (see Layout())
+        glm::ivec2 labelOffset;
+        /// @brief Half of the width and height of a box around the image's
+        /// center covering both image (at any angle) and text, for culling
+        /// (see Layout())
+        glm::dvec2 extent;
+
+        /// @brief Precompute the label offset and extent off the current
+        /// image and text sizes (call again whenever either changes)
+        void Layout() {
+            // Keep the text centered horizontally, and below the image's
+            // radius vertically (so it never overlaps regardless of rotation)
+            const double radius = std::sqrt(
+                (double) imageSize.x * imageSize.x +
+                (double) imageSize.y * imageSize.y
+            ) / 2.0;
+
+            labelOffset = {
+                (int) ((-(double) textSize.x) / 2.0),
+                (int) radius
+            };
+
+            extent = {
+                std::max(radius, textSize.x / 2.0),
+                radius + textSize.y
+            };
+        }
 };
 
 static_assert(
@@ -13,6 +13,9 @@ class Physics : public Component {
         glm::dvec2 velocity;
         /// @brief Current position coordinates
         glm::dvec2 position;
+        /// @brief Position coordinates before the latest simulation tick
+        /// (drawing blends between both)
+        glm::dvec2 previousPosition;
         /// @brief Size of colliding box
         glm::uvec2 size;
         /// @brief Angle of orientation (degrees) (regardless of speed)
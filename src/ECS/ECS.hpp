@@ -3,6 +3,24 @@
 // ECS system & component
 #include "ECS/ECS_Core.hpp"
 
+// Dense component storage
+#include "ECS/ECS_Storage.hpp"
+
+// Parallel system scheduling
+#include "ECS/ECS_Scheduler.hpp"
+
+// Update loop pacing
+#include "ECS/ECS_Pacing.hpp"
+
+// Scope timing
+#include "ECS/ECS_Profiler.hpp"
+
+// World snapshots
+#include "ECS/ECS_Snapshot.hpp"
+
+// Multi-sweep service actions
+#include "ECS/ECS_Coroutines.hpp"
+
 // Type constraints
 #include <concepts>
 #include <type_traits>
@@ -13,6 +31,14 @@
 #include <optional>
 #include <tuple>
 #include <map>
+#include <array>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <span>
+#include <deque>
+#include <bit>
+#include <cstring>
 
 // Error reporting
 #include <exception>
@@ -20,6 +46,8 @@
 // System interfacing 
 #include <functional>
 #include <thread>
+#include <atomic>
+#include <memory>
 
 /// @brief Possible entity component systems for given components
 /// @tparam ...Components Components to pass onto systems
@@ -33,10 +61,12 @@ class ECS {
         requires Distinct<Services...>
         class WithServices {
             public:
-                /// @brief Tuple of components for a given entity
-                using Entity = std::tuple<std::optional<Components>...>;
+                /// @brief Dense pools holding every component type
+                using Pools = std::tuple<ComponentPool<Components>...>;
 
                 /// @brief IDs for a given entity
+                /// @remark Packs the entity's slot index (lower half) and
+                /// the slot's generation (upper half)
                 using EntityID = std::uint64_t;
 
                 /// @brief IDs for a given system
@@ -45,6 +75,183 @@ class ECS {
                 /// @brief IDs for a given service action
                 using ServiceActionID = std::uint64_t;
 
+                /// @brief Bitmask of component types (one bit per component,
+                /// in declaration order)
+                using Signature = std::uint64_t;
+
+                /// Make sure every component fits in a signature
+                static_assert(
+                    sizeof...(Components) < 64,
+                    "Too many component types for a signature"
+                );
+
+                /// @brief Bit assigned to a given component type in signatures
+                /// @tparam SpecificComponent Component type to look up
+                /// @return Signature with only that component's bit set
+                template <typename SpecificComponent>
+                requires AnyFrom<SpecificComponent, Components...>
+                static constexpr Signature ComponentBit() {
+                    Signature bit = 1, result = 0;
+                    ((
+                        result |= std::is_same_v<SpecificComponent, Components> ? 
+                            bit : 0,
+                        bit <<= 1
+                    ), ...);
+                    return result;
+                }
+
+                /// @brief Structural changes recorded while sweeping, to be
+                /// applied all at once when the sweep ends
+                /// @remark Every chunk of entities consumed records onto a
+                /// buffer of its own, so recording needs no synchronization.
+                /// Entities spawned through it only get IDs once applied
+                class CommandBuffer {
+                    friend class WithServices;
+
+                    private:
+                        /// @brief Kinds of recorded changes
+                        enum class Kind : std::uint8_t {
+                            Spawn, Despawn, Install, Uninstall, Sleep, Wake
+                        };
+
+                        /// @brief A single recorded change
+                        struct Command {
+                            /// @brief Kind of change
+                            Kind kind;
+                            /// @brief Components spawned, installed,
+                            /// uninstalled, put to sleep or woken up
+                            Signature components;
+                            /// @brief Entity despawned, or installed onto,
+                            /// uninstalled from, put to sleep or woken up
+                            EntityID target;
+                            /// @brief Position of each staged component value
+                            /// (by component bit)
+                            std::array<std::uint32_t, sizeof...(Components)> slots;
+                        };
+
+                        /// @brief Changes in recording order
+                        std::vector<Command> _commands;
+
+                        /// @brief Component values to spawn or install
+                        std::tuple<std::vector<Components>...> _staged;
+
+                        /// @brief Position of a component type within signatures
+                        template <typename SpecificComponent>
+                        static constexpr std::size_t SlotOf()
+                        { return std::countr_zero(ComponentBit<SpecificComponent>()); }
+
+                        /// @brief Stage a component value, for later
+                        /// @return Position of the value among those staged
+                        template <typename SpecificComponent>
+                        std::uint32_t Stage(SpecificComponent&& component) {
+                            std::vector<std::remove_cvref_t<SpecificComponent>>& staged =
+                                std::get<std::vector<std::remove_cvref_t<SpecificComponent>>>(_staged);
+
+                            staged.push_back(std::forward<SpecificComponent>(component));
+                            return static_cast<std::uint32_t>(staged.size() - 1);
+                        }
+
+                        /// @brief Forget every recorded change (keeping
+                        /// storage around for the next sweep)
+                        void Clear() {
+                            _commands.clear();
+                            (std::get<std::vector<Components>>(_staged).clear(), ...);
+                        }
+
+                    public:
+                        /// @brief Record spawning a new entity
+                        /// @tparam ...InitialComponents Types of components to
+                        /// initialize
+                        /// @param ...components Component values to
+                        /// initialize those
+                        template <typename... InitialComponents>
+                        requires Distinct<std::remove_cvref_t<InitialComponents>...> &&
+                        (AnyFrom<std::remove_cvref_t<InitialComponents>, Components...> && ...)
+                        void Spawn(InitialComponents&&... components) {
+                            Command command{Kind::Spawn, (
+                                ComponentBit<std::remove_cvref_t<InitialComponents>>()
+                                | ... | Signature{0}
+                            ), 0, {}};
+
+                            ((
+                                command.slots[SlotOf<std::remove_cvref_t<InitialComponents>>()]
+                                = Stage(std::forward<InitialComponents>(components))
+                            ), ...);
+
+                            _commands.push_back(command);
+                        }
+
+                        /// @brief Record despawning an existing entity
+                        /// @param targetID ID of entity to despawn (ignored
+                        /// if despawned by the time it is applied)
+                        void Despawn(EntityID targetID) {
+                            _commands.push_back(Command{Kind::Despawn, 0, targetID, {}});
+                        }
+
+                        /// @brief Record installing a component onto an
+                        /// existing entity
+                        /// @param targetID ID of entity to install onto
+                        /// (ignored if despawned by the time it is applied)
+                        /// @param component Component value (replacing the
+                        /// entity's own, if it has one by then, and waking
+                        /// it up)
+                        template <typename SpecificComponent>
+                        requires AnyFrom<std::remove_cvref_t<SpecificComponent>, Components...>
+                        void Install(EntityID targetID, SpecificComponent&& component) {
+                            using Installed = std::remove_cvref_t<SpecificComponent>;
+
+                            Command command{Kind::Install,
+                                ComponentBit<Installed>(), targetID, {}};
+                            command.slots[SlotOf<Installed>()] =
+                                Stage(std::forward<SpecificComponent>(component));
+
+                            _commands.push_back(command);
+                        }
+
+                        /// @brief Record uninstalling a component from an
+                        /// existing entity
+                        /// @tparam SpecificComponent Component type to uninstall
+                        /// @param targetID ID of entity to uninstall from
+                        /// (ignored if despawned or missing the component by
+                        /// the time it is applied)
+                        template <typename SpecificComponent>
+                        requires AnyFrom<SpecificComponent, Components...>
+                        void Uninstall(EntityID targetID) {
+                            _commands.push_back(Command{Kind::Uninstall,
+                                ComponentBit<SpecificComponent>(), targetID, {}});
+                        }
+
+                        /// @brief Record putting a component of an existing
+                        /// entity to sleep (see WithServices::SleepComponent())
+                        /// @tparam SpecificComponent Component type to put to sleep
+                        /// @param targetID ID of entity owning it (ignored if
+                        /// despawned or missing the component by the time it
+                        /// is applied)
+                        template <typename SpecificComponent>
+                        requires AnyFrom<SpecificComponent, Components...>
+                        void Sleep(EntityID targetID) {
+                            _commands.push_back(Command{Kind::Sleep,
+                                ComponentBit<SpecificComponent>(), targetID, {}});
+                        }
+
+                        /// @brief Record waking a component of an existing
+                        /// entity up (see WithServices::WakeComponent())
+                        /// @tparam SpecificComponent Component type to wake up
+                        /// @param targetID ID of entity owning it (ignored if
+                        /// despawned or missing the component by the time it
+                        /// is applied)
+                        template <typename SpecificComponent>
+                        requires AnyFrom<SpecificComponent, Components...>
+                        void Wake(EntityID targetID) {
+                            _commands.push_back(Command{Kind::Wake,
+                                ComponentBit<SpecificComponent>(), targetID, {}});
+                        }
+
+                        /// @brief Amount of changes recorded
+                        std::size_t Size() const
+                        { return _commands.size(); }
+                };
+
                 /// @brief Service proxy for managing the given ECS  
                 class ManagerService : Service {
                     friend class WithServices;
@@ -68,6 +275,94 @@ class ECS {
                         bool RequestStop() {
                             return _managedEcs.get().RequestStop();
                         }
+
+                        /// @brief Start or stop profiling the managed ECS
+                        /// @param enabled Whether to record timings
+                        void SetProfiling(bool enabled) {
+                            _managedEcs.get().SetProfiling(enabled);
+                        }
+
+                        /// @brief Whether the managed ECS is being profiled
+                        bool Profiling() const {
+                            return _managedEcs.get()._profiler.Enabled();
+                        }
+
+                        /// @brief Timings of the managed ECS over the latest
+                        /// sweeps
+                        /// @return Timings of the sweep, each stage, service
+                        /// action and system
+                        std::vector<ProfileEntry> Profile() const {
+                            return _managedEcs.get()._profiler.Report();
+                        }
+
+                        /// @brief Buffer of structural changes for the
+                        /// calling system (or service action) to record onto
+                        /// @return Buffer to be applied at the end of the
+                        /// current sweep
+                        /// @remark Systems may spawn and despawn through it
+                        /// safely while entities are being consumed, even
+                        /// concurrently. Anything else (e.g. jobs) must
+                        /// record from the thread sweeping the ECS, which
+                        /// throws otherwise
+                        CommandBuffer& Commands() const {
+                            if (_recording != nullptr) {
+                                return *_recording;
+                            }
+
+                            // Service actions share the front buffer, so
+                            // nobody else may record onto it meanwhile
+                            if (_sweeping != &_managedEcs.get()) {
+                                throw std::logic_error(
+                                    "Commands recorded off the thread sweeping the ECS"
+                                );
+                            }
+
+                            return _managedEcs.get()._commandBuffers.front();
+                        }
+
+                        /// @brief Copy every entity and component of the
+                        /// managed ECS onto an arena (see Snapshot())
+                        /// @param arena Arena to record the snapshot onto
+                        void Snapshot(SnapshotArena& arena) const {
+                            _managedEcs.get().Snapshot(arena);
+                        }
+
+                        /// @brief Replace every entity and component of the
+                        /// managed ECS with those of an arena's latest
+                        /// snapshot (see Restore())
+                        /// @param arena Arena holding the snapshot
+                        /// @remark Only from service actions, since systems
+                        /// may be consuming entities otherwise
+                        void Restore(SnapshotArena& arena) const {
+                            _managedEcs.get().Restore(arena);
+                        }
+
+                        /// @brief Add a batch of new entities to the managed
+                        /// ECS right away (see AddEntities())
+                        /// @param ...components Component values of each entity
+                        /// @return Valid IDs of the inserted entities, in order
+                        /// @remark Only from service actions, since systems
+                        /// may be consuming entities otherwise (they spawn
+                        /// through Commands() instead)
+                        template <typename... InitialComponents>
+                        requires (sizeof...(InitialComponents) > 0) &&
+                        Distinct<InitialComponents...> &&
+                        (AnyFrom<InitialComponents, Components...> && ...)
+                        std::vector<EntityID> AddEntities(
+                            std::span<const InitialComponents>... components) const {
+                            return _managedEcs.get().template
+                                AddEntities<InitialComponents...>(components...);
+                        }
+
+                        /// @brief Whether a component of an entity of the
+                        /// managed ECS is asleep (see Asleep())
+                        /// @tparam SpecificComponent Component type to check
+                        /// @param targetID ID of entity owning it
+                        template <typename SpecificComponent>
+                        requires AnyFrom<SpecificComponent, Components...>
+                        bool Asleep(EntityID targetID) const {
+                            return _managedEcs.get().template Asleep<SpecificComponent>(targetID);
+                        }
                 };
 
                 /// Make sure the manager service is well-defined
@@ -83,13 +378,65 @@ class ECS {
                     "Manager service cannot be a delegate service"
                 );
 
+                /// @brief Slots of every service available to systems
+                using ServiceSlots = std::tuple<
+                    std::optional<ManagerService>, 
+                    std::optional<Services>...
+                >;
+
+                /// @brief Bit assigned to a given service type in access masks
+                /// @tparam SpecificService Service type to look up
+                /// @return Mask with only that service's bit set
+                template <typename SpecificService>
+                static constexpr std::uint64_t ServiceBit() {
+                    std::uint64_t bit = 2, result = 
+                        std::is_same_v<SpecificService, ManagerService> ? 1 : 0;
+                    ((
+                        result |= std::is_same_v<SpecificService, Services> ? 
+                            bit : 0,
+                        bit <<= 1
+                    ), ...);
+                    return result;
+                }
+
                 WithServices() {
                     // Install manager service 
                     std::get<std::optional<ManagerService>>(_services) 
                     = ManagerService(*this);
                 }
+
+                /// @brief Stop the dispatched thread (if any), then destroy
+                /// coroutine service actions in flight while their services
+                /// are still around
+                ~WithServices() {
+                    if (_mainLoop.joinable()) {
+                        _mainLoop.request_stop();
+                        _mainLoop.join();
+                    }
+
+                    _serviceActions.clear();
+                }
+
+                /// @brief Entity component system with a fixed list of systems
+                /// known at compile time
+                /// @tparam ...Systems Functions to process matching entities with
+                /// @remark Systems listed here are registered on construction 
+                /// (before the ones added via AddSystem), and their bodies are
+                /// invoked directly within the iteration loop
+                template <auto... Systems>
+                class WithSystems;
             
             protected:
+                /// @brief Ticks a system consumes entities between
+                struct SystemTicks {
+                    /// @brief Tick the system last ran at (components written
+                    /// after it count as changed)
+                    ChangeTick since;
+                    /// @brief Tick the system runs at (stamped onto the
+                    /// components it writes)
+                    ChangeTick now;
+                };
+
                 /// TODO: Refactor Wrappers onto common class?
 
                 /// @brief Wrapper around a system and its given validator
@@ -99,112 +446,116 @@ class ECS {
                     public:
                         using Consumer = std::function<
                             void (
-                                std::optional<Components>&..., 
-                                std::optional<Services>&...,
-                                std::optional<ManagerService>&
+                                Pools&,
+                                const EntityRegistry&,
+                                const EntityQuery&,
+                                ServiceSlots&,
+                                SystemTicks,
+                                std::size_t,
+                                std::size_t
                             )
                         >;
 
-                        using ComponentValidator = std::function<
-                            bool (const std::optional<Components>&...)
-                        >;
-
-                        using ServiceValidator = std::function<
-                            bool (
-                                const std::optional<Services>&...,
-                                const std::optional<ManagerService>&
-                            )
-                        >;
+                        using ServiceValidator = bool (*) (const ServiceSlots&);
                     
                     private:
+                        /// @brief ID of the underlying system
+                        const SystemID _id;
+
                         /// @brief Wrapper for underlying function that consumes
-                        /// components and systems
+                        /// a range of matching entities' components and systems
                         const Consumer _consumer;
 
-                        /// @brief Whether or not the undelying system
-                        /// could consume a given entity's components
-                        const ComponentValidator _componentValidator;
-
                         /// @brief Whether or not the undelying system
                         /// could consume a given set of services
                         const ServiceValidator _serviceValidator;
 
+                        /// @brief Components required by the underlying system
+                        const Signature _signature;
+
+                        /// @brief Components and services read and written by
+                        /// the underlying system
+                        const SystemAccess _access;
+
+                        /// @brief Cached entities matching the signature
+                        /// @remark Owned by the ECS
+                        const EntityQuery* _query;
+
+                        /// @brief Whether the underlying system consumes
+                        /// batches of awake components (rather than entities)
+                        const bool _batched;
+
+                        /// @brief Ticks of the latest (or current) run
+                        SystemTicks _ticks{0, 0};
+
                     public:
                         SystemWrapper() = delete;
 
                         SystemWrapper(
+                            SystemID id,
                             const Consumer& consumerWithServices,
-                            const ComponentValidator& componentValidator,
-                            const ServiceValidator& serviceValidator
+                            ServiceValidator serviceValidator,
+                            Signature signature,
+                            SystemAccess access,
+                            const EntityQuery* query,
+                            bool batched
                         ) :
+                            _id(id),
                             _consumer(consumerWithServices), 
-                            _componentValidator(componentValidator), 
-                            _serviceValidator(serviceValidator)
+                            _serviceValidator(serviceValidator),
+                            _signature(signature),
+                            _access(access),
+                            _query(query),
+                            _batched(batched)
                         {}
 
                         /// @brief Assert that this wrapper is not invalid or
                         /// ill-informed
                         void AssertValid() const {
                             if (_consumer == nullptr ||
-                                _componentValidator == nullptr ||
-                                _serviceValidator == nullptr
+                                _serviceValidator == nullptr ||
+                                _query == nullptr
                             ) {
                                 throw std::runtime_error
                                 ("System is ill-informed");
                             }
                         }
-                
-                        /// @brief Check whether the underlying system can consume 
-                        /// components on a given entity
-                        /// @param entity Possible provided components
-                        /// @return True if it can, false otherwise
-                        bool CanConsumeComponents(const Entity& entity) const {
-                            this->AssertValid();
-
-                            return this->_componentValidator(
-                                std::get<std::optional<Components>>(entity)...
-                            );
-                        }
 
                         /// @brief Check whether the underlying system can consume
                         /// some optionally-provided services
                         /// @param services Possibly provided services
                         /// @return True if it can, false otherwise
-                        bool CanConsumeServices(
-                            const std::tuple<
-                                std::optional<ManagerService>, 
-                                std::optional<Services>...
-                            >& services
-                        ) const {
+                        bool CanConsumeServices(const ServiceSlots& services) const {
                             this->AssertValid();
+                            return this->_serviceValidator(services);
+                        }
 
-                            return this->_serviceValidator(
-                                std::get<std::optional<Services>>(services)...,
-                                std::get<std::optional<ManagerService>>(services)
-                            );
+                        /// @brief Amount of entities the underlying system would
+                        /// consume on a sweep
+                        /// @param pools Component pools to provide components from
+                        std::size_t CountEntities(Pools& pools) const {
+                            return MatchCount(pools, *_query, _signature, _batched);
                         }
 
-                        /// @brief Forward the consumption of components in a
-                        /// given entity with given services to the underlying system
+                        /// @brief Forward the consumption of components in a range of
+                        /// matching entities with given services to the underlying system
+                        /// @param pools Component pools to provide components from
+                        /// @param registry Registry to provide entity IDs from
                         /// @param services Services that may be consumed 
-                        /// @param entity Entity to provide components from
-                        void ConsumeEntity(
-                            Entity& entity,
-                            std::tuple<std::optional<ManagerService>, std::optional<Services>...>& services
+                        /// @param begin First matching entity to consume
+                        /// @param end Past-the-last matching entity to consume
+                        void ConsumeEntities(
+                            Pools& pools,
+                            const EntityRegistry& registry,
+                            ServiceSlots& services,
+                            std::size_t begin,
+                            std::size_t end
                         ) {
-                            if (! this->CanConsumeComponents(entity)) {
-                                std::invalid_argument("System cannot consume entity");
-                            }
-
                             if (! this->CanConsumeServices(services)) {
-                                std::invalid_argument("System cannot consume services");
+                                throw std::invalid_argument("System cannot consume services");
                             }
 
-                            this->_consumer(
-                                std::get<std::optional<Components>>(entity)...,
-                                std::get<std::optional<Services>>(services)...,
-                                std::get<std::optional<ManagerService>>(services)
-                            );
+                            this->_consumer(pools, registry, *_query, services, _ticks, begin, end);
                         }
                 };
 
@@ -297,12 +648,68 @@ class ECS {
                         }
                 };
 
-                /// @brief Current entities in existence
-                std::map<EntityID, Entity> _entities;
+                /// @brief Slot allocator for entities in existence
+                EntityRegistry _registry;
+
+                /// @brief Densely-packed components of entities in existence
+                Pools _pools;
+
+                /// @brief Component signature of every entity slot
+                std::vector<Signature> _signatures;
+
+                /// @brief Cached matches for each signature required by systems
+                std::map<Signature, EntityQuery> _queries;
 
                 /// @brief Current systems in existence
                 std::map<SystemID, SystemWrapper> _systems;
 
+                /// @brief Current systems grouped in stages that may run
+                /// concurrently (empty if they must be re-scheduled)
+                std::vector<std::vector<SystemWrapper*>> _stages;
+
+                /// @brief Worker threads running systems concurrently
+                /// (if any)
+                std::unique_ptr<WorkerPool> _workers;
+
+                /// @brief Least amount of entities in a worker's chunk
+                std::size_t _minChunkSize = 1024;
+
+                /// @brief Pacing of the update loop between sweeps
+                LoopPacer _pacer;
+
+                /// @brief Most time coroutine service actions may take per
+                /// sweep (zero if unbounded)
+                ActionRoutine::Clock::duration _actionBudget = ActionRoutine::Clock::duration::zero();
+
+                /// @brief Time coroutine service actions should yield by on
+                /// the current sweep
+                ActionRoutine::Clock::time_point _actionDeadline = ActionRoutine::Clock::time_point::max();
+
+                /// @brief Timings of the update loop (if enabled)
+                Profiler _profiler;
+
+                /// @brief Buffers of structural changes recorded on the
+                /// current sweep (the first one for service actions, then
+                /// one per chunk of entities consumed)
+                /// @remark Kept across sweeps, so recording rarely allocates
+                std::deque<CommandBuffer> _commandBuffers = std::deque<CommandBuffer>(1);
+
+                /// @brief Amount of buffers handed out on the current sweep
+                std::size_t _commandBuffersUsed = 1;
+
+                /// @brief Buffer the current thread records onto (while
+                /// consuming a chunk of entities)
+                static inline thread_local CommandBuffer* _recording = nullptr;
+
+                /// @brief ECS the current thread is sweeping, if any
+                static inline thread_local const WithServices* _sweeping = nullptr;
+
+                /// @brief IDs of entities spawned in bulk (kept across sweeps)
+                std::vector<EntityID> _spawnedIDs;
+
+                /// @brief Indices of entities spawned in bulk (same order)
+                std::vector<EntityIndex> _spawnedIndices;
+
                 /// @brief Current service actions in existence
                 std::map<ServiceActionID, ServiceActionWrapper> _serviceActions;
 
@@ -316,8 +723,20 @@ class ECS {
                 /// running the system loops
                 bool _localContinue = false;
 
-                /// @brief Next assignable ID for a new entity
-                EntityID _nextEntityID = 0;
+                /// @brief Whether the update loop is running (on either
+                /// the current or the dispatched thread)
+                std::atomic<bool> _running = false;
+
+                /// @brief Whether stopping was requested since the update
+                /// loop last started
+                std::atomic<bool> _stopRequested = false;
+
+                /// @brief Error that stopped the dispatched thread, if any
+                std::exception_ptr _dispatchError;
+
+                /// @brief Latest tick handed out (to system runs and
+                /// structural changes)
+                ChangeTick _changeTick = 0;
 
                 /// @brief Next assignable ID for a new system
                 SystemID _nextSystemID = 0;
@@ -334,168 +753,264 @@ class ECS {
                     return std::get<std::optional<SpecificService>>(_services);
                 }
 
-                /// @brief Access a given component in a given entity
+                /// @brief Hand out a tick later than every one before
+                inline ChangeTick NextTick()
+                { return ++_changeTick; }
+
+                /// @brief Access the pool of a given component
                 /// @tparam SpecificComponent Component type to access
-                /// @return Reference to component slot
+                /// @return Reference to component pool
                 template <typename SpecificComponent>
                 requires AnyFrom<SpecificComponent, Components...>
-                static inline std::optional<SpecificComponent>& 
-                AccessComponent(Entity& entity) {
-                    return std::get<std::optional<SpecificComponent>>(
-                        entity
-                    );
+                static inline ComponentPool<SpecificComponent>& 
+                AccessPool(Pools& pools) {
+                    return std::get<ComponentPool<SpecificComponent>>(pools);
                 }
 
-                /// @brief Pull an entity reference from storage
-                /// @param targetID Valid ID obtained via AddEntity()
-                /// @return Iterator to entity in storage
-                std::map<EntityID, Entity>::iterator SelectEntity(EntityID targetID) {
-                    // Lookup the entity
-                    typename std::map<EntityID, Entity>::iterator where = 
-                    _entities.find(targetID);
+                /// @brief Invoke a callable on every entity owning all of the
+                /// given components
+                /// @tparam ...SpecificComponents Component types to match
+                /// @param pools Component pools to provide components from
+                /// @param query Cached matches for the given components
+                /// @param begin First match to visit
+                /// @param end Past-the-last match to visit
+                /// @param function Callable taking the entity index and then
+                /// references to each matching component
+                /// @remark Single-component matches iterate over the pool's
+                /// dense array directly, the rest follow the cached matches
+                template <typename... SpecificComponents, typename Function>
+                requires (AnyFrom<SpecificComponents, Components...> && ...)
+                static void ForEachMatch(
+                    Pools& pools, const EntityQuery& query,
+                    std::size_t begin, std::size_t end,
+                    Function&& function
+                ) {
+                    if constexpr (sizeof...(SpecificComponents) == 1) {
+                        // Every entity in the pool matches
+                        (
+                            [&] {
+                                ComponentPool<SpecificComponents>& pool =
+                                AccessPool<SpecificComponents>(pools);
+                                SpecificComponents* data = pool.Data();
+                                const EntityIndex* owners = pool.Owners();
 
-                    // Assert that it is found
-                    if (where == _entities.end()) {
-                        throw std::invalid_argument("Invalid entity ID");
+                                for (std::size_t dense = begin; dense < end; ++dense) {
+                                    function(owners[dense], data[dense]);
+                                }
+                            } (),
+                        ...);
+                    } else {
+                        // Only visit entities known to match
+                        const EntityIndex* matches = query.Matches();
+
+                        for (std::size_t which = begin; which < end; ++which) {
+                            const EntityIndex entity = matches[which];
+
+                            function(
+                                entity, 
+                                AccessPool<SpecificComponents>(pools).Get(entity)...
+                            );
+                        }
                     }
+                }
 
-                    return where;
+                /// @brief Amount of entities visited by ForEachMatch
+                /// @param pools Component pools to provide components from
+                /// @param query Cached matches for the given signature
+                /// @param signature Components to match
+                /// @param awake Whether to only count awake components (of
+                /// single-component matches)
+                /// @return Amount of matches
+                static std::size_t MatchCount(
+                    Pools& pools, const EntityQuery& query, Signature signature,
+                    bool awake = false
+                ) {
+                    // Single-component matches are the whole pool (or the
+                    // awake part of it, packed first)
+                    std::size_t count = query.Size();
+                    ((
+                        signature == ComponentBit<Components>() ? 
+                        (count = awake ?
+                            AccessPool<Components>(pools).Awake() :
+                            AccessPool<Components>(pools).Size()) : 0
+                    ), ...);
+                    return count;
                 }
 
-                /// @brief Pull a system reference from storage
-                /// @param targetID Valid ID obtained via AddSystem()
-                /// @return Iterator to system in storage
-                std::map<SystemID, SystemWrapper>::iterator SelectSystem(SystemID targetID) {
-                    // Lookup the system
-                    typename std::map<SystemID, SystemWrapper>::iterator where = 
-                    _systems.find(targetID);
+                /// @brief Record that every component column in a signature
+                /// may be written at a given tick
+                /// @param signature Components written
+                /// @param tick Tick of the write
+                void TouchColumns(Signature signature, ChangeTick tick) {
+                    ((
+                        (signature & ComponentBit<Components>()) != 0 ?
+                        (AccessPool<Components>(_pools).Touch(tick), 0) : 0
+                    ), ...);
+                }
 
-                    // Assert that it is found
-                    if (where == _systems.end()) {
-                        throw std::invalid_argument("Invalid system ID");
+                /// @brief Whether a given signature satisfies a required one
+                static constexpr bool Satisfies(Signature signature, Signature required)
+                { return (signature & required) == required; }
+
+                /// @brief Retrieve (or create) the cached matches for a given
+                /// signature, and register one more user of it
+                /// @param signature Components required
+                /// @return Reference to the cached matches
+                EntityQuery& AcquireQuery(Signature signature) {
+                    auto [where, created] = _queries.try_emplace(signature);
+                    EntityQuery& query = where->second;
+
+                    // Populate newly-created queries from the living entities
+                    if (created) {
+                        PopulateQuery(signature, query);
                     }
 
-                    return where;
+                    query.users += 1;
+                    return query;
                 }
 
-                /// @brief Pull a service action reference from storage
-                /// @param targetID Valid ID obtained via AddServiceAction()
-                /// @return Iterator to service action in storage
-                std::map<ServiceActionID, ServiceActionWrapper>::iterator 
-                SelectServiceAction(ServiceActionWrapper targetID) {
-                    // Lookup the service action
-                    typename std::map<ServiceActionID, ServiceActionWrapper>::iterator 
-                    where = _serviceActions.find(targetID);
+                /// @brief Fill some cached matches in from the living entities
+                /// @param signature Components required
+                /// @param query Cached matches (empty)
+                void PopulateQuery(Signature signature, EntityQuery& query) {
+                    for (EntityIndex entity = 0; entity < _signatures.size(); ++entity) {
+                        query.Refresh(entity, 
+                            IsAlive(entity) && Satisfies(_signatures[entity], signature)
+                        );
+                    }
+                }
 
-                    // Assert that it is found
-                    if (where == _serviceActions.end()) {
-                        throw std::invalid_argument("Invalid service action ID");
+                /// @brief Make sure freshly-restored slots, signatures,
+                /// components and cached matches all agree with each other
+                /// @remark Throws runtime_error if they don't
+                void CheckRestored() const {
+                    // Every slot must have a signature, dead only if unused
+                    if (_signatures.size() != _registry.Capacity()) {
+                        throw std::runtime_error("Malformed snapshot (inconsistent signatures)");
                     }
 
-                    return where;
-                }
+                    for (EntityIndex entity = 0; entity < _signatures.size(); ++entity) {
+                        if (_registry.InUse(entity) != IsAlive(entity)) {
+                            throw std::runtime_error("Malformed snapshot (inconsistent signatures)");
+                        }
+                    }
 
-            public:
-                /// @brief Add a new entity to the ECS
-                /// @tparam ...InitialComponents Component to start with
-                /// @param ...components Component values to initialize those
-                /// @return A valid ID for further transactions with the entity
-                template <typename... InitialComponents>
-                requires Distinct<InitialComponents...> &&
-                (AnyFrom<InitialComponents, Components...> && ...)
-                EntityID AddEntity(InitialComponents&&... components) {
-                    // Assign and then increment the latest assignable ID
-                    EntityID targetID = _nextEntityID++;
+                    // Every component must be owned by an entity in use,
+                    // whose signature holds it
+                    ([&] {
+                        const ComponentPool<Components>& pool = std::get<ComponentPool<Components>>(_pools);
 
-                    // Default-initialize components
-                    std::tuple<std::optional<Components>...> tuple;
+                        for (std::size_t dense = 0; dense < pool.Size(); ++dense) {
+                            const EntityIndex owner = pool.Owners()[dense];
 
-                    // Fold over passed components and assign each to
-                    // its proper field on the tuple
-                    (
-                        [&] {
-                            std::get<
-                                std::optional<typeof components>
-                            >(tuple) = components;
-                        } (),
-                    ...);
+                            if (!IsAlive(owner) || (_signatures[owner] & ComponentBit<Components>()) == 0) {
+                                throw std::runtime_error("Malformed snapshot (inconsistent pool)");
+                            }
+                        }
+                    } (), ...);
 
-                    // Insert written tuple onto storage
-                    _entities.emplace(targetID, std::move(tuple));
+                    // And every cached match must be in use and satisfy its
+                    // query's signature
+                    for (const auto& [signature, query] : _queries) {
+                        for (std::size_t which = 0; which < query.Size(); ++which) {
+                            const EntityIndex entity = query.Matches()[which];
 
-                    // Report ID of inserted entity
-                    return targetID;
+                            if (!IsAlive(entity) || !Satisfies(_signatures[entity], signature)) {
+                                throw std::runtime_error("Malformed snapshot (inconsistent matches)");
+                            }
+                        }
+                    }
                 }
 
-                /// @brief Remove an existing entity from the ECS
-                /// @param targetID Valid ID obtained via AddEntity()
-                void RemoveEntity(const EntityID& targetID) {
-                    // Remove entity from storage
-                    _entities.erase(SelectEntity(targetID));
+                /// @brief Unregister a user of the cached matches for a given
+                /// signature, dropping them if unused
+                /// @param signature Components required
+                void ReleaseQuery(Signature signature) {
+                    auto where = _queries.find(signature);
+
+                    if (where != _queries.end() && --(where->second.users) == 0) {
+                        _queries.erase(where);
+                    }
                 }
 
-                /// @brief Install a given component to an existing entity in the ECS
-                /// @tparam SpecificComponent Component type to install
-                /// @param targetID Valid ID obtained via AddEntity()
-                /// @param component Data to assign to component
-                template <typename SpecificComponent>
-                requires AnyFrom<SpecificComponent, Components...>
-                void InstallComponent(EntityID targetID, SpecificComponent&& component) {
-                    // Get a reference to the entities' slot 
-                    std::optional<SpecificComponent>& slot = 
-                    AccessComponent<*SelectEntity(targetID)>();
+                /// @brief Whether a given entity slot is in use
+                /// @param entity Index of entity slot
+                /// @return True if it is, false otherwise
+                inline bool IsAlive(EntityIndex entity) const {
+                    return entity < _signatures.size() && _signatures[entity] != DeadSignature;
+                }
 
-                    // Sanity check the component is missing
-                    if (slot) {
-                        throw std::exception("Component already installed");
+                /// @brief Signature reserved for unused entity slots
+                static constexpr Signature DeadSignature = ~Signature{0};
+
+                /// @brief Assign a new signature to an entity, and bring the
+                /// cached matches up to date
+                /// @param entity Index of entity to update
+                /// @param signature New signature (or DeadSignature if freed)
+                void UpdateSignature(EntityIndex entity, Signature signature) {
+                    if (entity >= _signatures.size()) {
+                        _signatures.resize(entity + 1, DeadSignature);
                     }
 
-                    // Install the component
-                    slot = component;
+                    _signatures[entity] = signature;
+
+                    const bool alive = signature != DeadSignature;
+                    for (auto& [required, query] : _queries) {
+                        query.Refresh(entity, alive && Satisfies(signature, required));
+                    }
                 }
 
-                /// @brief Uninstall a given component from an existing entity in the ECS
-                /// @tparam SpecificComponent Component type to uninstall
-                /// @param targetID Valid ID obtained via AddEntity()
-                template <typename SpecificComponent>
-                requires AnyFrom<SpecificComponent, Components...>
-                void UninstallComponent(EntityID targetID) {
-                    // Get a reference to the entities' slot 
-                    std::optional<SpecificComponent>& slot = 
-                    AccessComponent<*SelectEntity(targetID)>();
+                /// @brief Record the signature of a batch of freshly-created
+                /// entities, all sharing it, and append them onto every query
+                /// they match
+                /// @param entities Indices of entities not in any query yet
+                /// @param signature Signature of all of them
+                void UpdateSignatures(std::span<const EntityIndex> entities, Signature signature) {
+                    if (entities.empty()) {
+                        return;
+                    }
 
-                    // Sanity check the component is present
-                    if (!slot) {
-                        throw std::exception("Component already uninstalled");
+                    const EntityIndex highest = *std::max_element(entities.begin(), entities.end());
+                    if (highest >= _signatures.size()) {
+                        _signatures.resize(highest + 1, DeadSignature);
                     }
 
-                    // Uninstall the component
-                    slot.reset();
-                }
+                    for (const EntityIndex entity : entities) {
+                        _signatures[entity] = signature;
+                    }
 
-                /// TODO: Lots of boilerplate. Refactor into generic call?
+                    // Matching is decided once for the whole batch
+                    for (auto& [required, query] : _queries) {
+                        if (Satisfies(signature, required)) {
+                            query.Append(entities);
+                        }
+                    }
+                }
 
-                /// @brief Add a given system to the ECS
-                /// @tparam ...SpecificComponents Components qualified-types to consider in system
-                /// @tparam ...SpecificServices Services qualified-types to use in system
-                /// @param system System to process matching entities
-                /// @return A valid ID for further transactions with the system
-                template<typename... SpecificComponents, typename... SpecificServices>
-                /// Components map 1-to-1 to those in ECS, and must also be references
-                requires Distinct<
-                    std::remove_cvref_t<SpecificComponents>...
+                /// @brief Whether a pack of qualified types can be consumed as
+                /// components by a system
+                /// @remark They must map 1-to-1 to those in ECS, and must also
+                /// be references (or change filters over references)
+                template <typename... SpecificComponents>
+                static constexpr bool consumableComponents = Distinct<
+                    std::remove_cvref_t<Unfiltered<SpecificComponents>>...
                 > && (
                     AnyFrom<
-                        std::remove_cvref_t<SpecificComponents>,
+                        std::remove_cvref_t<Unfiltered<SpecificComponents>>,
                         Components...
                     > 
                     && ...
                 ) && (
-                    std::is_reference_v<SpecificComponents>
+                    std::is_reference_v<Unfiltered<SpecificComponents>>
                     && ...
-                )
-                /// Services must do so as well...
-                && Distinct<
+                );
+
+                /// @brief Whether a pack of qualified types can be consumed as
+                /// services by a system or service action
+                /// @remark They must map 1-to-1 to those in ECS (or the manager
+                /// service), and must also be references
+                template <typename... SpecificServices>
+                static constexpr bool consumableServices = Distinct<
                     std::remove_cvref_t<SpecificServices>...
                 > && ((
                         AnyFrom<
@@ -511,49 +1026,801 @@ class ECS {
                 && (
                     std::is_reference_v<SpecificServices>
                     && ...
-                )
-                SystemID AddSystem(
-                    void (*system) (std::tuple<SpecificComponents...>, 
-                    std::tuple<SpecificServices...>)
-                ) {
-                    // Define validators for the system...
-                    
-                    // - On components
-                    typename SystemWrapper::ComponentValidator componentValidator = [](
-                        const std::optional<Components>&... components
-                    ) {
-                        // Check for applicability across the fold of specific component 
-                        // types required by the system
-                        if (!(
-                            [&] {
-                                // On each one, if the corresponding passed component is
-                                // available, confirm applicability
-                                return std::get<
-                                    std::add_lvalue_reference_t<
-                                        std::add_const_t<
-                                            std::optional<
-                                                std::remove_cvref_t<SpecificComponents>
-                                            >
-                                        >
-                                    >
-                                >(std::tie(components...)).has_value();
-                            } ()
-                            && ...)
-                        ) {
-                            return false;
-                        }
+                );
 
-                        // If no discard ocurred, accept consumption
-                        return true;
-                    };
+                /// @brief Compile-time description of a system function
+                /// @tparam SystemFunction Type of system function
+                template <typename SystemFunction>
+                struct SystemTraits {
+                    /// @brief Whether the function is a well-formed system
+                    static constexpr bool valid = false;
+                };
 
-                    // - On services
-                    typename SystemWrapper::ServiceValidator serviceValidator = [](
+                template <typename... SpecificComponents, typename... SpecificServices>
+                struct SystemTraits<
+                    void (*) (std::tuple<SpecificComponents...>, 
+                    std::tuple<SpecificServices...>)
+                > {
+                    /// @brief Whether the function is a well-formed system
+                    static constexpr bool valid = 
+                        consumableComponents<SpecificComponents...> &&
+                        consumableServices<SpecificServices...>;
+
+                    /// @brief Whether the system consumes batches of awake
+                    /// components (rather than entities)
+                    static constexpr bool batched = false;
+
+                    /// @brief Component type consumed through a given
+                    /// qualified type (or change filter)
+                    template <typename Consumed>
+                    using ComponentOf = std::remove_cvref_t<Unfiltered<Consumed>>;
+
+                    /// @brief Whether a given qualified type (or change
+                    /// filter) writes onto its component
+                    template <typename Consumed>
+                    static constexpr bool writes =
+                        !std::is_const_v<std::remove_reference_t<Unfiltered<Consumed>>>;
+
+                    /// @brief Components required by the system
+                    static constexpr Signature signature = (
+                        ComponentBit<ComponentOf<SpecificComponents>>() 
+                        | ... | Signature{0}
+                    );
+
+                    /// @brief Components only matched when changed
+                    static constexpr Signature filters = ((
+                        ChangeFilter<SpecificComponents>::value ?
+                        ComponentBit<ComponentOf<SpecificComponents>>() :
+                        Signature{0}
+                    ) | ... | Signature{0});
+
+                    /// @brief Components and services read and written by
+                    /// the system (anything not taken by const-reference
+                    /// counts as written)
+                    static constexpr SystemAccess access{
+                        .componentReads = signature,
+                        .componentWrites = ((
+                            writes<SpecificComponents> ?
+                            ComponentBit<ComponentOf<SpecificComponents>>() :
+                            Signature{0}
+                        ) | ... | Signature{0}),
+                        .serviceReads = (
+                            ServiceBit<std::remove_cvref_t<SpecificServices>>()
+                            | ... | std::uint64_t{0}
+                        ),
+                        .serviceWrites = ((
+                            std::is_const_v<std::remove_reference_t<SpecificServices>> ?
+                            std::uint64_t{0} :
+                            ServiceBit<std::remove_cvref_t<SpecificServices>>()
+                        ) | ... | std::uint64_t{0}),
+                    };
+
+                    /// @brief Check whether the system can consume some 
+                    /// optionally-provided services
+                    /// @param services Possibly provided services
+                    /// @return True if it can, false otherwise
+                    static bool CanConsumeServices(const ServiceSlots& services) {
+                        return (
+                            std::get<
+                                std::optional<
+                                    std::remove_cvref_t<SpecificServices>
+                                >
+                            >(services).has_value()
+                            && ...
+                        );
+                    }
+
+                    /// @brief Resolve the services required by the system
+                    /// @param services Services to consume (must be available)
+                    /// @return Tuple of references to each service
+                    static inline std::tuple<SpecificServices...> ResolveServices(
+                        ServiceSlots& services
+                    ) {
+                        return std::tuple<SpecificServices...>(
+                            std::get<
+                                std::optional<
+                                    std::remove_cvref_t<SpecificServices>
+                                >
+                            >(services).value()...
+                        );
+                    }
+
+                    /// @brief Feed a range of matching entities and the required 
+                    /// services onto a visitor
+                    /// @param visitor Callable taking the entity index, the
+                    /// tuple of components and the tuple of services
+                    /// @param pools Component pools to provide components from
+                    /// @param query Cached matches for the system's signature
+                    /// @param services Services to consume (must be available)
+                    /// @param ticks Ticks to filter changes by and stamp
+                    /// writes with
+                    /// @param begin First match to consume
+                    /// @param end Past-the-last match to consume
+                    template <typename Visitor>
+                    static inline void Visit(
+                        Visitor&& visitor,
+                        Pools& pools,
+                        const EntityQuery& query,
+                        ServiceSlots& services,
+                        SystemTicks ticks,
+                        std::size_t begin,
+                        std::size_t end
+                    ) {
+                        // Skip the whole range if a filtered column went
+                        // unwritten since
+                        if constexpr (filters != 0) {
+                            if (((
+                                ChangeFilter<SpecificComponents>::value &&
+                                AccessPool<ComponentOf<SpecificComponents>>(pools)
+                                .ColumnTick() <= ticks.since
+                            ) || ...)) {
+                                return;
+                            }
+                        }
+
+                        // Resolve the services once for all entities
+                        std::tuple<SpecificServices...> specificServices =
+                            ResolveServices(services);
+
+                        // Forward the parameters to the system call
+                        ForEachMatch<ComponentOf<SpecificComponents>...>(
+                            pools, query, begin, end,
+                            [&](
+                                EntityIndex entity, 
+                                ComponentOf<SpecificComponents>&... components
+                            ) {
+                                // Only entities whose filtered components
+                                // changed since
+                                if constexpr (filters != 0) {
+                                    if (!((
+                                        !ChangeFilter<SpecificComponents>::value ||
+                                        AccessPool<ComponentOf<SpecificComponents>>(pools)
+                                        .ChangedSince(entity, ticks.since)
+                                    ) && ...)) {
+                                        return;
+                                    }
+                                }
+
+                                visitor(
+                                    entity,
+                                    std::tuple<SpecificComponents...>(components...),
+                                    specificServices
+                                );
+
+                                // Then stamp whatever it may have written
+                                ((
+                                    writes<SpecificComponents> ?
+                                    (AccessPool<ComponentOf<SpecificComponents>>(pools)
+                                    .Stamp(entity, ticks.now), 0) : 0
+                                ), ...);
+                            }
+                        );
+                    }
+
+                    /// @brief Feed a range of matching entities and the required 
+                    /// services onto a system
+                    /// @param system Callable with the system's signature
+                    /// @param pools Component pools to provide components from
+                    /// @param query Cached matches for the system's signature
+                    /// @param services Services to consume (must be available)
+                    /// @param ticks Ticks to filter changes by and stamp
+                    /// writes with
+                    /// @param begin First match to consume
+                    /// @param end Past-the-last match to consume
+                    template <typename Callable>
+                    static inline void Invoke(
+                        Callable&& system,
+                        Pools& pools,
+                        const EntityRegistry&,
+                        const EntityQuery& query,
+                        ServiceSlots& services,
+                        SystemTicks ticks,
+                        std::size_t begin,
+                        std::size_t end
+                    ) {
+                        Visit(
+                            [&](EntityIndex, auto&& components, auto& specificServices) {
+                                system(components, specificServices);
+                            },
+                            pools, query, services, ticks, begin, end
+                        );
+                    }
+                };
+
+                /// @brief Systems also taking the ID of the entity consumed
+                template <typename... SpecificComponents, typename... SpecificServices>
+                struct SystemTraits<
+                    void (*) (EntityID, std::tuple<SpecificComponents...>, 
+                    std::tuple<SpecificServices...>)
+                > : SystemTraits<
+                    void (*) (std::tuple<SpecificComponents...>, 
+                    std::tuple<SpecificServices...>)
+                > {
+                    using Base = SystemTraits<
+                        void (*) (std::tuple<SpecificComponents...>, 
+                        std::tuple<SpecificServices...>)
+                    >;
+
+                    /// @brief Feed a range of matching entities, their IDs and
+                    /// the required services onto a system
+                    /// @param system Callable with the system's signature
+                    /// @param pools Component pools to provide components from
+                    /// @param registry Registry to provide entity IDs from
+                    /// @param query Cached matches for the system's signature
+                    /// @param services Services to consume (must be available)
+                    /// @param ticks Ticks to filter changes by and stamp
+                    /// writes with
+                    /// @param begin First match to consume
+                    /// @param end Past-the-last match to consume
+                    template <typename Callable>
+                    static inline void Invoke(
+                        Callable&& system,
+                        Pools& pools,
+                        const EntityRegistry& registry,
+                        const EntityQuery& query,
+                        ServiceSlots& services,
+                        SystemTicks ticks,
+                        std::size_t begin,
+                        std::size_t end
+                    ) {
+                        Base::Visit(
+                            [&](EntityIndex entity, auto&& components, auto& specificServices) {
+                                system(registry.HandleOf(entity), components, specificServices);
+                            },
+                            pools, query, services, ticks, begin, end
+                        );
+                    }
+                };
+
+                /// @brief Systems consuming a contiguous batch of a single
+                /// component at once (e.g. to vectorize over it)
+                template <typename SpecificComponent, typename... SpecificServices>
+                struct SystemTraits<
+                    void (*) (std::span<SpecificComponent>, 
+                    std::tuple<SpecificServices...>)
+                > : SystemTraits<
+                    void (*) (std::tuple<SpecificComponent&>, 
+                    std::tuple<SpecificServices...>)
+                > {
+                    using Base = SystemTraits<
+                        void (*) (std::tuple<SpecificComponent&>, 
+                        std::tuple<SpecificServices...>)
+                    >;
+
+                    /// @brief Whether the system consumes batches of awake
+                    /// components (rather than entities)
+                    static constexpr bool batched = true;
+
+                    /// @brief Feed a range of the component's dense storage and
+                    /// the required services onto a system
+                    /// @param system Callable with the system's signature
+                    /// @param pools Component pools to provide components from
+                    /// @param ticks Ticks to stamp writes with
+                    /// @param begin First dense component to consume
+                    /// @param end Past-the-last dense component to consume
+                    /// (within the awake ones)
+                    template <typename Callable>
+                    static inline void Invoke(
+                        Callable&& system,
+                        Pools& pools,
+                        const EntityRegistry&,
+                        const EntityQuery&,
+                        ServiceSlots& services,
+                        SystemTicks ticks,
+                        std::size_t begin,
+                        std::size_t end
+                    ) {
+                        ComponentPool<std::remove_const_t<SpecificComponent>>& pool =
+                            AccessPool<std::remove_const_t<SpecificComponent>>(pools);
+                        SpecificComponent* data = pool.Data();
+
+                        system(
+                            std::span<SpecificComponent>(data + begin, end - begin),
+                            Base::ResolveServices(services)
+                        );
+
+                        // Every component handed over may have been written
+                        if constexpr (!std::is_const_v<SpecificComponent>) {
+                            pool.StampDense(begin, end, ticks.now);
+                        }
+                    }
+                };
+
+                /// @brief Register a system given a consumer invoking it
+                /// @tparam SystemFunction Type of system function
+                /// @param consumer Invokes the system on a range of matches
+                /// @return A valid ID for further transactions with the system
+                template <typename SystemFunction>
+                SystemID RegisterSystem(const typename SystemWrapper::Consumer& consumer) {
+                    using Traits = SystemTraits<SystemFunction>;
+
+                    // Keep track of the entities matching it
+                    const EntityQuery& query = AcquireQuery(Traits::signature);
+
+                    // Assign and then increment the latest assignable ID
+                    SystemID targetID = _nextSystemID++;
+                    _systems.emplace(targetID, 
+                        SystemWrapper(
+                            targetID, consumer, &Traits::CanConsumeServices, 
+                            Traits::signature, Traits::access, &query,
+                            Traits::batched
+                        )
+                    );
+
+                    // Systems must be re-scheduled
+                    _stages.clear();
+
+                    return targetID;
+                }
+
+                /// @brief Group the current systems into concurrently-runnable
+                /// stages, based on their declared accesses
+                void ScheduleSystems() {
+                    std::vector<SystemAccess> accesses;
+                    std::vector<SystemWrapper*> ordered;
+
+                    for (auto& [systemID, system] : _systems) {
+                        accesses.push_back(system._access);
+                        ordered.push_back(&system);
+                    }
+
+                    _stages.clear();
+                    for (const std::vector<std::size_t>& stage : BuildStages(accesses)) {
+                        std::vector<SystemWrapper*>& systems = _stages.emplace_back();
+                        for (std::size_t which : stage) {
+                            systems.push_back(ordered[which]);
+                        }
+                    }
+                }
+
+                /// @brief Range of matching entities consumed at once by a system
+                struct Chunk {
+                    /// @brief System consuming the range
+                    SystemWrapper* system;
+                    /// @brief First matching entity to consume
+                    std::size_t begin;
+                    /// @brief Past-the-last matching entity to consume
+                    std::size_t end;
+                    /// @brief Time consumption started at (if profiling)
+                    Profiler::Clock::time_point start{};
+                    /// @brief Time consumption finished at (if profiling)
+                    Profiler::Clock::time_point finish{};
+                    /// @brief Thread consuming the range (if profiling)
+                    std::thread::id thread{};
+                    /// @brief Buffer to record structural changes onto
+                    CommandBuffer* commands = nullptr;
+                };
+
+                /// @brief Scope within which the current thread records
+                /// structural changes onto a given buffer
+                struct Recording {
+                    /// @brief Buffer recorded onto before the scope
+                    CommandBuffer* previous;
+
+                    explicit Recording(CommandBuffer* commands) :
+                    previous(std::exchange(_recording, commands)) {}
+
+                    ~Recording()
+                    { _recording = previous; }
+                };
+
+                /// @brief Scope within which the current thread sweeps a
+                /// given ECS
+                struct Sweeping {
+                    /// @brief ECS swept before the scope
+                    const WithServices* previous;
+
+                    explicit Sweeping(const WithServices* ecs) :
+                    previous(std::exchange(_sweeping, ecs)) {}
+
+                    ~Sweeping()
+                    { _sweeping = previous; }
+                };
+
+                /// @brief Hand out a buffer to record structural changes onto
+                /// until the end of the current sweep
+                CommandBuffer& AcquireCommands() {
+                    if (_commandBuffersUsed == _commandBuffers.size()) {
+                        _commandBuffers.emplace_back();
+                    }
+
+                    return _commandBuffers[_commandBuffersUsed++];
+                }
+
+                /// @brief Allocate slots for a batch of entities
+                /// @param targetIDs Returned-by-parameter IDs of the entities
+                /// @param indices Returned-by-parameter indices of the
+                /// entities (same order and size)
+                void CreateEntities(std::span<EntityID> targetIDs,
+                    std::span<EntityIndex> indices) {
+                    _registry.CreateMany(targetIDs);
+                    std::transform(targetIDs.begin(), targetIDs.end(), indices.begin(),
+                        [] (EntityID targetID) { return EntityRegistry::IndexOf(targetID); });
+                }
+
+                /// @brief Spawn a run of consecutive spawns of the same
+                /// components in bulk (their values got staged contiguously)
+                /// @param buffer Buffer the spawns were recorded onto
+                /// @param first First spawn of the run
+                /// @param count Amount of spawns in the run
+                /// @param tick Tick to stamp the components with
+                void SpawnStaged(CommandBuffer& buffer,
+                    const typename CommandBuffer::Command& first, std::size_t count,
+                    ChangeTick tick) {
+                    _spawnedIDs.resize(count);
+                    _spawnedIndices.resize(count);
+                    CreateEntities(_spawnedIDs, _spawnedIndices);
+
+                    (
+                        [&] {
+                            if ((first.components & ComponentBit<Components>()) == 0) {
+                                return;
+                            }
+
+                            const std::vector<Components>& staged =
+                                std::get<std::vector<Components>>(buffer._staged);
+
+                            AccessPool<Components>(_pools).InsertMany(
+                                _spawnedIndices, std::span<const Components>(
+                                    staged.data() + first.slots[
+                                        CommandBuffer::template SlotOf<Components>()
+                                    ], count
+                                ), tick
+                            );
+                        } (),
+                    ...);
+
+                    UpdateSignatures(_spawnedIndices, first.components);
+                }
+
+                /// @brief Install (or replace, waking it up) a staged component
+                /// @param buffer Buffer the install was recorded onto
+                /// @param command Recorded install, onto a living entity
+                /// @param tick Tick to stamp the component with
+                void InstallStaged(CommandBuffer& buffer,
+                    const typename CommandBuffer::Command& command, ChangeTick tick) {
+                    const EntityIndex index = EntityRegistry::IndexOf(command.target);
+
+                    (
+                        [&] {
+                            if (command.components != ComponentBit<Components>()) {
+                                return;
+                            }
+
+                            ComponentPool<Components>& pool = AccessPool<Components>(_pools);
+                            Components& staged = std::get<std::vector<Components>>(buffer._staged)
+                                [command.slots[CommandBuffer::template SlotOf<Components>()]];
+
+                            if (pool.Contains(index)) {
+                                pool.Get(index) = std::move(staged);
+                                pool.Stamp(index, tick);
+                                pool.Touch(tick);
+                                pool.Wake(index);
+                                return;
+                            }
+
+                            pool.Insert(index, staged, tick);
+                            UpdateSignature(index, _signatures[index] | command.components);
+                        } (),
+                    ...);
+                }
+
+                /// @brief Uninstall a component, if still installed
+                /// @param command Recorded uninstall, from a living entity
+                void UninstallStaged(const typename CommandBuffer::Command& command) {
+                    const EntityIndex index = EntityRegistry::IndexOf(command.target);
+
+                    (
+                        [&] {
+                            ComponentPool<Components>& pool = AccessPool<Components>(_pools);
+
+                            if (command.components == ComponentBit<Components>() &&
+                                pool.Contains(index)) {
+                                pool.Erase(index);
+                                UpdateSignature(index, _signatures[index] & ~command.components);
+                            }
+                        } (),
+                    ...);
+                }
+
+                /// @brief Put a component to sleep or wake it up, if still
+                /// installed
+                /// @param command Recorded change, onto a living entity
+                /// @param asleep Whether to put it to sleep (or wake it up)
+                void SleepStaged(const typename CommandBuffer::Command& command,
+                    bool asleep) {
+                    const EntityIndex index = EntityRegistry::IndexOf(command.target);
+
+                    (
+                        [&] {
+                            ComponentPool<Components>& pool = AccessPool<Components>(_pools);
+
+                            if (command.components == ComponentBit<Components>() &&
+                                pool.Contains(index)) {
+                                asleep ? pool.Sleep(index) : pool.Wake(index);
+                            }
+                        } (),
+                    ...);
+                }
+
+                /// @brief Apply every change recorded onto a buffer, in order
+                /// @param buffer Buffer to apply (and then clear)
+                /// @param tick Tick to stamp the components written with
+                void ApplyCommands(CommandBuffer& buffer, ChangeTick tick) {
+                    using Kind = typename CommandBuffer::Kind;
+                    const auto& commands = buffer._commands;
+
+                    for (std::size_t which = 0; which < commands.size(); ) {
+                        const typename CommandBuffer::Command& command = commands[which];
+
+                        // Changes onto entities despawned since get ignored
+                        switch (command.kind) {
+                            case Kind::Spawn: {
+                                std::size_t count = 1;
+                                while (which + count < commands.size() &&
+                                    commands[which + count].kind == Kind::Spawn &&
+                                    commands[which + count].components == command.components) {
+                                    count += 1;
+                                }
+
+                                SpawnStaged(buffer, command, count, tick);
+                                which += count;
+                                continue;
+                            }
+
+                            case Kind::Despawn:
+                                if (_registry.Alive(command.target)) {
+                                    RemoveEntity(command.target);
+                                }
+                                break;
+
+                            case Kind::Install:
+                                if (_registry.Alive(command.target)) {
+                                    InstallStaged(buffer, command, tick);
+                                }
+                                break;
+
+                            case Kind::Uninstall:
+                                if (_registry.Alive(command.target)) {
+                                    UninstallStaged(command);
+                                }
+                                break;
+
+                            case Kind::Sleep:
+                            case Kind::Wake:
+                                if (_registry.Alive(command.target)) {
+                                    SleepStaged(command, command.kind == Kind::Sleep);
+                                }
+                                break;
+                        }
+
+                        which += 1;
+                    }
+
+                    buffer.Clear();
+                }
+
+                /// @brief Apply every change recorded on the current sweep,
+                /// in recording order (service actions first, then each
+                /// chunk of entities in the order they were handed out)
+                void ApplyCommands() {
+                    // Every change gets applied at once, so at the same tick
+                    const ChangeTick tick = NextTick();
+
+                    for (std::size_t which = 0; which < _commandBuffersUsed; ++which) {
+                        ApplyCommands(_commandBuffers[which], tick);
+                    }
+
+                    _commandBuffersUsed = 1;
+                }
+
+                /// @brief Run every system on a given stage
+                /// @param stage Systems that don't conflict with each other
+                /// @param stageIndex Position of the stage within the sweep
+                void SweepStage(const std::vector<SystemWrapper*>& stage, 
+                    std::size_t stageIndex) {
+                    const bool profiling = _profiler.Enabled();
+                    const Profiler::Clock::time_point stageStart = profiling ?
+                        Profiler::Clock::now() : Profiler::Clock::time_point{};
+
+                    std::vector<Chunk> chunks;
+                    std::vector<Chunk> affine;
+
+                    for (SystemWrapper* system : stage) {
+                        /// WARN: For now its a given that within a given
+                        /// ECS sweep, no services can be uninstalled.
+                        /// This means, a service remains consumable between
+                        /// entities on a given system sweep
+                        if (!system->CanConsumeServices(_services)) {
+                            continue;
+                        }
+
+                        // Pick up changes since its latest run, and stamp
+                        // its writes past them (columns are stamped here,
+                        // before any chunk gets consumed)
+                        system->_ticks = SystemTicks{system->_ticks.now, NextTick()};
+                        TouchColumns(system->_access.componentWrites, system->_ticks.now);
+
+                        // Systems writing onto services stay on this thread
+                        if (_workers == nullptr || system->_access.ThreadAffine()) {
+                            affine.push_back(Chunk{system, 0, 0});
+                            continue;
+                        }
+
+                        // The rest get their entities split into chunks
+                        const std::size_t count = system->CountEntities(_pools);
+                        const std::size_t splits = std::max<std::size_t>(1, std::min<std::size_t>(
+                            _workers->Threads() + 1, count / _minChunkSize
+                        ));
+
+                        for (std::size_t split = 0; split < splits; ++split) {
+                            chunks.push_back(Chunk{
+                                system,
+                                count * split / splits,
+                                count * (split + 1) / splits
+                            });
+                        }
+                    }
+
+                    // Hand every chunk a buffer of its own to record
+                    // structural changes onto
+                    for (std::vector<Chunk>* pending : {&chunks, &affine}) {
+                        for (Chunk& chunk : *pending) {
+                            chunk.commands = &AcquireCommands();
+                        }
+                    }
+
+                    // Consume a chunk of entities, timing it if profiling
+                    const auto consume = [this, profiling](Chunk& chunk) {
+                        if (profiling) {
+                            chunk.thread = std::this_thread::get_id();
+                            chunk.start = Profiler::Clock::now();
+                        }
+
+                        {
+                            const Recording recording(chunk.commands);
+                            chunk.system->ConsumeEntities(
+                                _pools, _registry, _services, chunk.begin, chunk.end
+                            );
+                        }
+
+                        if (profiling) {
+                            chunk.finish = Profiler::Clock::now();
+                        }
+                    };
+
+                    std::vector<WorkerPool::Task> tasks;
+                    tasks.reserve(chunks.size());
+                    for (Chunk& chunk : chunks) {
+                        tasks.push_back([&consume, &chunk] { consume(chunk); });
+                    }
+
+                    // Run thread-bound systems here, while workers take the rest
+                    const auto runAffine = [&] {
+                        for (Chunk& chunk : affine) {
+                            chunk.end = chunk.system->CountEntities(_pools);
+                            consume(chunk);
+                        }
+                    };
+
+                    if (tasks.empty()) {
+                        runAffine();
+                    } else if (tasks.size() == 1 && affine.empty()) {
+                        tasks.front()();
+                    } else {
+                        _workers->Run(tasks, runAffine);
+                    }
+
+                    // Keep track of how long each system and the whole
+                    // stage took
+                    if (profiling) {
+                        for (const std::vector<Chunk>* ran : {&chunks, &affine}) {
+                            for (const Chunk& chunk : *ran) {
+                                _profiler.Record(
+                                    Profiler::Scope::System, chunk.system->_id,
+                                    chunk.start, chunk.finish,
+                                    chunk.end - chunk.begin, chunk.thread
+                                );
+                            }
+                        }
+
+                        _profiler.Record(Profiler::Scope::Stage, stageIndex,
+                            stageStart, Profiler::Clock::now());
+                    }
+                }
+
+                /// @brief Let every installed service know the ECS starts running
+                /// @remark Services opt in by providing an OnStart() member
+                /// function (e.g. to resume work stopped by a previous run)
+                void NotifyStart() {
+                    (
+                        [&] {
+                            if constexpr (requires (Services& service) { service.OnStart(); }) {
+                                std::optional<Services>& slot = AccessService<Services>();
+                                if (slot) { slot->OnStart(); }
+                            }
+                        } (),
+                    ...);
+                }
+
+                /// @brief Let every installed service know the ECS stopped running
+                /// @remark Services opt in by providing an OnStop() member
+                /// function (e.g. to drain work still in flight)
+                void NotifyStop() {
+                    (
+                        [&] {
+                            if constexpr (requires (Services& service) { service.OnStop(); }) {
+                                std::optional<Services>& slot = AccessService<Services>();
+                                if (slot) { slot->OnStop(); }
+                            }
+                        } (),
+                    ...);
+                }
+
+                /// @brief Validate a given entity ID
+                /// @param targetID Valid ID obtained via AddEntity()
+                /// @return Index of entity in storage
+                EntityIndex SelectEntity(EntityID targetID) {
+                    // Assert that it still refers to a living entity
+                    if (!_registry.Alive(targetID)) {
+                        throw std::invalid_argument("Invalid entity ID");
+                    }
+
+                    return EntityRegistry::IndexOf(targetID);
+                }
+
+                /// @brief Pull a system reference from storage
+                /// @param targetID Valid ID obtained via AddSystem()
+                /// @return Iterator to system in storage
+                std::map<SystemID, SystemWrapper>::iterator SelectSystem(SystemID targetID) {
+                    // Lookup the system
+                    typename std::map<SystemID, SystemWrapper>::iterator where = 
+                    _systems.find(targetID);
+
+                    // Assert that it is found
+                    if (where == _systems.end()) {
+                        throw std::invalid_argument("Invalid system ID");
+                    }
+
+                    return where;
+                }
+
+                /// @brief Whether some parameters may be taken by a service
+                /// action: services map 1-to-1 to those in ECS, and must also
+                /// be references
+                template<typename... SpecificServices>
+                static constexpr bool ServiceActionParameters = Distinct<
+                    std::remove_cvref_t<SpecificServices>...
+                > && ((
+                        AnyFrom<
+                            std::remove_cvref_t<SpecificServices>,
+                            Services...
+                        >
+                        // But also consider the manager service
+                        || std::is_same_v<
+                            std::remove_cvref_t<SpecificServices>, 
+                            ManagerService
+                        >
+                    ) && ...) 
+                && (
+                    std::is_reference_v<SpecificServices>
+                    && ...
+                );
+
+                /// @brief Define a validator for a service action based on
+                /// its services
+                /// @tparam ...SpecificServices Services qualified-types used
+                /// in the service action
+                /// @return Validator accepting any services provided that
+                /// include every one it takes
+                template<typename... SpecificServices>
+                static typename ServiceActionWrapper::Validator ServiceActionValidator() {
+                    return [](
                         const std::optional<Services>&... services,
                         const std::optional<ManagerService>& managerService
                     ) {
                         // Check for applicability across the fold of specific service types 
-                        // required by the system
+                        // required by the service action
                         if (!(
                             [&]
                             {
@@ -574,56 +1841,556 @@ class ECS {
                             return false;
                         }
 
-                        // If no discard ocurred, accept consumption
-                        return true;
+                        // If no discard ocurred, accept consumption
+                        return true;
+                    };
+                }
+
+                /// @brief Pull a service action reference from storage
+                /// @param targetID Valid ID obtained via AddServiceAction()
+                /// @return Iterator to service action in storage
+                std::map<ServiceActionID, ServiceActionWrapper>::iterator 
+                SelectServiceAction(ServiceActionID targetID) {
+                    // Lookup the service action
+                    typename std::map<ServiceActionID, ServiceActionWrapper>::iterator 
+                    where = _serviceActions.find(targetID);
+
+                    // Assert that it is found
+                    if (where == _serviceActions.end()) {
+                        throw std::invalid_argument("Invalid service action ID");
+                    }
+
+                    return where;
+                }
+
+            public:
+                /// @brief Add a new entity to the ECS
+                /// @tparam ...InitialComponents Component to start with
+                /// @param ...components Component values to initialize those
+                /// @return A valid ID for further transactions with the entity
+                template <typename... InitialComponents>
+                requires Distinct<InitialComponents...> &&
+                (AnyFrom<InitialComponents, Components...> && ...)
+                EntityID AddEntity(InitialComponents&&... components) {
+                    // Allocate a slot for the entity
+                    EntityID targetID = _registry.Create();
+                    const EntityIndex index = EntityRegistry::IndexOf(targetID);
+
+                    // Fold over passed components and append each onto
+                    // its proper pool
+                    const ChangeTick tick = NextTick();
+                    (
+                        AccessPool<std::remove_cvref_t<InitialComponents>>(_pools)
+                        .Insert(index, components, tick),
+                    ...);
+
+                    // Then record which ones it has
+                    UpdateSignature(index, (
+                        ComponentBit<std::remove_cvref_t<InitialComponents>>()
+                        | ... | Signature{0}
+                    ));
+
+                    // Report ID of inserted entity
+                    return targetID;
+                }
+
+                /// @brief Add a batch of new entities to the ECS, all of them
+                /// with the same kinds of components
+                /// @tparam ...InitialComponents Types of components to initialize
+                /// @param ...components Component values of each entity (as
+                /// spans of equal length, where the i-th entity gets the i-th
+                /// value of every span)
+                /// @return Valid IDs of the inserted entities, in the same order
+                /// @remark Storage grows once per batch, and queries are matched
+                /// once per batch rather than once per entity
+                template <typename... InitialComponents>
+                requires (sizeof...(InitialComponents) > 0) &&
+                Distinct<InitialComponents...> &&
+                (AnyFrom<InitialComponents, Components...> && ...)
+                std::vector<EntityID> AddEntities(std::span<const InitialComponents>... components) {
+                    // Every entity must get a value for every component
+                    const std::size_t count = std::get<0>(
+                        std::forward_as_tuple(components...)).size();
+
+                    if (((components.size() != count) || ...)) {
+                        throw std::invalid_argument("Mismatched component batch sizes");
+                    }
+
+                    // Allocate slots for the entities
+                    std::vector<EntityID> targetIDs(count);
+                    std::vector<EntityIndex> indices(count);
+                    CreateEntities(targetIDs, indices);
+
+                    // Append each span onto its proper pool in bulk
+                    const ChangeTick tick = NextTick();
+                    (
+                        AccessPool<InitialComponents>(_pools)
+                        .InsertMany(indices, components, tick),
+                    ...);
+
+                    // Then record which ones they have
+                    UpdateSignatures(indices, (
+                        ComponentBit<InitialComponents>() | ... | Signature{0}
+                    ));
+
+                    // Report IDs of inserted entities
+                    return targetIDs;
+                }
+
+                /// @brief Remove an existing entity from the ECS
+                /// @param targetID Valid ID obtained via AddEntity()
+                void RemoveEntity(const EntityID& targetID) {
+                    const EntityIndex index = SelectEntity(targetID);
+
+                    // Remove its components from every pool they're in
+                    (
+                        [&] {
+                            ComponentPool<Components>& pool = 
+                            AccessPool<Components>(_pools);
+
+                            if (pool.Contains(index)) {
+                                pool.Erase(index);
+                            }
+                        } (),
+                    ...);
+
+                    // Then free its slot
+                    UpdateSignature(index, DeadSignature);
+                    _registry.Destroy(targetID);
+                }
+
+                /// @brief Install a given component to an existing entity in the ECS
+                /// @tparam SpecificComponent Component type to install
+                /// @param targetID Valid ID obtained via AddEntity()
+                /// @param component Data to assign to component
+                template <typename SpecificComponent>
+                requires AnyFrom<SpecificComponent, Components...>
+                void InstallComponent(EntityID targetID, SpecificComponent&& component) {
+                    // Install the component (the pool checks it is missing)
+                    const EntityIndex index = SelectEntity(targetID);
+                    AccessPool<SpecificComponent>(_pools).Insert(index, component, NextTick());
+
+                    // Then record that it has it
+                    UpdateSignature(index, 
+                        _signatures[index] | ComponentBit<SpecificComponent>()
+                    );
+                }
+
+                /// @brief Uninstall a given component from an existing entity in the ECS
+                /// @tparam SpecificComponent Component type to uninstall
+                /// @param targetID Valid ID obtained via AddEntity()
+                template <typename SpecificComponent>
+                requires AnyFrom<SpecificComponent, Components...>
+                void UninstallComponent(EntityID targetID) {
+                    // Uninstall the component (the pool checks it is present)
+                    const EntityIndex index = SelectEntity(targetID);
+                    AccessPool<SpecificComponent>(_pools).Erase(index);
+
+                    // Then record that it no longer has it
+                    UpdateSignature(index, 
+                        _signatures[index] & ~ComponentBit<SpecificComponent>()
+                    );
+                }
+
+                /// @brief Put a given component of an existing entity to
+                /// sleep, leaving it out of systems consuming batches of it
+                /// (those taking spans) until woken up
+                /// @tparam SpecificComponent Component type to put to sleep
+                /// @param targetID Valid ID obtained via AddEntity()
+                /// @remark Systems consuming entities still visit sleeping
+                /// components (so they may wake them up). Not while sweeping,
+                /// record it onto a command buffer instead
+                template <typename SpecificComponent>
+                requires AnyFrom<SpecificComponent, Components...>
+                void SleepComponent(EntityID targetID) {
+                    // The pool checks it is present
+                    const EntityIndex index = SelectEntity(targetID);
+                    ComponentPool<SpecificComponent>& pool = AccessPool<SpecificComponent>(_pools);
+
+                    if (!pool.Contains(index)) {
+                        throw std::logic_error("Entity lacks the component to put to sleep");
+                    }
+
+                    pool.Sleep(index);
+                }
+
+                /// @brief Wake a given component of an existing entity up
+                /// @tparam SpecificComponent Component type to wake up
+                /// @param targetID Valid ID obtained via AddEntity()
+                /// @remark Not while sweeping, record it onto a command
+                /// buffer instead
+                template <typename SpecificComponent>
+                requires AnyFrom<SpecificComponent, Components...>
+                void WakeComponent(EntityID targetID) {
+                    const EntityIndex index = SelectEntity(targetID);
+                    ComponentPool<SpecificComponent>& pool = AccessPool<SpecificComponent>(_pools);
+
+                    if (!pool.Contains(index)) {
+                        throw std::logic_error("Entity lacks the component to wake up");
+                    }
+
+                    pool.Wake(index);
+                }
+
+                /// @brief Whether a given component of an existing entity is
+                /// asleep
+                /// @tparam SpecificComponent Component type to check
+                /// @param targetID Valid ID obtained via AddEntity()
+                /// @return True if asleep, false if awake (or missing)
+                template <typename SpecificComponent>
+                requires AnyFrom<SpecificComponent, Components...>
+                bool Asleep(EntityID targetID) const {
+                    if (!_registry.Alive(targetID)) {
+                        throw std::invalid_argument("Invalid entity ID");
+                    }
+
+                    const EntityIndex index = EntityRegistry::IndexOf(targetID);
+                    const ComponentPool<SpecificComponent>& pool =
+                        std::get<ComponentPool<SpecificComponent>>(_pools);
+
+                    return pool.Contains(index) && pool.Asleep(index);
+                }
+
+                /// @brief Reserve room for a given amount of entities
+                /// @param capacity Amount of entities to reserve room for
+                void ReserveEntities(std::size_t capacity) {
+                    _registry.Reserve(capacity);
+                    _signatures.reserve(capacity);
+                    (AccessPool<Components>(_pools).Reserve(capacity), ...);
+                }
+
+                /// @brief Amount of entities currently in existence
+                std::size_t EntityCount() const {
+                    return _registry.Size();
+                }
+
+                /// @brief Invoke a callable on every component of a given
+                /// type, along with the ID of the entity owning it
+                /// @tparam SpecificComponent Component type to visit
+                /// @param function Callable taking the entity ID and a const
+                /// reference to the component
+                /// @remark In dense order. Not while sweeping, nor changing
+                /// the ECS from within the callable (collect IDs instead)
+                template <typename SpecificComponent, typename Function>
+                requires AnyFrom<SpecificComponent, Components...>
+                void ForEachComponent(Function&& function) const {
+                    const ComponentPool<SpecificComponent>& pool =
+                        std::get<ComponentPool<SpecificComponent>>(_pools);
+                    const SpecificComponent* data = pool.Data();
+                    const EntityIndex* owners = pool.Owners();
+
+                    for (std::size_t dense = 0; dense < pool.Size(); ++dense) {
+                        function(_registry.HandleOf(owners[dense]), data[dense]);
+                    }
+                }
+
+                /// @brief Append every component of an existing entity onto
+                /// a buffer, to unpack it elsewhere (e.g. onto another ECS
+                /// of the same type, or another process of the same build)
+                /// @param targetID Valid ID obtained via AddEntity()
+                /// @param bytes Buffer to append the packed entity onto
+                /// @remark Packs its signature and then the bytes of each
+                /// component it owns, in declaration order
+                void PackEntity(EntityID targetID, std::vector<std::byte>& bytes) const {
+                    if (!_registry.Alive(targetID)) {
+                        throw std::invalid_argument("Invalid entity ID");
+                    }
+
+                    const EntityIndex index = EntityRegistry::IndexOf(targetID);
+                    const Signature signature = _signatures[index];
+
+                    const auto append = [&bytes] (const void* data, std::size_t size) {
+                        const std::size_t offset = bytes.size();
+                        bytes.resize(offset + size);
+                        std::memcpy(bytes.data() + offset, data, size);
+                    };
+
+                    append(&signature, sizeof(signature));
+                    (
+                        [&] {
+                            if ((signature & ComponentBit<Components>()) != 0) {
+                                append(
+                                    &std::get<ComponentPool<Components>>(_pools).Get(index),
+                                    sizeof(Components)
+                                );
+                            }
+                        } (),
+                    ...);
+                }
+
+                /// @brief Add every entity packed onto a buffer (by
+                /// PackEntity(), on an ECS of the same type)
+                /// @param bytes Packed entities, back to back
+                /// @param targetIDs Returned-by-parameter IDs of the entities
+                /// added (appended in packing order)
+                /// @remark Entities get new IDs. Throws runtime_error if the
+                /// buffer is malformed, keeping the entities unpacked so far
+                void UnpackEntities(std::span<const std::byte> bytes,
+                    std::vector<EntityID>& targetIDs) {
+                    constexpr Signature known =
+                        (ComponentBit<Components>() | ... | Signature{0});
+                    const ChangeTick tick = NextTick();
+
+                    for (std::size_t offset = 0; offset < bytes.size(); ) {
+                        // Validate the whole entity before adding it
+                        Signature signature;
+                        if (bytes.size() - offset < sizeof(signature)) {
+                            throw std::runtime_error("Malformed packed entity (truncated)");
+                        }
+
+                        std::memcpy(&signature, bytes.data() + offset, sizeof(signature));
+                        offset += sizeof(signature);
+
+                        const std::size_t size = ((
+                            (signature & ComponentBit<Components>()) != 0 ?
+                            sizeof(Components) : 0
+                        ) + ... + std::size_t{0});
+
+                        if ((signature & ~known) != 0) {
+                            throw std::runtime_error("Malformed packed entity (unknown components)");
+                        }
+
+                        if (bytes.size() - offset < size) {
+                            throw std::runtime_error("Malformed packed entity (truncated)");
+                        }
+
+                        // Then copy each of its components onto its pool
+                        const EntityID targetID = _registry.Create();
+                        const EntityIndex index = EntityRegistry::IndexOf(targetID);
+
+                        (
+                            [&] {
+                                if ((signature & ComponentBit<Components>()) != 0) {
+                                    Components component;
+                                    std::memcpy(&component, bytes.data() + offset, sizeof(Components));
+                                    offset += sizeof(Components);
+
+                                    AccessPool<Components>(_pools).Insert(index, component, tick);
+                                }
+                            } (),
+                        ...);
+
+                        UpdateSignature(index, signature);
+                        targetIDs.push_back(targetID);
+                    }
+                }
+
+                /// @brief Copy every entity and component onto an arena, in
+                /// bulk (dense arrays and entity slots alike)
+                /// @param arena Arena to record the snapshot onto (reusing
+                /// its buffers, and delta encoding it if enabled)
+                /// @remark Services aren't part of snapshots. Structural
+                /// changes still being recorded aren't either, so take
+                /// snapshots between sweeps (or from service actions)
+                void Snapshot(SnapshotArena& arena) const {
+                    arena.BeginWrite();
+
+                    // Tag it with the layout of the storage it copies
+                    arena.Write<std::uint32_t>(SnapshotArena::Magic);
+                    arena.Write<std::uint32_t>(sizeof...(Components));
+                    (arena.Write<std::uint32_t>(sizeof(Components)), ...);
+
+                    // Then copy slots, signatures and components
+                    _registry.Save(arena);
+                    arena.WriteArray<Signature>(_signatures);
+                    (std::get<ComponentPool<Components>>(_pools).Save(arena), ...);
+
+                    // And the cached matches too, so entities get visited in
+                    // the very same order once restored
+                    arena.Write<std::uint64_t>(_queries.size());
+                    for (const auto& [signature, query] : _queries) {
+                        arena.Write<Signature>(signature);
+                        query.Save(arena);
+                    }
+
+                    arena.EndWrite();
+                }
+
+                /// @brief Replace every entity and component with those of
+                /// an arena's latest snapshot
+                /// @param arena Arena holding the snapshot (taken by this
+                /// same ECS type)
+                /// @remark IDs handed out before the snapshot was taken are
+                /// valid again afterwards. Throws invalid_argument if taken by
+                /// another ECS type, or runtime_error if malformed or inconsistent
+                /// (leaving no entities behind)
+                void Restore(SnapshotArena& arena) {
+                    arena.BeginRead();
+
+                    // Make sure it was taken with the same storage layout
+                    bool matches =
+                        arena.Read<std::uint32_t>() == SnapshotArena::Magic &&
+                        arena.Read<std::uint32_t>() == sizeof...(Components);
+                    ((matches = matches && arena.Read<std::uint32_t>() == sizeof(Components)), ...);
+
+                    if (!matches) {
+                        throw std::invalid_argument("Snapshot taken by another ECS type");
+                    }
+
+                    try {
+                        // Copy slots, signatures and components back
+                        _registry.Load(arena);
+                        arena.ReadArray(_signatures);
+                        const ChangeTick tick = NextTick();
+                        (AccessPool<Components>(_pools).Load(arena, tick), ...);
+
+                        // Then cached matches, walking both (sorted) sets at
+                        // once: those cached now but not back then get
+                        // populated anew, the other way around get skipped
+                        auto query = _queries.begin();
+                        const std::uint64_t queries = arena.Read<std::uint64_t>();
+
+                        for (std::uint64_t which = 0; which < queries; ++which) {
+                            const Signature signature = arena.Read<Signature>();
+
+                            for (; query != _queries.end() && query->first < signature; ++query) {
+                                query->second.Clear();
+                                PopulateQuery(query->first, query->second);
+                            }
+
+                            if (query != _queries.end() && query->first == signature) {
+                                query->second.Load(arena);
+                                ++query;
+                            } else {
+                                EntityQuery::Skip(arena);
+                            }
+                        }
+
+                        for (; query != _queries.end(); ++query) {
+                            query->second.Clear();
+                            PopulateQuery(query->first, query->second);
+                        }
+
+                        // Before accepting any of it
+                        CheckRestored();
+                        arena.EndRead();
+                    } catch (...) {
+                        // Don't leave half a world behind
+                        _registry = EntityRegistry{};
+                        _signatures.clear();
+                        ((AccessPool<Components>(_pools) = ComponentPool<Components>{}), ...);
+
+                        for (auto& [signature, query] : _queries) {
+                            query.Clear();
+                        }
+
+                        throw;
+                    }
+                }
+
+                /// TODO: Lots of boilerplate. Refactor into generic call?
+
+                /// @brief Add a given system to the ECS
+                /// @tparam ...SpecificComponents Components qualified-types to consider in system
+                /// @tparam ...SpecificServices Services qualified-types to use in system
+                /// @param system System to process matching entities
+                /// @return A valid ID for further transactions with the system
+                template<typename... SpecificComponents, typename... SpecificServices>
+                requires consumableComponents<SpecificComponents...> &&
+                consumableServices<SpecificServices...>
+                SystemID AddSystem(
+                    void (*system) (std::tuple<SpecificComponents...>, 
+                    std::tuple<SpecificServices...>)
+                ) {
+                    // Define a consumer-wrapper for it, which iterates
+                    // over a range of matching entities
+                    typename SystemWrapper::Consumer consumer = 
+                    [=](
+                        Pools& pools,
+                        const EntityRegistry& registry,
+                        const EntityQuery& query,
+                        ServiceSlots& services,
+                        SystemTicks ticks,
+                        std::size_t begin,
+                        std::size_t end
+                    ) {
+                        SystemTraits<decltype(system)>::Invoke(
+                            system, pools, registry, query, services, ticks, begin, end
+                        );
                     };
 
-                    // Define a consumer-wrapper for it as well
+                    // Report ID of inserted system
+                    return RegisterSystem<decltype(system)>(consumer);
+                }
+
+                /// @brief Add a given system, also taking the ID of every
+                /// entity consumed, to the ECS
+                /// @tparam ...SpecificComponents Components qualified-types to consider in system
+                /// @tparam ...SpecificServices Services qualified-types to use in system
+                /// @param system System to process matching entities
+                /// @return A valid ID for further transactions with the system
+                template<typename... SpecificComponents, typename... SpecificServices>
+                requires consumableComponents<SpecificComponents...> &&
+                consumableServices<SpecificServices...>
+                SystemID AddSystem(
+                    void (*system) (EntityID, std::tuple<SpecificComponents...>, 
+                    std::tuple<SpecificServices...>)
+                ) {
+                    // Define a consumer-wrapper for it, which iterates
+                    // over a range of matching entities
                     typename SystemWrapper::Consumer consumer = 
                     [=](
-                        std::optional<Components>&... components,
-                        std::optional<Services>&... services,
-                        std::optional<ManagerService>& managerService
+                        Pools& pools,
+                        const EntityRegistry& registry,
+                        const EntityQuery& query,
+                        ServiceSlots& services,
+                        SystemTicks ticks,
+                        std::size_t begin,
+                        std::size_t end
                     ) {
-                        // Forward the parameters to the system call
-                        system(
-                            std::forward_as_tuple(
-                                std::get<
-                                    std::add_lvalue_reference_t<
-                                        std::optional<
-                                            std::remove_cvref_t<SpecificComponents>
-                                        >
-                                    >
-                                >(std::tie(components...)).value()...
-                            ),
-                            std::forward_as_tuple(
-                                std::get<
-                                    std::add_lvalue_reference_t<
-                                        std::optional<
-                                            std::remove_cvref_t<SpecificServices>
-                                        >
-                                    >
-                                >(std::tie(managerService, services...)).value()...
-                            )
+                        SystemTraits<decltype(system)>::Invoke(
+                            system, pools, registry, query, services, ticks, begin, end
                         );
                     };
 
-                    // Assign and then increment the latest assignable ID
-                    SystemID targetID = _nextSystemID++;
-                    _systems.emplace(targetID, 
-                        SystemWrapper(
-                            consumer, componentValidator, serviceValidator
-                    ));
+                    // Report ID of inserted system
+                    return RegisterSystem<decltype(system)>(consumer);
+                }
 
-                    // Report ID of inserted entity
-                    return targetID;
+                /// @brief Add a given system, consuming contiguous batches of
+                /// a single component at once, to the ECS
+                /// @tparam SpecificComponent Component qualified-type to consider in system
+                /// @tparam ...SpecificServices Services qualified-types to use in system
+                /// @param system System to process batches of components
+                /// @return A valid ID for further transactions with the system
+                template<typename SpecificComponent, typename... SpecificServices>
+                requires consumableComponents<SpecificComponent&> &&
+                consumableServices<SpecificServices...>
+                SystemID AddSystem(
+                    void (*system) (std::span<SpecificComponent>, 
+                    std::tuple<SpecificServices...>)
+                ) {
+                    // Define a consumer-wrapper for it, which hands over
+                    // a range of the component's dense storage
+                    typename SystemWrapper::Consumer consumer = 
+                    [=](
+                        Pools& pools,
+                        const EntityRegistry& registry,
+                        const EntityQuery& query,
+                        ServiceSlots& services,
+                        SystemTicks ticks,
+                        std::size_t begin,
+                        std::size_t end
+                    ) {
+                        SystemTraits<decltype(system)>::Invoke(
+                            system, pools, registry, query, services, ticks, begin, end
+                        );
+                    };
+
+                    // Report ID of inserted system
+                    return RegisterSystem<decltype(system)>(consumer);
                 }
 
                 /// @brief Remove an existing system from the ECS
                 /// @param targetID Valid ID obtained via AddSystem()
                 void RemoveSystem(const SystemID& targetID) {
-                    // Remove system from storage
-                    _systems.erase(SelectSystem(targetID));
+                    // Remove system from storage, along with its matches
+                    auto where = SelectSystem(targetID);
+                    ReleaseQuery(where->second._signature);
+                    _systems.erase(where);
+
+                    // Systems must be re-scheduled
+                    _stages.clear();
                 }
 
                 /// @brief Add a given service action to the ECS
@@ -632,58 +2399,14 @@ class ECS {
                 /// @param serviceAction Service action to process matching services
                 /// @return A valid ID for further transactions with the system
                 template<typename... SpecificServices>
-                /// Services map 1-to-1 to those in ECS, and must also be references
-                requires Distinct<
-                    std::remove_cvref_t<SpecificServices>...
-                > && ((
-                        AnyFrom<
-                            std::remove_cvref_t<SpecificServices>,
-                            Services...
-                        >
-                        // But also consider the manager service
-                        || std::is_same_v<
-                            std::remove_cvref_t<SpecificServices>, 
-                            ManagerService
-                        >
-                    ) && ...) 
-                && (
-                    std::is_reference_v<SpecificServices>
-                    && ...
-                )
+                requires ServiceActionParameters<SpecificServices...>
                 ServiceActionID AddServiceAction(
                     void (*serviceAction) (SpecificServices...)
                 ) {
                     // Define a validator for the service action based on
                     // its services
-                    typename ServiceActionWrapper::Validator validator = [](
-                        const std::optional<Services>&... services,
-                        const std::optional<ManagerService>& managerService
-                    ) {
-                        // Check for applicability across the fold of specific service types 
-                        // required by the service action
-                        if (!(
-                            [&]
-                            {
-                                // On each one, if the corresponding passed service is
-                                // available, confirm applicability
-                                return std::get<
-                                    std::add_lvalue_reference_t<
-                                        std::add_const_t<
-                                            std::optional<
-                                                std::remove_cvref_t<SpecificServices>
-                                            >
-                                        >
-                                    >
-                                >(std::tie(managerService, services...)).has_value();
-                            } ()
-                            && ...)
-                        ) {
-                            return false;
-                        }
-
-                        // If no discard ocurred, accept consumption
-                        return true;
-                    };
+                    typename ServiceActionWrapper::Validator validator =
+                        ServiceActionValidator<SpecificServices...>();
 
                     // Define a consumer-wrapper for it as well
                     typename ServiceActionWrapper::Consumer consumer = 
@@ -711,6 +2434,59 @@ class ECS {
                     return targetID;
                 }
 
+                /// @brief Add a given coroutine service action to the ECS,
+                /// spanning as many sweeps as it awaits
+                /// @tparam ...SpecificServices Services qualified-types to use in the
+                /// service action
+                /// @param serviceAction Coroutine to process matching services
+                /// @return A valid ID for further transactions with the system
+                /// @remark Started on the first sweep its services are
+                /// installed, then resumed (in order with the rest of service
+                /// actions) on every sweep whatever it awaits is ready, within
+                /// the budget set by SetActionBudget(). Once done, it's started
+                /// anew on the next sweep. Uninstalling any of its services
+                /// leaves it suspended until they are installed again
+                template<typename... SpecificServices>
+                requires ServiceActionParameters<SpecificServices...>
+                ServiceActionID AddServiceAction(
+                    ActionTask (*serviceAction) (SpecificServices...)
+                ) {
+                    // Define a validator for the service action based on
+                    // its services
+                    typename ServiceActionWrapper::Validator validator =
+                        ServiceActionValidator<SpecificServices...>();
+
+                    // Define a consumer-wrapper stepping the task in flight
+                    // (shared, since consumers get copied)
+                    std::shared_ptr<ActionRoutine> routine = std::make_shared<ActionRoutine>();
+
+                    typename ServiceActionWrapper::Consumer consumer = 
+                    [=, this](
+                        std::optional<Services>&... services,
+                        std::optional<ManagerService>& managerService
+                    ) {
+                        // Forward the parameters to the coroutine, if started
+                        routine->Step(_actionDeadline, [&] {
+                            return serviceAction(
+                                std::get<
+                                    std::add_lvalue_reference_t<
+                                        std::optional<
+                                            std::remove_cvref_t<SpecificServices>
+                                        >
+                                    >
+                                >(std::tie(managerService, services...)).value()...
+                            );
+                        });
+                    };
+
+                    // Assign and then increment the latest assignable ID
+                    ServiceActionID targetID = _nextServiceActionID++;
+                    _serviceActions.emplace(targetID, ServiceActionWrapper(consumer, validator));
+
+                    // Report ID of inserted service action
+                    return targetID;
+                }
+
                 /// @brief Remove an existing service action from the ECS
                 /// @param targetID Valid ID obtained via AddServiceAction()
                 void RemoveServiceAction(const ServiceActionID& targetID) {
@@ -718,6 +2494,26 @@ class ECS {
                     _serviceActions.erase(SelectServiceAction(targetID));
                 }
 
+                /// @brief Access an installed service from outside the ECS
+                /// @tparam SpecificService Service type to access
+                /// @return Reference to service
+                /// @remark Synchronizing with the update loop (e.g. while
+                /// dispatched) is up to the service itself
+                template <typename SpecificService>
+                requires AnyFrom<SpecificService, Services...>
+                SpecificService& GetService() {
+                    // Get a reference to the service slot
+                    std::optional<SpecificService>& slot =
+                    AccessService<SpecificService>();
+
+                    // Sanity check that the service installed
+                    if (!slot) {
+                        throw std::logic_error("Service not installed");
+                    }
+
+                    return *slot;
+                }
+
                 /// @brief Install a given service to the ECS
                 /// @tparam SpecificService Service type to install
                 /// @param service Unowned service to possess
@@ -748,35 +2544,173 @@ class ECS {
 
                     // Sanity check that the service installed
                     if (!slot) {
-                        throw std::exception("Service already uninstalled");
+                        throw std::logic_error("Service already uninstalled");
                     }
 
                     // Uninstall the service
                     slot.reset();
                 }
 
+                /// @brief Set the amount of worker threads used to run systems
+                /// concurrently
+                /// @param threads Amount of threads besides the sweeping one
+                /// (zero runs every system serially)
+                /// @param minChunkSize Least amount of entities to hand to
+                /// a single worker at a time
+                /// @remark Systems taking any service by non-const reference
+                /// always run on the sweeping thread. Const member functions
+                /// of services must be safe to call concurrently
+                void SetWorkerThreads(unsigned threads, std::size_t minChunkSize = 1024) {
+                    _workers = threads == 0 ? 
+                        nullptr : std::make_unique<WorkerPool>(threads);
+                    _minChunkSize = std::max<std::size_t>(1, minChunkSize);
+                }
+
+                /// @brief Start or stop timing every stage, service action and
+                /// system on each sweep
+                /// @param enabled Whether to record timings
+                /// @param frames Sweeps to compute percentiles over
+                /// @remark Must be called from the sweeping thread while
+                /// running (e.g. via the manager service)
+                void SetProfiling(bool enabled, std::size_t frames = 120) {
+                    _profiler.Enable(enabled, frames);
+                }
+
+                /// @brief Timings over the latest sweeps
+                /// @return Timings of the sweep, each stage, service action
+                /// and system, in that order
+                std::vector<ProfileEntry> Profile() const {
+                    return _profiler.Report();
+                }
+
+                /// @brief Set the name a system gets reported by when profiling
+                /// @param targetID Valid ID obtained via AddSystem()
+                /// @param name Name to report it by
+                void NameSystem(SystemID targetID, std::string name) {
+                    _profiler.Name(Profiler::Scope::System,
+                        SelectSystem(targetID)->first, std::move(name));
+                }
+
+                /// @brief Set the name a service action gets reported by when
+                /// profiling
+                /// @param targetID Valid ID obtained via AddServiceAction()
+                /// @param name Name to report it by
+                void NameServiceAction(ServiceActionID targetID, std::string name) {
+                    _profiler.Name(Profiler::Scope::ServiceAction,
+                        SelectServiceAction(targetID)->first, std::move(name));
+                }
+
+                /// @brief Start recording every profiled scope for a trace
+                /// (also enabling profiling)
+                /// @param maxEvents Most scopes to record (later ones get dropped)
+                void StartTrace(std::size_t maxEvents = 1 << 20) {
+                    _profiler.Enable(true);
+                    _profiler.StartTrace(maxEvents);
+                }
+
+                /// @brief Stop recording scopes for a trace, and write them
+                /// down in Chrome's trace event format
+                /// @param output Stream to write the JSON trace onto
+                void WriteTrace(std::ostream& output) {
+                    _profiler.WriteTrace(output);
+                }
+
+                /// @brief Set how the update loop waits between sweeps
+                /// @param policy Policy to wait with
+                /// @param sweepsPerSecond Sweeps to pace the loop to (zero
+                /// leaves it unpaced, sweeping as fast as possible)
+                /// @remark Must be set before running the update loop
+                void SetLoopPolicy(LoopPolicy policy, double sweepsPerSecond = 0) {
+                    if (_running) {
+                        throw std::logic_error
+                        ("Loop policy can't change while running");
+                    }
+
+                    if (policy == LoopPolicy::Sleep && sweepsPerSecond <= 0) {
+                        throw std::invalid_argument
+                        ("Sleeping loop policy requires a sweep rate");
+                    }
+
+                    _pacer.Configure(policy, sweepsPerSecond);
+                }
+
+                /// @brief Set the most time coroutine service actions may take
+                /// per sweep
+                /// @param seconds Seconds to resume them for (zero leaves them
+                /// unbounded, the default)
+                /// @remark Ready ones past the budget wait until the next
+                /// sweep (resumed regardless then), instead of stalling this
+                /// one. Must be set before running the update loop
+                void SetActionBudget(double seconds) {
+                    if (_running) {
+                        throw std::logic_error
+                        ("Action budget can't change while running");
+                    }
+
+                    if (seconds < 0) {
+                        throw std::invalid_argument
+                        ("Action budget can't be negative");
+                    }
+
+                    _actionBudget = std::chrono::duration_cast<ActionRoutine::Clock::duration>(
+                        std::chrono::duration<double>(seconds));
+                }
+
                 /// @brief Perform one iteration of the update loop
                 void Sweep() {
+                    const Sweeping sweeping(this);
+                    const bool profiling = _profiler.Enabled();
+                    const Profiler::Clock::time_point sweepStart = profiling ?
+                        Profiler::Clock::now() : Profiler::Clock::time_point{};
+
+                    // Budget coroutine service actions from here on, if at all
+                    _actionDeadline = _actionBudget == ActionRoutine::Clock::duration::zero() ?
+                        ActionRoutine::Clock::time_point::max() :
+                        ActionRoutine::Clock::now() + _actionBudget;
+
                     /// Sweep over service actions...
                     for (auto& [serviceActionID, serviceAction] : _serviceActions) {
-                        if (serviceAction.CanConsumeServices(_services)) {
+                        if (!serviceAction.CanConsumeServices(_services)) {
+                            continue;
+                        }
+
+                        if (!profiling) {
                             serviceAction.ConsumeServices(_services);
+                            continue;
                         }
+
+                        const Profiler::Clock::time_point start = Profiler::Clock::now();
+                        serviceAction.ConsumeServices(_services);
+                        _profiler.Record(Profiler::Scope::ServiceAction,
+                            serviceActionID, start, Profiler::Clock::now());
                     }
 
-                    /// ... And ECS matchings independently
-                    for (auto& [systemID, system] : _systems) {
-                        /// WARN: For now its a given that within a given
-                        /// ECS sweep, no services can be uninstalled.
-                        /// This means, a service remains consumable between
-                        /// entities on a given system sweep
-                        if (system.CanConsumeServices(_services)) {
-                            for (auto& [entityID, entity] : _entities) {
-                                if (system.CanConsumeComponents(entity)) {
-                                    system.ConsumeEntity(entity, _services);
-                                }
-                            }
-                        }
+                    /// ... And ECS matchings independently, one stage at
+                    /// a time
+                    if (_stages.empty()) {
+                        ScheduleSystems();
+                    }
+
+                    for (std::size_t stage = 0; stage < _stages.size(); ++stage) {
+                        SweepStage(_stages[stage], stage);
+                    }
+
+                    /// Then apply every structural change recorded through
+                    /// the way, all at once
+                    if (!profiling) {
+                        ApplyCommands();
+                    } else {
+                        const Profiler::Clock::time_point start = Profiler::Clock::now();
+                        ApplyCommands();
+                        _profiler.Record(Profiler::Scope::Commands, 0,
+                            start, Profiler::Clock::now());
+                    }
+
+                    // Close the profiled frame, if any
+                    if (profiling) {
+                        _profiler.Record(Profiler::Scope::Sweep, 0,
+                            sweepStart, Profiler::Clock::now());
+                        _profiler.EndFrame();
                     }
 
                     return;
@@ -790,20 +2724,68 @@ class ECS {
                         ("ECS is already running in the dispatched thread");
                     }
 
+                    _running = true;
                     _localContinue = true;
-                    while (_localContinue) {
-                        this->Sweep();
+                    _stopRequested = false;
+
+                    try {
+                        this->NotifyStart();
+                        _pacer.Restart();
+                        while (_localContinue) {
+                            this->Sweep();
+                            _pacer.Wait();
+                        }
+
+                        this->NotifyStop();
+                    } catch (...) {
+                        // Still let services drain (e.g. jobs in flight)
+                        // before reporting the error
+                        try {
+                            this->NotifyStop();
+                        } catch (...) {}
+
+                        _running = false;
+                        throw;
                     }
+
+                    _running = false;
                 }
 
                 /// @brief Start running the ECS by dispatching a new thread
                 /// running the main update loop
                 void Dispatch() {
+                    if (_mainLoop.joinable()) {
+                        throw std::logic_error
+                        ("ECS is already running in the dispatched thread");
+                    }
+
+                    _running = true;
+                    _stopRequested = false;
+                    _dispatchError = nullptr;
+
                     _mainLoop = std::jthread(
                         [](std::stop_token stoken, WithServices& ecs) {
-                            while (!stoken.stop_requested()) {
-                                ecs.Sweep();
+                            // Keep any error for AwaitStop to rethrow
+                            try {
+                                ecs.NotifyStart();
+                                ecs._pacer.Restart();
+                                while (!stoken.stop_requested()) {
+                                    ecs.Sweep();
+                                    ecs._pacer.Wait();
+                                }
+
+                                ecs.NotifyStop();
+                            } catch (...) {
+                                ecs._dispatchError = std::current_exception();
+
+                                // Still let services drain (e.g. jobs in
+                                // flight) before reporting the error
+                                try {
+                                    ecs.NotifyStop();
+                                } catch (...) {}
                             }
+
+                            ecs._running = false;
                         },
                         std::ref(*this)
                     );
@@ -811,8 +2793,16 @@ class ECS {
                     return;
                 }
 
+                /// @brief Whether the ECS main update loop is running
+                /// @return True if so, false once stopped (or never started)
+                /// @remark Safe to poll from any thread, e.g. from a render
+                /// loop while dispatched
+                bool Running() const
+                { return _running.load(); }
+
                 /// @brief Wait until the ECS has stopped running on dispatched
                 /// thread (via Dispatch)
+                /// @remark Rethrows the error that stopped it, if any
                 void AwaitStop() {
                     if (!_mainLoop.joinable()) {
                         throw std::logic_error
@@ -820,6 +2810,10 @@ class ECS {
                     }
 
                     _mainLoop.join();
+
+                    if (_dispatchError) {
+                        std::rethrow_exception(std::exchange(_dispatchError, nullptr));
+                    }
                 }
 
                 /// @brief Request that the ECS stop running (either on current
@@ -827,6 +2821,8 @@ class ECS {
                 /// @return True if stop request was honored, 
                 /// false otherwise
                 bool RequestStop() {
+                    _stopRequested = true;
+
                     if (_mainLoop.joinable()) {
                         return _mainLoop.request_stop();
                     }
@@ -834,5 +2830,51 @@ class ECS {
                     _localContinue = false;
                     return true;
                 }
+
+                /// @brief Whether stopping was requested since the update loop
+                /// last started (or ever, if sweeping by hand)
+                /// @remark Safe to poll from any thread, e.g. by whoever
+                /// sweeps several ECSs in lockstep
+                bool StopRequested() const
+                { return _stopRequested.load(); }
         };
 };
+
+template <ComponentType... Components>
+requires Distinct<Components...>
+template <ServiceType... Services>
+requires Distinct<Services...>
+template <auto... Systems>
+class ECS<Components...>::WithServices<Services...>::WithSystems : 
+public ECS<Components...>::template WithServices<Services...> {
+    /// Make sure every listed system is well-formed
+    static_assert(
+        (WithServices::template SystemTraits<decltype(Systems)>::valid && ...),
+        "Listed system is ill-formed"
+    );
+
+    public:
+        WithSystems() {
+            // Register the listed systems in order, invoking each directly
+            (
+                this->template RegisterSystem<decltype(Systems)>(
+                    [](
+                        Pools& pools,
+                        const EntityRegistry& registry,
+                        const EntityQuery& query,
+                        ServiceSlots& services,
+                        SystemTicks ticks,
+                        std::size_t begin,
+                        std::size_t end
+                    ) {
+                        WithServices::template SystemTraits<decltype(Systems)>::Invoke(
+                            [](auto&&... parameters) {
+                                Systems(parameters...);
+                            },
+                            pools, registry, query, services, ticks, begin, end
+                        );
+                    }
+                ),
+            ...);
+        }
+};
@@ -43,3 +43,49 @@ concept ServiceType =
     std::derived_from<T, Service> &&
     // Forbid intersection with components
     !std::derived_from<T, Component>;
+
+/// @brief Filter over a component consumed by a system, only matching
+/// entities whose component got written since the system last ran
+/// @tparam Reference Qualified reference to the component (e.g. const T&)
+/// @remark Writes are tracked per component, conservatively: any system
+/// taking it by non-const reference (or span) counts as writing it, and so
+/// do structural changes. Filters over several components must all pass
+template <class Reference>
+requires std::is_reference_v<Reference>
+struct Changed {
+    /// @brief Qualified reference to the component
+    using Qualified = Reference;
+
+    /// @brief Component that changed
+    std::remove_reference_t<Reference>& value;
+
+    Changed(std::remove_reference_t<Reference>& component) :
+    value(component) {}
+
+    /// @brief Access the component that changed
+    std::remove_reference_t<Reference>& operator*() const
+    { return value; }
+
+    /// @brief Access the component that changed
+    std::remove_reference_t<Reference>* operator->() const
+    { return &value; }
+};
+
+/// @brief Whether a type consumed by a system is a change filter, and the
+/// qualified reference to the component it consumes either way
+template <class T>
+struct ChangeFilter {
+    static constexpr bool value = false;
+    using Qualified = T;
+};
+
+template <class Reference>
+struct ChangeFilter<Changed<Reference>> {
+    static constexpr bool value = true;
+    using Qualified = Reference;
+};
+
+/// @brief Qualified reference to the component a system consumes (minus
+/// the change filter, if any)
+template <class T>
+using Unfiltered = typename ChangeFilter<T>::Qualified;
@@ -0,0 +1,193 @@
+#pragma once
+
+// Coroutine machinery
+#include <coroutine>
+#include <utility>
+
+// Resumption conditions and budgets
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+// Error reporting
+#include <exception>
+
+/// @brief Task returned by coroutine service actions, suspended across
+/// sweeps on whatever it awaits
+/// @remark Only awaits conditions (see Until), checked once per sweep
+/// before resuming it on the thread sweeping the ECS. Starts right away,
+/// running up to its first suspension on the sweep it starts on
+class ActionTask {
+    public:
+        struct promise_type {
+            /// @brief Condition to resume on, checked once per sweep (none
+            /// resumes it on the next sweep)
+            std::function<bool ()> until;
+
+            /// @brief Error the coroutine ended with, if any
+            std::exception_ptr error;
+
+            ActionTask get_return_object()
+            { return ActionTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+            std::suspend_never initial_suspend() noexcept
+            { return {}; }
+
+            std::suspend_always final_suspend() noexcept
+            { return {}; }
+
+            void return_void() noexcept
+            {}
+
+            void unhandled_exception() noexcept
+            { error = std::current_exception(); }
+        };
+
+    private:
+        /// @brief Coroutine owned by this task
+        std::coroutine_handle<promise_type> _handle;
+
+        explicit ActionTask(std::coroutine_handle<promise_type> handle) :
+        _handle(handle) {}
+
+    public:
+        ActionTask(ActionTask&& other) noexcept :
+        _handle(std::exchange(other._handle, nullptr)) {}
+
+        ActionTask& operator=(ActionTask&& other) noexcept {
+            std::swap(_handle, other._handle);
+            return *this;
+        }
+
+        ActionTask(const ActionTask&) = delete;
+        ActionTask& operator=(const ActionTask&) = delete;
+
+        /// @brief Destroy the coroutine, wherever it's suspended at
+        ~ActionTask() {
+            if (_handle) {
+                _handle.destroy();
+            }
+        }
+
+        /// @brief Whether the coroutine ran to completion
+        bool Done() const
+        { return !_handle || _handle.done(); }
+
+        /// @brief Check whether the awaited condition holds (once per sweep)
+        /// @return True if it may be resumed, false otherwise
+        bool Ready() {
+            if (Done()) {
+                return true;
+            }
+
+            std::function<bool ()>& until = _handle.promise().until;
+            if (!until || until()) {
+                until = nullptr;
+                return true;
+            }
+
+            return false;
+        }
+
+        /// @brief Resume the coroutine up to its next suspension
+        void Resume() {
+            _handle.resume();
+            Rethrow();
+        }
+
+        /// @brief Rethrow the error the coroutine ended with, if any
+        void Rethrow() {
+            if (_handle && _handle.promise().error) {
+                std::rethrow_exception(std::exchange(_handle.promise().error, nullptr));
+            }
+        }
+};
+
+/// @brief Awaitable resuming a coroutine service action once a condition
+/// holds, checked once per sweep
+/// @remark Services may provide their own (e.g. for timers or jobs),
+/// along with whatever happens on resumption
+struct Until {
+    /// @brief Condition to resume on (none resumes on the next sweep)
+    std::function<bool ()> condition;
+
+    bool await_ready() const noexcept
+    { return false; }
+
+    void await_suspend(std::coroutine_handle<ActionTask::promise_type> handle)
+    { handle.promise().until = std::move(condition); }
+
+    void await_resume() const noexcept
+    {}
+};
+
+/// @brief Awaitable resuming a coroutine service action on the next sweep
+inline Until NextSweep()
+{ return Until{}; }
+
+/// @brief Awaitable resuming a coroutine service action a given amount of
+/// sweeps later on
+/// @param sweeps Sweeps to resume after (at least one)
+inline Until Sweeps(std::uint64_t sweeps) {
+    return Until{[left = sweeps]() mutable {
+        if (left <= 1) {
+            return true;
+        }
+
+        left -= 1;
+        return false;
+    }};
+}
+
+/// @brief Coroutine service action in flight, resumed on every sweep its
+/// condition holds (or started anew, once done)
+class ActionRoutine {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        /// @brief Task in flight, if any
+        std::optional<ActionTask> _task;
+
+        /// @brief Whether it was ready but out of budget on the latest sweep
+        bool _deferred = false;
+
+    public:
+        /// @brief Resume the task in flight if its condition holds, or
+        /// start a new one if none, within the sweep's budget
+        /// @param deadline Time coroutine service actions should yield by
+        /// on the current sweep
+        /// @param start Callable starting a new task
+        /// @remark Ready tasks found past the deadline get deferred to the
+        /// next sweep, then resumed regardless, so none starves for longer
+        template <typename Start>
+        void Step(Clock::time_point deadline, Start&& start) {
+            // Leave it suspended while its condition doesn't hold
+            if (!_deferred && _task && !_task->Ready()) {
+                return;
+            }
+
+            // Or until the next sweep, if out of budget
+            if (!_deferred && Clock::now() >= deadline) {
+                _deferred = true;
+                return;
+            }
+
+            _deferred = false;
+
+            // Errors end the task, so the next sweep starts it anew
+            try {
+                if (!_task || _task->Done()) {
+                    _task.reset();
+                    _task.emplace(start());
+                    _task->Rethrow();
+                } else {
+                    _task->Resume();
+                }
+            } catch (...) {
+                _task.reset();
+                throw;
+            }
+        }
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+// Timekeeping
+#include <chrono>
+#include <cmath>
+
+// Yielding and sleeping
+#include <thread>
+
+/// @brief How an update loop waits between sweeps
+enum class LoopPolicy {
+    /// @brief Busy-wait (or don't wait at all if unpaced)
+    Spin,
+    /// @brief Yield the thread while waiting
+    Yield,
+    /// @brief Sleep most of the wait, then spin the rest
+    Sleep
+};
+
+/// @brief Paces a loop to a fixed amount of iterations per second
+/// @remark Sleeping overshoots by some amount depending on the OS
+/// scheduler, so sleeps are only taken in slices while the time left
+/// exceeds the estimated overshoot (mean plus one deviation of observed
+/// slices). The remainder is spun, for precise deadlines at low CPU usage
+class LoopPacer {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief Duration of a single sleep slice
+        static constexpr std::chrono::milliseconds SliceDuration{1};
+
+        /// @brief Policy to wait with
+        LoopPolicy _policy = LoopPolicy::Spin;
+
+        /// @brief Time between iterations (zero if unpaced)
+        Clock::duration _period = Clock::duration::zero();
+
+        /// @brief Time the current iteration should end by
+        Clock::time_point _deadline = Clock::now();
+
+        /// @brief Estimated seconds a sleep slice actually takes
+        double _sliceEstimate = 5E-3;
+
+        /// @brief Running mean of sleep slice seconds
+        double _sliceMean = 5E-3;
+
+        /// @brief Running sum of squared differences from the mean
+        double _sliceSquares = 0;
+
+        /// @brief Amount of sleep slices observed
+        unsigned long _sliceCount = 1;
+
+        /// @brief Sleep one slice, updating the overshoot estimate
+        void SleepSlice() {
+            const Clock::time_point start = Clock::now();
+            std::this_thread::sleep_for(SliceDuration);
+            const double observed =
+                std::chrono::duration<double>(Clock::now() - start).count();
+
+            // Welford's running variance
+            _sliceCount += 1;
+            const double difference = observed - _sliceMean;
+            _sliceMean += difference / _sliceCount;
+            _sliceSquares += difference * (observed - _sliceMean);
+
+            _sliceEstimate = _sliceMean + std::sqrt(_sliceSquares / (_sliceCount - 1));
+        }
+
+    public:
+        /// @brief Set how and how often the loop should iterate
+        /// @param policy Policy to wait with
+        /// @param rate Iterations per second (zero leaves it unpaced)
+        void Configure(LoopPolicy policy, double rate) {
+            _policy = policy;
+            _period = rate > 0 ?
+                std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(1.0 / rate)) :
+                Clock::duration::zero();
+            Restart();
+        }
+
+        /// @brief Start timing iterations from now
+        void Restart()
+        { _deadline = Clock::now() + _period; }
+
+        /// @brief Wait until the current iteration's deadline, then start
+        /// the next iteration
+        void Wait() {
+            // Unpaced loops only yield, if requested to
+            if (_period == Clock::duration::zero()) {
+                if (_policy != LoopPolicy::Spin) {
+                    std::this_thread::yield();
+                }
+                return;
+            }
+
+            // Sleep in slices while there's room to...
+            if (_policy == LoopPolicy::Sleep) {
+                while (std::chrono::duration<double>(
+                    _deadline - Clock::now()).count() > _sliceEstimate) {
+                    SleepSlice();
+                }
+            }
+
+            // ... Then wait out the rest
+            while (Clock::now() < _deadline) {
+                if (_policy == LoopPolicy::Yield) {
+                    std::this_thread::yield();
+                }
+            }
+
+            // Fall back in step if more than an iteration behind,
+            // instead of rushing to catch up
+            _deadline += _period;
+            const Clock::time_point now = Clock::now();
+            if (_deadline < now) {
+                _deadline = now + _period;
+            }
+        }
+};
@@ -0,0 +1,308 @@
+#pragma once
+
+// Timekeeping
+#include <chrono>
+#include <thread>
+
+// Storage
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+// Trace output
+#include <ostream>
+#include <iomanip>
+
+/// @brief Timings of a profiled scope over the latest frames
+struct ProfileEntry {
+    /// @brief Name of the scope
+    std::string name;
+    /// @brief Milliseconds taken on the latest frame
+    double last;
+    /// @brief Median milliseconds taken per frame
+    double p50;
+    /// @brief 99th percentile of milliseconds taken per frame
+    double p99;
+    /// @brief Entities processed on the latest frame (zero if not a system)
+    std::size_t entities;
+};
+
+/// @brief Scope timer for sweeps, stages, service actions, systems and
+/// the structural changes they recorded
+/// @remark Systems split across workers get the time of every chunk summed
+/// up (i.e. CPU time rather than wall time). Scopes are only recorded from
+/// the sweeping thread, so no synchronization takes place
+class Profiler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief Kinds of profiled scopes
+        enum class Scope { Sweep, Stage, ServiceAction, System, Commands };
+
+    private:
+        /// @brief Timings of a single scope
+        struct Track {
+            /// @brief Name to report the scope by
+            std::string name;
+            /// @brief Milliseconds taken on each of the latest frames (ring)
+            std::vector<double> history;
+            /// @brief Next slot to overwrite on the history
+            std::size_t cursor = 0;
+            /// @brief Milliseconds taken so far on the current frame
+            double accumulated = 0;
+            /// @brief Entities processed so far on the current frame
+            std::size_t entities = 0;
+            /// @brief Entities processed on the latest frame
+            std::size_t lastEntities = 0;
+            /// @brief Whether the scope was recorded on the current frame
+            bool touched = false;
+        };
+
+        /// @brief Span of a scope as recorded for a trace
+        struct TraceEvent {
+            /// @brief Track the span belongs to
+            const Track* track;
+            /// @brief Thread the span ran on
+            std::uint32_t thread;
+            /// @brief Microseconds since the trace started
+            double start;
+            /// @brief Microseconds taken
+            double duration;
+        };
+
+        /// @brief Whether scopes are being recorded
+        bool _enabled = false;
+
+        /// @brief Frames to compute percentiles over
+        std::size_t _frames = 120;
+
+        /// @brief Timings of every scope recorded so far
+        std::map<std::pair<Scope, std::size_t>, Track> _tracks;
+
+        /// @brief Whether spans are being recorded for a trace
+        bool _tracing = false;
+
+        /// @brief Most spans to record for a trace
+        std::size_t _maxEvents = 0;
+
+        /// @brief Spans recorded for the trace
+        std::vector<TraceEvent> _events;
+
+        /// @brief Time the trace started at
+        Clock::time_point _traceStart;
+
+        /// @brief Compact thread numbers for the trace
+        std::map<std::thread::id, std::uint32_t> _threads;
+
+        /// @brief Default name of a scope
+        static std::string DefaultName(Scope scope, std::size_t id) {
+            switch (scope) {
+                case Scope::Sweep:
+                    return "Sweep";
+                case Scope::Stage:
+                    return "Stage #" + std::to_string(id);
+                case Scope::ServiceAction:
+                    return "Service action #" + std::to_string(id);
+                case Scope::Commands:
+                    return "Commands";
+                default:
+                    return "System #" + std::to_string(id);
+            }
+        }
+
+        /// @brief Find or create the track of a scope
+        Track& TrackOf(Scope scope, std::size_t id) {
+            auto [where, created] = _tracks.try_emplace({scope, id});
+            if (created) {
+                where->second.name = DefaultName(scope, id);
+            }
+
+            return where->second;
+        }
+
+        /// @brief Write a string down as the contents of a JSON string
+        /// @param output Stream to write onto
+        /// @param text String to escape (quotes, backslashes and control
+        /// characters get escaped, everything else is kept as-is)
+        static void WriteEscaped(std::ostream& output, const std::string& text) {
+            constexpr char hex[] = "0123456789abcdef";
+
+            for (const char character : text) {
+                const unsigned char code = static_cast<unsigned char>(character);
+
+                if (character == '"' || character == '\\') {
+                    output << '\\' << character;
+                } else if (code < 0x20) {
+                    output << "\\u00" << hex[code >> 4] << hex[code & 0xF];
+                } else {
+                    output << character;
+                }
+            }
+        }
+
+        /// @brief Value at a given percentile of some samples
+        static double Percentile(std::vector<double> samples, double percentile) {
+            if (samples.empty()) {
+                return 0;
+            }
+
+            const std::size_t which = std::min(samples.size() - 1,
+                static_cast<std::size_t>(percentile * samples.size()));
+            std::nth_element(samples.begin(), samples.begin() + which, samples.end());
+            return samples[which];
+        }
+
+    public:
+        /// @brief Start or stop recording scopes
+        /// @param enabled Whether to record scopes
+        /// @param frames Frames to compute percentiles over
+        void Enable(bool enabled, std::size_t frames = 120) {
+            _enabled = enabled;
+            _frames = std::max<std::size_t>(1, frames);
+
+            // Forget history kept over a different amount of frames
+            for (auto& [key, track] : _tracks) {
+                track.history.clear();
+                track.cursor = 0;
+            }
+        }
+
+        /// @brief Whether scopes are being recorded
+        bool Enabled() const
+        { return _enabled; }
+
+        /// @brief Set the name to report a scope by
+        /// @param scope Kind of scope
+        /// @param id ID of the scope within its kind
+        /// @param name Name to report it by
+        void Name(Scope scope, std::size_t id, std::string name)
+        { TrackOf(scope, id).name = std::move(name); }
+
+        /// @brief Record the time taken by a scope on the current frame
+        /// @param scope Kind of scope
+        /// @param id ID of the scope within its kind
+        /// @param start Time the scope started at
+        /// @param end Time the scope ended at
+        /// @param entities Entities processed within the scope
+        /// @param thread Thread the scope ran on
+        void Record(Scope scope, std::size_t id, Clock::time_point start,
+            Clock::time_point end, std::size_t entities = 0,
+            std::thread::id thread = std::this_thread::get_id()) {
+            Track& track = TrackOf(scope, id);
+            track.accumulated +=
+                std::chrono::duration<double, std::milli>(end - start).count();
+            track.entities += entities;
+            track.touched = true;
+
+            // Keep the span for the trace as well, if any
+            if (_tracing && _events.size() < _maxEvents) {
+                const auto [where, created] = _threads.try_emplace(
+                    thread, static_cast<std::uint32_t>(_threads.size()));
+
+                _events.push_back(TraceEvent{
+                    &track, where->second,
+                    std::chrono::duration<double, std::micro>(start - _traceStart).count(),
+                    std::chrono::duration<double, std::micro>(end - start).count()
+                });
+            }
+        }
+
+        /// @brief Close the current frame, keeping the time taken by every
+        /// scope recorded on it
+        void EndFrame() {
+            for (auto& [key, track] : _tracks) {
+                if (!track.touched) {
+                    continue;
+                }
+
+                // Overwrite the oldest frame once the history is full
+                if (track.history.size() < _frames) {
+                    track.history.push_back(track.accumulated);
+                } else {
+                    track.history[track.cursor] = track.accumulated;
+                }
+                track.cursor = (track.cursor + 1) % _frames;
+
+                track.lastEntities = track.entities;
+                track.accumulated = 0;
+                track.entities = 0;
+                track.touched = false;
+            }
+        }
+
+        /// @brief Summarize the timings of every scope recorded so far
+        /// @return Timings of each scope, ordered by kind then ID
+        std::vector<ProfileEntry> Report() const {
+            std::vector<ProfileEntry> entries;
+            entries.reserve(_tracks.size());
+
+            for (const auto& [key, track] : _tracks) {
+                if (track.history.empty()) {
+                    continue;
+                }
+
+                const std::size_t latest =
+                    (track.cursor + track.history.size() - 1) % track.history.size();
+
+                entries.push_back(ProfileEntry{
+                    track.name,
+                    track.history[latest],
+                    Percentile(track.history, 0.50),
+                    Percentile(track.history, 0.99),
+                    track.lastEntities
+                });
+            }
+
+            return entries;
+        }
+
+        /// @brief Start recording spans for a trace. Any previous spans
+        /// get discarded
+        /// @param maxEvents Most spans to record (later ones get dropped)
+        void StartTrace(std::size_t maxEvents = 1 << 20) {
+            _tracing = true;
+            _maxEvents = maxEvents;
+            _events.clear();
+            _events.reserve(std::min<std::size_t>(maxEvents, 1 << 16));
+            _threads.clear();
+            _traceStart = Clock::now();
+        }
+
+        /// @brief Whether spans are being recorded for a trace
+        bool Tracing() const
+        { return _tracing; }
+
+        /// @brief Stop recording spans, and write them down in Chrome's
+        /// trace event format (as loaded by chrome://tracing or Perfetto)
+        /// @param output Stream to write the JSON trace onto
+        void WriteTrace(std::ostream& output) {
+            _tracing = false;
+
+            // Keep microseconds precise (restoring the stream's format after)
+            const std::ios_base::fmtflags flags = output.flags();
+            const std::streamsize precision = output.precision();
+            output << std::fixed << std::setprecision(3);
+
+            output << "{\"traceEvents\":[";
+            for (std::size_t which = 0; which < _events.size(); ++which) {
+                const TraceEvent& event = _events[which];
+
+                // (Names are user-provided, so they get escaped)
+                output << (which == 0 ? "" : ",") << "{\"name\":\"";
+                WriteEscaped(output, event.track->name);
+                output << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+                    << ",\"ts\":" << event.start
+                    << ",\"dur\":" << event.duration << "}";
+            }
+            output << "],\"displayTimeUnit\":\"ms\"}";
+
+            output.flags(flags);
+            output.precision(precision);
+
+            _events.clear();
+        }
+};
@@ -0,0 +1,239 @@
+#pragma once
+
+// Fixed-width masks
+#include <cstddef>
+#include <cstdint>
+
+// Task storage
+#include <vector>
+#include <deque>
+#include <functional>
+
+// Synchronization
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <thread>
+#include <stop_token>
+
+/// @brief Components and services a system reads from and writes onto
+/// @remark Derived from the constness of each system parameter. Written
+/// masks are always a subset of read masks
+struct SystemAccess {
+    /// @brief Components read (or written) by the system
+    std::uint64_t componentReads = 0;
+    /// @brief Components written by the system
+    std::uint64_t componentWrites = 0;
+    /// @brief Services read (or written) by the system
+    std::uint64_t serviceReads = 0;
+    /// @brief Services written by the system
+    std::uint64_t serviceWrites = 0;
+
+    /// @brief Whether both systems could not run at the same time
+    /// @param other Access of another system
+    /// @return True if either writes something the other touches
+    bool ConflictsWith(const SystemAccess& other) const {
+        return
+            (componentWrites & other.componentReads) != 0 ||
+            (other.componentWrites & componentReads) != 0 ||
+            (serviceWrites & other.serviceReads) != 0 ||
+            (other.serviceWrites & serviceReads) != 0;
+    }
+
+    /// @brief Whether the system must run on the sweeping thread
+    /// @remark Services taken by non-const reference are assumed not to
+    /// be thread-safe (e.g. SDL rendering must stay on a single thread)
+    bool ThreadAffine() const
+    { return serviceWrites != 0; }
+};
+
+/// @brief Group systems into stages that can run concurrently
+/// @param accesses Access of each system, in sweep order
+/// @return Indices of systems within each stage, in stage order
+/// @remark A system is placed right after the latest earlier system it
+/// conflicts with, so relative order between conflicting systems holds
+inline std::vector<std::vector<std::size_t>> BuildStages(
+    const std::vector<SystemAccess>& accesses
+) {
+    std::vector<std::vector<std::size_t>> stages;
+    std::vector<std::size_t> stageOf(accesses.size(), 0);
+
+    for (std::size_t current = 0; current < accesses.size(); ++current) {
+        // Find the earliest stage that follows every conflicting system
+        std::size_t stage = 0;
+        for (std::size_t earlier = 0; earlier < current; ++earlier) {
+            if (accesses[current].ConflictsWith(accesses[earlier]) &&
+                stageOf[earlier] + 1 > stage) {
+                stage = stageOf[earlier] + 1;
+            }
+        }
+
+        if (stage >= stages.size()) {
+            stages.resize(stage + 1);
+        }
+
+        stageOf[current] = stage;
+        stages[stage].push_back(current);
+    }
+
+    return stages;
+}
+
+/// @brief Fixed set of worker threads running batches of tasks
+class WorkerPool {
+    public:
+        using Task = std::function<void ()>;
+
+    private:
+        /// @brief Bookkeeping for a batch of tasks submitted together
+        struct Batch {
+            /// @brief Tasks yet to finish
+            std::atomic<std::size_t> pending = 0;
+            /// @brief First error raised by a task, if any
+            std::exception_ptr error;
+            /// @brief Guards the error
+            std::mutex errorMutex;
+        };
+
+        /// @brief Queued task along with the batch it belongs to
+        struct QueuedTask {
+            Task task;
+            Batch* batch;
+        };
+
+        /// @brief Tasks waiting for a thread
+        std::deque<QueuedTask> _queue;
+
+        /// @brief Guards the queue
+        std::mutex _mutex;
+
+        /// @brief Signals workers of new tasks, and submitters of
+        /// finished ones
+        std::condition_variable_any _wake;
+
+        /// @brief Worker threads
+        std::vector<std::jthread> _workers;
+
+        /// @brief Run a queued task and report its completion
+        /// @param queued Task to run
+        void Execute(QueuedTask& queued) {
+            try {
+                queued.task();
+            } catch (...) {
+                std::lock_guard lock(queued.batch->errorMutex);
+                if (!queued.batch->error) {
+                    queued.batch->error = std::current_exception();
+                }
+            }
+
+            // Wake the submitter once the whole batch is done
+            if (queued.batch->pending.fetch_sub(1) == 1) {
+                std::lock_guard lock(_mutex);
+                _wake.notify_all();
+            }
+        }
+
+        /// @brief Main loop of each worker thread
+        /// @param stoken Stop token of the worker thread
+        void Work(std::stop_token stoken) {
+            while (true) {
+                QueuedTask queued;
+
+                {
+                    std::unique_lock lock(_mutex);
+                    if (!_wake.wait(lock, stoken, [&]{ return !_queue.empty(); })) {
+                        return;
+                    }
+
+                    queued = std::move(_queue.front());
+                    _queue.pop_front();
+                }
+
+                Execute(queued);
+            }
+        }
+
+    public:
+        /// @brief Start a given amount of worker threads
+        /// @param threads Amount of threads (besides the submitting one)
+        explicit WorkerPool(unsigned threads) {
+            _workers.reserve(threads);
+            for (unsigned which = 0; which < threads; ++which) {
+                _workers.emplace_back(
+                    [this](std::stop_token stoken) { Work(stoken); }
+                );
+            }
+        }
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /// @brief Stop and join every worker thread
+        ~WorkerPool() {
+            for (std::jthread& worker : _workers) {
+                worker.request_stop();
+            }
+
+            _workers.clear();
+        }
+
+        /// @brief Amount of worker threads (besides the submitting one)
+        unsigned Threads() const
+        { return static_cast<unsigned>(_workers.size()); }
+
+        /// @brief Run a batch of tasks across the workers, and wait for them
+        /// @param tasks Tasks that may run concurrently with each other
+        /// @param local Task to run on the calling thread meanwhile
+        /// @remark The calling thread helps with the batch after running
+        /// the local task. The first error raised by any task is rethrown
+        void Run(std::vector<Task>& tasks, const Task& local = nullptr) {
+            Batch batch;
+            batch.pending = tasks.size();
+
+            {
+                std::lock_guard lock(_mutex);
+                for (Task& task : tasks) {
+                    _queue.push_back(QueuedTask{std::move(task), &batch});
+                }
+            }
+            _wake.notify_all();
+
+            // Run the thread-bound task first
+            if (local) {
+                try {
+                    local();
+                } catch (...) {
+                    std::lock_guard lock(batch.errorMutex);
+                    if (!batch.error) { batch.error = std::current_exception(); }
+                }
+            }
+
+            // Then help until every task of the batch is done
+            while (batch.pending.load() != 0) {
+                QueuedTask queued;
+
+                {
+                    std::unique_lock lock(_mutex);
+                    if (_queue.empty()) {
+                        _wake.wait(lock, [&]{
+                            return !_queue.empty() || batch.pending.load() == 0;
+                        });
+
+                        if (_queue.empty()) { continue; }
+                    }
+
+                    queued = std::move(_queue.front());
+                    _queue.pop_front();
+                }
+
+                Execute(queued);
+            }
+
+            tasks.clear();
+
+            if (batch.error) {
+                std::rethrow_exception(batch.error);
+            }
+        }
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+// Shard storage
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Lockstep threads
+#include <thread>
+#include <barrier>
+#include <mutex>
+
+// Error reporting
+#include <exception>
+#include <stdexcept>
+
+/// @brief Several ECSs of the same type (shards of a partitioned world),
+/// swept in lockstep on threads of their own
+/// @tparam World ECS type of every shard
+/// @remark Between steps every shard waits at a barrier, while a single
+/// thread runs an exchange over all of them (e.g. to hand entities over
+/// across shard boundaries, through PackEntity() and UnpackEntities()).
+/// Since handoffs are plain bytes, shards on other processes could take
+/// part through a transport of their own
+template <class World>
+class ShardGroup {
+    private:
+        /// @brief Every shard, in order
+        std::vector<std::unique_ptr<World>> _shards;
+
+    public:
+        /// @brief Construct a group of empty shards
+        /// @param count Amount of shards (at least one)
+        explicit ShardGroup(std::size_t count) {
+            if (count == 0) {
+                throw std::invalid_argument("Shard groups need at least one shard");
+            }
+
+            _shards.reserve(count);
+            for (std::size_t which = 0; which < count; ++which) {
+                _shards.push_back(std::make_unique<World>());
+            }
+        }
+
+        /// @brief Amount of shards in the group
+        std::size_t Size() const
+        { return _shards.size(); }
+
+        /// @brief Access a given shard
+        /// @param which Position of the shard within the group
+        World& operator[](std::size_t which)
+        { return *_shards[which]; }
+
+        /// @brief Access a given shard
+        /// @param which Position of the shard within the group
+        const World& operator[](std::size_t which) const
+        { return *_shards[which]; }
+
+        /// @brief Sweep every shard in lockstep, exchanging between steps,
+        /// until the exchange or any shard (e.g. through its manager
+        /// service) requests to stop
+        /// @param exchange Callable taking the group and returning whether
+        /// to keep going, run once before the first step and then after
+        /// every step (on a single thread, with every shard idle)
+        /// @remark The first shard is swept on the calling thread, the rest
+        /// on threads of their own. Rethrows the first error raised by a
+        /// shard or the exchange, once every shard stopped
+        template <typename Exchange>
+        void Run(Exchange&& exchange) {
+            std::exception_ptr error;
+            std::mutex errorLock;
+
+            const auto fail = [&] {
+                const std::lock_guard<std::mutex> guard(errorLock);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            };
+
+            // Decide whether to keep going once every shard arrives
+            bool proceed = true;
+            auto step = [&] () noexcept {
+                try {
+                    const std::lock_guard<std::mutex> guard(errorLock);
+                    for (const std::unique_ptr<World>& shard : _shards) {
+                        proceed = proceed && !error && !shard->StopRequested();
+                    }
+                } catch (...) {
+                    proceed = false;
+                }
+
+                if (proceed) {
+                    try {
+                        proceed = exchange(*this);
+                    } catch (...) {
+                        fail();
+                        proceed = false;
+                    }
+                }
+            };
+
+            step();
+            if (!proceed) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+
+                return;
+            }
+
+            std::barrier<decltype(step)> barrier(
+                static_cast<std::ptrdiff_t>(_shards.size()), step);
+
+            const auto loop = [&] (World& shard) {
+                do {
+                    // Keep arriving even if sweeping failed, so no shard
+                    // waits forever
+                    try {
+                        shard.Sweep();
+                    } catch (...) {
+                        fail();
+                    }
+
+                    barrier.arrive_and_wait();
+                } while (proceed);
+            };
+
+            {
+                std::vector<std::jthread> threads;
+                threads.reserve(_shards.size() - 1);
+
+                for (std::size_t which = 1; which < _shards.size(); ++which) {
+                    threads.emplace_back(loop, std::ref(*_shards[which]));
+                }
+
+                loop(*_shards.front());
+            }
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+};
@@ -0,0 +1,331 @@
+#pragma once
+
+// Byte buffers
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <span>
+#include <algorithm>
+
+// Type constraints
+#include <type_traits>
+
+// Error reporting
+#include <stdexcept>
+
+/// @brief Reusable buffers to snapshot an ECS world onto, and restore it from
+/// @remark Snapshots are plain copies of the dense storage arrays, so they
+/// only hold within the same build (and ECS) they were taken with. Buffers
+/// keep their capacity, so once warmed up neither snapshotting nor
+/// restoring allocates. With delta encoding on, each snapshot also gets
+/// encoded against the previous one: unchanged 8-byte words are skipped as
+/// runs, while changed ones are stored XOR'ed against their former value
+class SnapshotArena {
+    public:
+        /// @brief Tag at the start of every snapshot ("SNAP")
+        static constexpr std::uint32_t Magic = 0x50414E53;
+
+    private:
+        /// @brief Latest snapshot (the one restored from)
+        std::vector<std::byte> _current;
+
+        /// @brief Snapshot before the latest (the one deltas are against)
+        std::vector<std::byte> _previous;
+
+        /// @brief Latest snapshot, encoded against the one before it
+        std::vector<std::byte> _delta;
+
+        /// @brief Whether snapshots get delta encoded
+        bool _deltaEncoding = false;
+
+        /// @brief Offset of the next byte to read off the latest snapshot
+        std::size_t _cursor = 0;
+
+        /// @brief Header of each run of an encoded delta
+        struct DeltaRun {
+            /// @brief Words left unchanged before the run
+            std::uint32_t unchanged;
+            /// @brief Words changed, stored right after the header
+            std::uint32_t changed;
+        };
+
+        /// @brief Word of a buffer at some word offset (zero past its end)
+        static std::uint64_t WordAt(const std::vector<std::byte>& buffer,
+            std::size_t word) {
+            std::uint64_t value = 0;
+            const std::size_t offset = word * sizeof(std::uint64_t);
+
+            if (offset + sizeof(value) <= buffer.size()) {
+                std::memcpy(&value, buffer.data() + offset, sizeof(value));
+            } else if (offset < buffer.size()) {
+                std::memcpy(&value, buffer.data() + offset,
+                    std::min(sizeof(value), buffer.size() - offset));
+            }
+
+            return value;
+        }
+
+        /// @brief Encode the latest snapshot against the one before it
+        void EncodeDelta() {
+            const std::uint64_t size = _current.size();
+            const std::size_t words = (_current.size() + 7) / 8;
+
+            // Make room for the worst case (every other word changed), then
+            // trim whatever was left unused
+            _delta.resize(sizeof(size) + (words + 1) * (sizeof(DeltaRun) + sizeof(std::uint64_t)));
+            std::byte* output = _delta.data();
+
+            std::memcpy(output, &size, sizeof(size));
+            output += sizeof(size);
+
+            for (std::size_t word = 0; word < words;) {
+                std::uint64_t current = WordAt(_current, word);
+                std::uint64_t previous = WordAt(_previous, word);
+
+                // Skip unchanged words...
+                DeltaRun run{0, 0};
+                while (current == previous) {
+                    run.unchanged += 1;
+                    if (++word == words) {
+                        break;
+                    }
+
+                    current = WordAt(_current, word);
+                    previous = WordAt(_previous, word);
+                }
+
+                // ... Then store the changed ones that follow
+                std::byte* header = output;
+                output += sizeof(run);
+
+                while (word < words && current != previous) {
+                    const std::uint64_t difference = current ^ previous;
+                    std::memcpy(output, &difference, sizeof(difference));
+                    output += sizeof(difference);
+
+                    run.changed += 1;
+                    if (++word == words) {
+                        break;
+                    }
+
+                    current = WordAt(_current, word);
+                    previous = WordAt(_previous, word);
+                }
+
+                std::memcpy(header, &run, sizeof(run));
+            }
+
+            _delta.resize(static_cast<std::size_t>(output - _delta.data()));
+        }
+
+        /// @brief Append some bytes onto a buffer
+        static void Append(std::vector<std::byte>& buffer, const void* data,
+            std::size_t size) {
+            if (size == 0) {
+                return;
+            }
+
+            const std::size_t offset = buffer.size();
+            buffer.resize(offset + size);
+            std::memcpy(buffer.data() + offset, data, size);
+        }
+
+    public:
+        /// @brief Set whether snapshots get delta encoded
+        /// @param enabled True to encode each snapshot against the previous
+        /// one (see Delta()), false to only keep the latest one (the default)
+        void SetDeltaEncoding(bool enabled)
+        { _deltaEncoding = enabled; }
+
+        /// @brief Whether snapshots get delta encoded
+        bool DeltaEncoding() const
+        { return _deltaEncoding; }
+
+        /// @brief Bytes of the latest snapshot
+        std::span<const std::byte> Bytes() const
+        { return _current; }
+
+        /// @brief Latest snapshot, encoded against the one before it
+        /// @return Encoded bytes (empty if delta encoding is off, or no
+        /// snapshot came before the latest)
+        std::span<const std::byte> Delta() const
+        { return _delta; }
+
+        /// @brief Replace the latest snapshot with some bytes (e.g. received
+        /// from elsewhere), to restore from
+        /// @param bytes Bytes of a snapshot
+        void Load(std::span<const std::byte> bytes) {
+            _previous.swap(_current);
+            _current.assign(bytes.begin(), bytes.end());
+            _delta.clear();
+        }
+
+        /// @brief Replace the latest snapshot with the one a delta encodes
+        /// against it (e.g. received from elsewhere), to restore from
+        /// @param delta Bytes encoded by Delta(), against a snapshot equal to
+        /// the latest one here
+        /// @remark Throws if the delta is malformed, keeping the latest
+        /// snapshot untouched
+        void ApplyDelta(std::span<const std::byte> delta) {
+            std::uint64_t size;
+            if (delta.size() < sizeof(size)) {
+                throw std::invalid_argument("Malformed snapshot delta");
+            }
+
+            std::memcpy(&size, delta.data(), sizeof(size));
+
+            // Decode onto the spare buffer, keeping the latest as the base
+            _previous.assign((size + 7) / 8 * 8, std::byte{0});
+            std::size_t offset = sizeof(size), word = 0;
+            const std::size_t words = _previous.size() / 8;
+
+            while (offset < delta.size()) {
+                DeltaRun run;
+                if (delta.size() - offset < sizeof(run)) {
+                    throw std::invalid_argument("Malformed snapshot delta");
+                }
+
+                std::memcpy(&run, delta.data() + offset, sizeof(run));
+                offset += sizeof(run);
+
+                if (
+                    run.unchanged + std::size_t{run.changed} > words - word ||
+                    (delta.size() - offset) / 8 < run.changed
+                ) {
+                    throw std::invalid_argument("Malformed snapshot delta");
+                }
+
+                for (std::size_t end = word + run.unchanged; word < end; ++word) {
+                    const std::uint64_t value = WordAt(_current, word);
+                    std::memcpy(_previous.data() + word * 8, &value, 8);
+                }
+
+                for (std::size_t end = word + run.changed; word < end; ++word) {
+                    std::uint64_t value;
+                    std::memcpy(&value, delta.data() + offset, 8);
+                    offset += 8;
+
+                    value ^= WordAt(_current, word);
+                    std::memcpy(_previous.data() + word * 8, &value, 8);
+                }
+            }
+
+            // Words past the last run are left unchanged
+            for (; word < words; ++word) {
+                const std::uint64_t value = WordAt(_current, word);
+                std::memcpy(_previous.data() + word * 8, &value, 8);
+            }
+
+            _previous.resize(size);
+            _current.swap(_previous);
+            _delta.clear();
+        }
+
+        // Snapshot recording (by the ECS)
+
+        /// @brief Start recording a new snapshot
+        void BeginWrite() {
+            _previous.swap(_current);
+            _current.clear();
+        }
+
+        /// @brief Append a plain value onto the snapshot being recorded
+        template <typename T>
+        requires std::is_trivially_copyable_v<T>
+        void Write(const T& value)
+        { Append(_current, &value, sizeof(T)); }
+
+        /// @brief Append an array of plain values (along with its length)
+        /// onto the snapshot being recorded
+        template <typename T>
+        requires std::is_trivially_copyable_v<T>
+        void WriteArray(std::span<const T> values) {
+            Write<std::uint64_t>(values.size());
+            Append(_current, values.data(), values.size_bytes());
+        }
+
+        /// @brief Append room for some bytes onto the snapshot being recorded
+        /// @param size Amount of bytes
+        /// @return Pointer to the bytes, to fill in right away
+        std::byte* WriteBytes(std::size_t size) {
+            const std::size_t offset = _current.size();
+            _current.resize(offset + size);
+            return _current.data() + offset;
+        }
+
+        /// @brief Finish recording the snapshot (encoding it, if enabled)
+        void EndWrite() {
+            if (_deltaEncoding && !_previous.empty()) {
+                EncodeDelta();
+            } else {
+                _delta.clear();
+            }
+        }
+
+        // Snapshot reading (by the ECS)
+
+        /// @brief Start reading the latest snapshot from its beginning
+        void BeginRead()
+        { _cursor = 0; }
+
+        /// @brief Take some bytes off the snapshot being read
+        /// @param size Amount of bytes
+        /// @return Pointer to the bytes
+        /// @remark Throws if the snapshot runs out of bytes
+        const std::byte* ReadBytes(std::size_t size) {
+            if (size > _current.size() - _cursor) {
+                throw std::runtime_error("Malformed snapshot (truncated)");
+            }
+
+            const std::byte* bytes = _current.data() + _cursor;
+            _cursor += size;
+            return bytes;
+        }
+
+        /// @brief Take a plain value off the snapshot being read
+        template <typename T>
+        requires std::is_trivially_copyable_v<T>
+        T Read() {
+            T value;
+            std::memcpy(&value, ReadBytes(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        /// @brief Take an array of plain values off the snapshot being read
+        /// @param values Returned-by-parameter values (resized to fit,
+        /// reusing its capacity)
+        template <typename T>
+        requires std::is_trivially_copyable_v<T>
+        void ReadArray(std::vector<T>& values) {
+            const std::uint64_t size = Read<std::uint64_t>();
+            if (size > (_current.size() - _cursor) / sizeof(T)) {
+                throw std::runtime_error("Malformed snapshot (truncated)");
+            }
+
+            values.resize(size);
+            if (size != 0) {
+                std::memcpy(values.data(), ReadBytes(size * sizeof(T)), size * sizeof(T));
+            }
+        }
+
+        /// @brief Skip an array of plain values off the snapshot being read
+        template <typename T>
+        requires std::is_trivially_copyable_v<T>
+        void SkipArray() {
+            const std::uint64_t size = Read<std::uint64_t>();
+            if (size > (_current.size() - _cursor) / sizeof(T)) {
+                throw std::runtime_error("Malformed snapshot (truncated)");
+            }
+
+            ReadBytes(size * sizeof(T));
+        }
+
+        /// @brief Finish reading the snapshot
+        /// @remark Throws if bytes were left unread
+        void EndRead() {
+            if (_cursor != _current.size()) {
+                throw std::runtime_error("Malformed snapshot (trailing bytes)");
+            }
+        }
+};
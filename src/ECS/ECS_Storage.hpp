@@ -0,0 +1,631 @@
+#pragma once
+
+// Core definition for component
+#include "ECS/ECS_Core.hpp"
+
+// Fixed-width indices
+#include <cstddef>
+#include <cstdint>
+
+// Contiguous storage
+#include <vector>
+#include <span>
+#include <algorithm>
+
+// Sentinel values
+#include <limits>
+
+// Error reporting
+#include <stdexcept>
+
+// Bulk copies onto snapshots
+#include "ECS/ECS_Snapshot.hpp"
+
+/// @brief Index of an entity slot within dense storage
+using EntityIndex = std::uint32_t;
+
+/// @brief Generation of an entity slot (bumped on every reuse)
+using EntityGeneration = std::uint32_t;
+
+/// @brief Counter ordering writes onto components (bumped on every system
+/// run and every batch of structural changes, so it never repeats)
+using ChangeTick = std::uint64_t;
+
+/// @brief Sentinel for an absent index within sparse storage
+inline constexpr std::uint32_t NullIndex =
+    std::numeric_limits<std::uint32_t>::max();
+
+/// @brief Sparse-set pool holding every instance of a given component
+/// type contiguously
+/// @tparam T Component type to store
+/// @remark Removal swaps the last element onto the freed spot, so dense
+/// order is not stable across removals. Every component keeps the tick it
+/// was last written at, and may be put to sleep: sleeping components are
+/// packed after the awake ones, so batches may cover the awake ones only
+template <ComponentType T>
+class ComponentPool {
+    private:
+        /// @brief Entity index to dense index mapping (or NullIndex)
+        std::vector<std::uint32_t> _sparse;
+
+        /// @brief Dense index to owning entity index mapping
+        std::vector<EntityIndex> _owners;
+
+        /// @brief Densely-packed component values
+        std::vector<T> _dense;
+
+        /// @brief Tick each densely-packed component was last written at
+        std::vector<ChangeTick> _ticks;
+
+        /// @brief Latest tick any component may have been written at
+        ChangeTick _columnTick = 0;
+
+        /// @brief Amount of awake components (packed before sleeping ones)
+        std::uint32_t _awake = 0;
+
+        /// @brief Swap two densely-packed components, along with their
+        /// owners and ticks
+        void SwapDense(std::uint32_t first, std::uint32_t second) {
+            if (first == second) {
+                return;
+            }
+
+            std::swap(_dense[first], _dense[second]);
+            std::swap(_owners[first], _owners[second]);
+            std::swap(_ticks[first], _ticks[second]);
+
+            _sparse[_owners[first]] = first;
+            _sparse[_owners[second]] = second;
+        }
+
+    public:
+        /// @brief Whether the given entity owns a component in this pool
+        /// @param entity Index of entity to check
+        /// @return True if it does, false otherwise
+        inline bool Contains(EntityIndex entity) const {
+            return entity < _sparse.size() && _sparse[entity] != NullIndex;
+        }
+
+        /// @brief Access the component owned by a given entity
+        /// @param entity Index of entity owning a component in this pool
+        /// @return Reference to component
+        /// @remark Unchecked, call Contains() beforehand if unsure
+        inline T& Get(EntityIndex entity) {
+            return _dense[_sparse[entity]];
+        }
+
+        /// @brief Access the component owned by a given entity
+        /// @param entity Index of entity owning a component in this pool
+        /// @return Const-reference to component
+        /// @remark Unchecked, call Contains() beforehand if unsure
+        inline const T& Get(EntityIndex entity) const {
+            return _dense[_sparse[entity]];
+        }
+
+        /// @brief Place a component for an entity that does not own one yet
+        /// @param entity Index of entity to own the component
+        /// @param component Value of the component
+        /// @param tick Tick to stamp the component with
+        /// @return Reference to the stored component (awake)
+        T& Insert(EntityIndex entity, const T& component, ChangeTick tick) {
+            if (Contains(entity)) {
+                throw std::logic_error("Component already installed");
+            }
+
+            // Grow the sparse mapping to fit the entity index
+            if (entity >= _sparse.size()) {
+                _sparse.resize(entity + 1, NullIndex);
+            }
+
+            // Append onto the dense arrays
+            const std::uint32_t last = static_cast<std::uint32_t>(_dense.size());
+            _sparse[entity] = last;
+            _owners.push_back(entity);
+            _dense.push_back(component);
+            _ticks.push_back(tick);
+            _columnTick = std::max(_columnTick, tick);
+
+            // Then in front of the sleeping ones
+            SwapDense(_awake, last);
+            _awake += 1;
+
+            return _dense[_sparse[entity]];
+        }
+
+        /// @brief Place components for a batch of entities that do not own
+        /// one yet, growing storage only once
+        /// @param entities Indices of entities to own the components
+        /// @param components Value of each entity's component (same order)
+        /// @param tick Tick to stamp the components with
+        void InsertMany(std::span<const EntityIndex> entities,
+            std::span<const T> components, ChangeTick tick) {
+            if (entities.empty()) {
+                return;
+            }
+
+            // Grow the sparse mapping to fit the highest entity index
+            const EntityIndex highest = *std::max_element(entities.begin(), entities.end());
+            if (highest >= _sparse.size()) {
+                _sparse.resize(highest + 1, NullIndex);
+            }
+
+            // Map every entity onto its upcoming dense spot
+            const std::uint32_t first = static_cast<std::uint32_t>(_dense.size());
+            for (std::size_t which = 0; which < entities.size(); ++which) {
+                if (_sparse[entities[which]] != NullIndex) {
+                    // Roll back the ones mapped so far
+                    for (std::size_t undo = 0; undo < which; ++undo) {
+                        _sparse[entities[undo]] = NullIndex;
+                    }
+
+                    throw std::logic_error("Component already installed");
+                }
+
+                _sparse[entities[which]] = first + static_cast<std::uint32_t>(which);
+            }
+
+            // Then append onto the dense arrays in bulk...
+            _owners.insert(_owners.end(), entities.begin(), entities.end());
+            _dense.insert(_dense.end(), components.begin(), components.end());
+            _ticks.resize(_dense.size(), tick);
+            _columnTick = std::max(_columnTick, tick);
+
+            // ... In front of the sleeping ones (if any)
+            for (std::size_t which = 0; which < entities.size(); ++which) {
+                SwapDense(_awake, first + static_cast<std::uint32_t>(which));
+                _awake += 1;
+            }
+        }
+
+        /// @brief Remove the component owned by a given entity
+        /// @param entity Index of entity owning a component in this pool
+        void Erase(EntityIndex entity) {
+            if (!Contains(entity)) {
+                throw std::logic_error("Component already uninstalled");
+            }
+
+            // Keep awake components packed first, by making room for the
+            // freed spot past them
+            std::uint32_t freed = _sparse[entity];
+            if (freed < _awake) {
+                SwapDense(freed, _awake - 1);
+                freed = _awake - 1;
+                _awake -= 1;
+            }
+
+            // Then move the last element onto the freed spot
+            SwapDense(freed, static_cast<std::uint32_t>(_dense.size() - 1));
+
+            // And shrink the dense arrays
+            _dense.pop_back();
+            _owners.pop_back();
+            _ticks.pop_back();
+            _sparse[entity] = NullIndex;
+        }
+
+        /// @brief Stamp the component owned by a given entity as written
+        /// @param entity Index of entity owning a component in this pool
+        /// @param tick Tick it was written at
+        /// @remark Unchecked, and leaves the column's tick alone (see Touch())
+        inline void Stamp(EntityIndex entity, ChangeTick tick)
+        { _ticks[_sparse[entity]] = tick; }
+
+        /// @brief Stamp a range of densely-packed components as written
+        /// @param begin First dense component
+        /// @param end Past-the-last dense component
+        /// @param tick Tick they were written at
+        /// @remark Unchecked, and leaves the column's tick alone (see Touch())
+        inline void StampDense(std::size_t begin, std::size_t end, ChangeTick tick)
+        { std::fill(_ticks.begin() + begin, _ticks.begin() + end, tick); }
+
+        /// @brief Record that components may be written at a given tick
+        /// @param tick Tick of the write
+        inline void Touch(ChangeTick tick)
+        { _columnTick = std::max(_columnTick, tick); }
+
+        /// @brief Whether the component owned by a given entity was written
+        /// after a given tick
+        /// @param entity Index of entity owning a component in this pool
+        /// @param since Tick to compare against
+        /// @remark Unchecked, call Contains() beforehand if unsure
+        inline bool ChangedSince(EntityIndex entity, ChangeTick since) const
+        { return _ticks[_sparse[entity]] > since; }
+
+        /// @brief Latest tick any component may have been written at (so
+        /// none changed after a tick at least as late)
+        inline ChangeTick ColumnTick() const
+        { return _columnTick; }
+
+        /// @brief Put the component owned by a given entity to sleep,
+        /// leaving it out of batches over awake components
+        /// @param entity Index of entity owning a component in this pool
+        /// @remark Unchecked, call Contains() beforehand if unsure
+        void Sleep(EntityIndex entity) {
+            const std::uint32_t dense = _sparse[entity];
+            if (dense < _awake) {
+                SwapDense(dense, _awake - 1);
+                _awake -= 1;
+            }
+        }
+
+        /// @brief Wake the component owned by a given entity up
+        /// @param entity Index of entity owning a component in this pool
+        /// @remark Unchecked, call Contains() beforehand if unsure
+        void Wake(EntityIndex entity) {
+            const std::uint32_t dense = _sparse[entity];
+            if (dense >= _awake) {
+                SwapDense(dense, _awake);
+                _awake += 1;
+            }
+        }
+
+        /// @brief Whether the component owned by a given entity is asleep
+        /// @param entity Index of entity owning a component in this pool
+        /// @remark Unchecked, call Contains() beforehand if unsure
+        inline bool Asleep(EntityIndex entity) const
+        { return _sparse[entity] >= _awake; }
+
+        /// @brief Amount of awake components (the first ones densely-packed)
+        inline std::size_t Awake() const
+        { return _awake; }
+
+        /// @brief Reserve room for a given amount of components
+        /// @param capacity Amount of components to reserve room for
+        void Reserve(std::size_t capacity) {
+            _owners.reserve(capacity);
+            _dense.reserve(capacity);
+            _ticks.reserve(capacity);
+        }
+
+        /// @brief Amount of components stored
+        inline std::size_t Size() const
+        { return _dense.size(); }
+
+        /// @brief Densely-packed component values
+        inline T* Data()
+        { return _dense.data(); }
+
+        /// @brief Densely-packed component values
+        inline const T* Data() const
+        { return _dense.data(); }
+
+        /// @brief Owning entity index of each densely-packed component
+        inline const EntityIndex* Owners() const
+        { return _owners.data(); }
+
+        /// @brief Copy every component (and its owner) onto a snapshot
+        /// @param arena Arena recording the snapshot
+        /// @remark Ticks aren't copied, restoring counts as a write
+        void Save(SnapshotArena& arena) const {
+            arena.WriteArray<std::uint32_t>(_sparse);
+            arena.WriteArray<EntityIndex>(_owners);
+            arena.WriteArray<T>(_dense);
+            arena.Write<std::uint32_t>(_awake);
+        }
+
+        /// @brief Replace every component (and its owner) with those of a
+        /// snapshot
+        /// @param arena Arena reading the snapshot
+        /// @param tick Tick to stamp every component with
+        void Load(SnapshotArena& arena, ChangeTick tick) {
+            arena.ReadArray(_sparse);
+            arena.ReadArray(_owners);
+            arena.ReadArray(_dense);
+            _awake = arena.Read<std::uint32_t>();
+
+            if (_owners.size() != _dense.size() || _awake > _dense.size()) {
+                throw std::runtime_error("Malformed snapshot (inconsistent pool)");
+            }
+
+            // Every component must be mapped back from its owner...
+            for (std::uint32_t dense = 0; dense < _owners.size(); ++dense) {
+                if (_owners[dense] >= _sparse.size() || _sparse[_owners[dense]] != dense) {
+                    throw std::runtime_error("Malformed snapshot (inconsistent pool)");
+                }
+            }
+
+            // ... And every mapping must point to a component it owns
+            for (EntityIndex entity = 0; entity < _sparse.size(); ++entity) {
+                const std::uint32_t dense = _sparse[entity];
+                if (dense != NullIndex && (dense >= _owners.size() || _owners[dense] != entity)) {
+                    throw std::runtime_error("Malformed snapshot (inconsistent pool)");
+                }
+            }
+
+            _ticks.assign(_dense.size(), tick);
+            _columnTick = tick;
+        }
+};
+
+/// @brief Generational index allocator for entity slots
+class EntityRegistry {
+    private:
+        /// @brief Current generation of every slot ever allocated
+        std::vector<EntityGeneration> _generations;
+
+        /// @brief Whether each slot is currently in use
+        std::vector<bool> _alive;
+
+        /// @brief Slots freed and pending reuse
+        std::vector<EntityIndex> _freeIndices;
+
+        /// @brief Amount of slots currently in use
+        std::size_t _aliveCount = 0;
+
+    public:
+        /// @brief Pack an index and generation into a single handle
+        static constexpr std::uint64_t Pack(
+            EntityIndex index, EntityGeneration generation
+        ) {
+            return (static_cast<std::uint64_t>(generation) << 32) | index;
+        }
+
+        /// @brief Index portion of a packed handle
+        static constexpr EntityIndex IndexOf(std::uint64_t handle)
+        { return static_cast<EntityIndex>(handle & 0xFFFFFFFFu); }
+
+        /// @brief Generation portion of a packed handle
+        static constexpr EntityGeneration GenerationOf(std::uint64_t handle)
+        { return static_cast<EntityGeneration>(handle >> 32); }
+
+        /// @brief Packed handle of a slot currently in use
+        /// @param index Index of slot in use
+        inline std::uint64_t HandleOf(EntityIndex index) const
+        { return Pack(index, _generations[index]); }
+
+        /// @brief Allocate a slot, reusing freed ones first
+        /// @return Packed handle for the slot
+        std::uint64_t Create() {
+            EntityIndex index;
+
+            if (!_freeIndices.empty()) {
+                index = _freeIndices.back();
+                _freeIndices.pop_back();
+            } else {
+                index = static_cast<EntityIndex>(_generations.size());
+                _generations.push_back(0);
+                _alive.push_back(false);
+            }
+
+            _alive[index] = true;
+            _aliveCount += 1;
+
+            return Pack(index, _generations[index]);
+        }
+
+        /// @brief Allocate a batch of slots, reusing freed ones first
+        /// @param handles Returned-by-parameter packed handle for each slot
+        void CreateMany(std::span<std::uint64_t> handles) {
+            std::size_t which = 0;
+
+            // Reuse as many freed slots as there are...
+            for (; which < handles.size() && !_freeIndices.empty(); ++which) {
+                const EntityIndex index = _freeIndices.back();
+                _freeIndices.pop_back();
+
+                _alive[index] = true;
+                handles[which] = Pack(index, _generations[index]);
+            }
+
+            // ... Then append fresh ones for the rest
+            const std::size_t fresh = handles.size() - which;
+            EntityIndex index = static_cast<EntityIndex>(_generations.size());
+
+            _generations.resize(_generations.size() + fresh, 0);
+            _alive.resize(_alive.size() + fresh, true);
+
+            for (; which < handles.size(); ++which, ++index) {
+                handles[which] = Pack(index, 0);
+            }
+
+            _aliveCount += handles.size();
+        }
+
+        /// @brief Free a slot, invalidating every handle pointing to it
+        /// @param handle Packed handle obtained via Create()
+        void Destroy(std::uint64_t handle) {
+            const EntityIndex index = IndexOf(handle);
+
+            _alive[index] = false;
+            _generations[index] += 1;
+            _freeIndices.push_back(index);
+            _aliveCount -= 1;
+        }
+
+        /// @brief Whether a handle still refers to a slot in use
+        /// @param handle Packed handle obtained via Create()
+        /// @return True if it does, false otherwise
+        bool Alive(std::uint64_t handle) const {
+            const EntityIndex index = IndexOf(handle);
+
+            return index < _generations.size() && _alive[index] &&
+                _generations[index] == GenerationOf(handle);
+        }
+
+        /// @brief Reserve room for a given amount of slots
+        void Reserve(std::size_t capacity) {
+            _generations.reserve(capacity);
+            _alive.reserve(capacity);
+        }
+
+        /// @brief Amount of slots currently in use
+        inline std::size_t Size() const
+        { return _aliveCount; }
+
+        /// @brief Amount of slots ever allocated (in use or not)
+        inline std::size_t Capacity() const
+        { return _generations.size(); }
+
+        /// @brief Copy every slot onto a snapshot
+        /// @param arena Arena recording the snapshot
+        void Save(SnapshotArena& arena) const {
+            arena.WriteArray<EntityGeneration>(_generations);
+            arena.WriteArray<EntityIndex>(_freeIndices);
+            arena.Write<std::uint64_t>(_aliveCount);
+
+            // (Bits get packed, so they're copied one per byte)
+            std::byte* alive = arena.WriteBytes(_alive.size());
+            for (std::size_t index = 0; index < _alive.size(); ++index) {
+                alive[index] = std::byte{_alive[index]};
+            }
+        }
+
+        /// @brief Replace every slot with those of a snapshot
+        /// @param arena Arena reading the snapshot
+        void Load(SnapshotArena& arena) {
+            arena.ReadArray(_generations);
+            arena.ReadArray(_freeIndices);
+            _aliveCount = arena.Read<std::uint64_t>();
+
+            const std::byte* alive = arena.ReadBytes(_generations.size());
+            _alive.resize(_generations.size());
+            std::size_t aliveCount = 0;
+            for (std::size_t index = 0; index < _alive.size(); ++index) {
+                _alive[index] = alive[index] != std::byte{0};
+                aliveCount += _alive[index] ? 1 : 0;
+            }
+
+            // Every slot must either be in use or pending reuse (once)
+            if (aliveCount != _aliveCount ||
+                _freeIndices.size() != _generations.size() - aliveCount) {
+                throw std::runtime_error("Malformed snapshot (inconsistent slots)");
+            }
+
+            std::vector<bool> freed(_generations.size(), false);
+            for (const EntityIndex index : _freeIndices) {
+                if (index >= _generations.size() || _alive[index] || freed[index]) {
+                    throw std::runtime_error("Malformed snapshot (inconsistent slots)");
+                }
+
+                freed[index] = true;
+            }
+        }
+
+        /// @brief Whether a given slot is currently in use
+        /// @param index Index of slot to check
+        /// @return True if it is, false otherwise
+        inline bool InUse(EntityIndex index) const
+        { return index < _alive.size() && _alive[index]; }
+};
+
+/// @brief Cached list of entities matching some component signature
+/// @remark Kept up-to-date incrementally on every structural change, so
+/// iterating it never visits an entity that doesn't match
+class EntityQuery {
+    private:
+        /// @brief Indices of matching entities
+        std::vector<EntityIndex> _matches;
+
+        /// @brief Entity index to position within matches (or NullIndex)
+        std::vector<std::uint32_t> _positions;
+
+    public:
+        /// @brief Amount of systems relying on this query
+        std::size_t users = 0;
+
+        /// @brief Whether a given entity is currently cached as a match
+        /// @param entity Index of entity to check
+        /// @return True if it is, false otherwise
+        inline bool Contains(EntityIndex entity) const {
+            return entity < _positions.size() && _positions[entity] != NullIndex;
+        }
+
+        /// @brief Bring a given entity's membership up to date
+        /// @param entity Index of entity whose signature changed
+        /// @param matches Whether the entity matches the query now
+        void Refresh(EntityIndex entity, bool matches) {
+            const bool cached = Contains(entity);
+
+            // Append newly-matching entities
+            if (matches && !cached) {
+                if (entity >= _positions.size()) {
+                    _positions.resize(entity + 1, NullIndex);
+                }
+
+                _positions[entity] = static_cast<std::uint32_t>(_matches.size());
+                _matches.push_back(entity);
+            }
+
+            // And swap-remove no-longer-matching ones
+            else if (!matches && cached) {
+                const std::uint32_t freed = _positions[entity];
+                const EntityIndex last = _matches.back();
+
+                _matches[freed] = last;
+                _positions[last] = freed;
+
+                _matches.pop_back();
+                _positions[entity] = NullIndex;
+            }
+        }
+
+        /// @brief Append a batch of entities known not to be cached yet
+        /// @param entities Indices of newly-matching entities
+        void Append(std::span<const EntityIndex> entities) {
+            if (entities.empty()) {
+                return;
+            }
+
+            const EntityIndex highest = *std::max_element(entities.begin(), entities.end());
+            if (highest >= _positions.size()) {
+                _positions.resize(highest + 1, NullIndex);
+            }
+
+            for (const EntityIndex entity : entities) {
+                _positions[entity] = static_cast<std::uint32_t>(_matches.size());
+                _matches.push_back(entity);
+            }
+        }
+
+        /// @brief Amount of matching entities
+        inline std::size_t Size() const
+        { return _matches.size(); }
+
+        /// @brief Indices of matching entities
+        inline const EntityIndex* Matches() const
+        { return _matches.data(); }
+
+        /// @brief Drop every match
+        void Clear() {
+            _matches.clear();
+            _positions.clear();
+        }
+
+        /// @brief Copy every match onto a snapshot
+        /// @param arena Arena recording the snapshot
+        void Save(SnapshotArena& arena) const {
+            arena.WriteArray<EntityIndex>(_matches);
+            arena.WriteArray<std::uint32_t>(_positions);
+        }
+
+        /// @brief Replace every match with those of a snapshot
+        /// @param arena Arena reading the snapshot
+        void Load(SnapshotArena& arena) {
+            arena.ReadArray(_matches);
+            arena.ReadArray(_positions);
+
+            // Every match must be mapped back from its entity...
+            for (std::uint32_t position = 0; position < _matches.size(); ++position) {
+                if (_matches[position] >= _positions.size() ||
+                    _positions[_matches[position]] != position) {
+                    throw std::runtime_error("Malformed snapshot (inconsistent matches)");
+                }
+            }
+
+            // ... And every mapping must point to a match of its entity
+            for (EntityIndex entity = 0; entity < _positions.size(); ++entity) {
+                const std::uint32_t position = _positions[entity];
+                if (position != NullIndex &&
+                    (position >= _matches.size() || _matches[position] != entity)) {
+                    throw std::runtime_error("Malformed snapshot (inconsistent matches)");
+                }
+            }
+        }
+
+        /// @brief Skip the matches of a snapshot
+        /// @param arena Arena reading the snapshot
+        static void Skip(SnapshotArena& arena) {
+            arena.SkipArray<EntityIndex>();
+            arena.SkipArray<std::uint32_t>();
+        }
+};
@@ -11,16 +11,17 @@
 #include "Services/WindowService.hpp"
 #include "Services/AssetStore.hpp"
 #include "Services/StopwatchService.hpp"
+#include "Services/JobService.hpp"
+#include "Services/BroadphaseService.hpp"
+#include "Services/InputService.hpp"
+#include "Services/ReloadService.hpp"
 
 // Entity-component systems' manager
 #include "ECS/ECS.hpp"
 
 // Alias for ECS to use
-using GameECS = ECS<
-    Physics,
-    Drawing
->::WithServices<
-    StopwatchService,
-    AssetStore,
-    WindowService
+using GameECS = GameWorld::WithSystems<
+    PhysicsSystem,
+    CollisionSystem,
+    DrawingSystem
 >;
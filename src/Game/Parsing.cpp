@@ -1,325 +1,214 @@
 // Easy I/O
 #include <iostream>
-#include <fstream>
-#include <sstream>
 
 // Filesystem navigation
 #include <filesystem>
 
+// Entity fingerprints
+#include <cstdint>
+
+// Zero-copy reading and tokenizing
+#include "Utils/MappedFile.hpp"
+
 // Core game definitions
 #include "Game/Core.hpp"
 
 // Definitions
 #include "Game/Parsing.hpp"
 
-WindowService ParseWindow(std::istream& input) {
+WindowConfig ParseWindow(TokenCursor& input) {
     // Collect parameters
-    int w, h, r, g, b;
+    WindowConfig config{};
 
-    input >> w;
-
-    if (input.fail()) {
+    if (!input.Next(config.width)) {
         throw std::runtime_error
         ("Unable to parse window width");
     }
 
-    input >> h;
-
-    if (input.fail()) {
+    if (!input.Next(config.height)) {
         throw std::runtime_error
         ("Unable to parse window height");
     }
 
-    input >> r;
-
-    if (input.fail()) {
+    if (!input.Next(config.red)) {
         throw std::runtime_error
         ("Unable to parse window red hue");
     }
 
-    input >> g;
-
-    if (input.fail()) {
+    if (!input.Next(config.green)) {
         throw std::runtime_error
         ("Unable to parse window green hue");
     }
 
-    input >> b;
-
-    if (input.fail()) {
+    if (!input.Next(config.blue)) {
         throw std::runtime_error
         ("Unable to parse window green hue");
     }
 
+    // Optionally, a presentation mode may follow
+    std::string_view mode;
+
+    if (input.Next(mode)) {
+        if (mode != "vsync") {
+            throw std::runtime_error
+            ("Unknown window presentation mode");
+        }
+
+        config.vsync = true;
+    }
+
     // Validate them
-    if (w < 0 || h < 0) {
+    if (config.width < 0 || config.height < 0) {
         throw std::runtime_error
         ("Invalid window dimensions");
     }
 
     if (
-        r < 0 || r > 255 ||
-        g < 0 || g > 255 ||
-        b < 0 || b > 255
+        config.red < 0 || config.red > 255 ||
+        config.green < 0 || config.green > 255 ||
+        config.blue < 0 || config.blue > 255
     ) {
         throw std::runtime_error
         ("Invalid RGB color (hues must be within 0-255)");
     }
 
-    // Build the window
-    return std::move(
-        WindowService(
-            w, h, 60,
-            SDL_Color{
-                (unsigned char) r, 
-                (unsigned char) g, 
-                (unsigned char) b
-            },
-            "RAM Gobbler (TM)"
-    ));
+    return config;
 }
 
-void ParseFont(AssetStore& assetStore, std::istream& input) {
+FontConfig ParseFont(TokenCursor& input) {
     // Collect parameters
-    int r, g, b, s;
-    std::string p;
-
-    input >> p;
+    FontConfig config{};
 
-    if (input.fail()) {
+    if (!input.Next(config.path)) {
         throw std::runtime_error
         ("Unable to parse font path");
     }
 
-    input >> r;
-
-    if (input.fail()) {
+    if (!input.Next(config.red)) {
         throw std::runtime_error
         ("Unable to parse window red hue");
     }
 
-    input >> g;
-
-    if (input.fail()) {
+    if (!input.Next(config.green)) {
         throw std::runtime_error
         ("Unable to parse window green hue");
     }
 
-    input >> b;
-
-    if (input.fail()) {
+    if (!input.Next(config.blue)) {
         throw std::runtime_error
         ("Unable to parse window green hue");
     }
 
-    input >> s;
-
-    if (input.fail()) {
+    if (!input.Next(config.size)) {
         throw std::runtime_error
         ("Unable to parse font size");
     }
 
     // Validate them
-    if (s < 0) {
+    if (config.size < 0) {
         throw std::runtime_error
         ("Invalid font size");
     }
 
     if (
-        r < 0 || r > 255 ||
-        g < 0 || g > 255 ||
-        b < 0 || b > 255
+        config.red < 0 || config.red > 255 ||
+        config.green < 0 || config.green > 255 ||
+        config.blue < 0 || config.blue > 255
     ) {
         throw std::runtime_error
         ("Invalid RGB color (hues must be within 0-255)");
     }
 
+    const std::filesystem::path path(config.path);
+
     if (
-        !std::filesystem::exists(p) ||
-        !std::filesystem::path(p).has_filename() ||
-        std::filesystem::path(p).extension() != ".ttf"
+        !std::filesystem::exists(path) ||
+        !path.has_filename() ||
+        path.extension() != ".ttf"
     ) {
         throw std::runtime_error
         ("Invalid font file path");
     }
 
-    // Load the font
-    assetStore.LoadFont(
-        p.c_str(), s, SDL_Color{
-            (unsigned char) r, 
-            (unsigned char) g, 
-            (unsigned char) b
-        }
-    );
+    return config;
 }
 
-bool ParseEntity(WindowService& window, AssetStore& assets,
-    GameECS& ecs, std::istream& input) {
+bool ParseEntity(TokenCursor& input, EntityConfig& entity) {
     // Collect parameters
-    std::string l, p;
-    int w, h, px, py, vx, vy;
-    double a;
-
-    input >> l;
-
-    if (input.fail()) {
+    if (!input.Next(entity.label)) {
         std::cerr << "Unable to parse entity text tag\n";
         return false;
     }
 
-    input >> p;
-
-    if (input.fail()) {
+    if (!input.Next(entity.image)) {
         std::cerr << "Unable to parse entity image filepath\n";
         return false;
     }
 
-    input >> w;
-
-    if (input.fail()) {
+    if (!input.Next(entity.width)) {
         std::cerr << "Unable to parse entity width\n";
         return false;
     }
 
-    input >> h;
-
-    if (input.fail()) {
+    if (!input.Next(entity.height)) {
         std::cerr << "Unable to parse entity height\n";
         return false;
     }
 
-    input >> px;
-
-    if (input.fail()) {
+    if (!input.Next(entity.x)) {
         std::cerr << "Unable to parse entity x coord\n";
         return false;
     }
 
-    input >> py;
-
-    if (input.fail()) {
+    if (!input.Next(entity.y)) {
         std::cerr << "Unable to parse entity y coord\n";
         return false;
     }
 
-    input >> vx;
-
-    if (input.fail()) {
+    if (!input.Next(entity.vx)) {
         std::cerr << "Unable to parse entity x velocity\n";
         return false;
     }
 
-    input >> vy;
-
-    if (input.fail()) {
+    if (!input.Next(entity.vy)) {
         std::cerr << "Unable to parse entity y velocity\n";
         return false;
     }
 
-    input >> a;
-
-    if (input.fail()) {
+    if (!input.Next(entity.angle)) {
         std::cerr << "Unable to parse entity angle of rotation\n";
         return false;
     }
 
-    // Validate them
-    if (
-        !std::filesystem::exists(p) ||
-        !std::filesystem::path(p).has_filename() ||
-        !std::filesystem::path(p).has_extension()
-    ) {
-        std::cerr << "Invalid image path for entity\n";
-        return false;
-    }
-
-    if (!(w > 0 && h > 0)) {
+    // Validate them (image paths get checked once per path later on)
+    if (!(entity.width > 0 && entity.height > 0)) {
         std::cerr << "Invalid image size for entity (must be positive)\n";
         return false;
     }
 
-    // Load / find entity image texture
-    SDL_Texture* imageTexture = (SDL_Texture*) assets.GetTexture(p.c_str());
-    if (imageTexture == nullptr) {
-        imageTexture = (SDL_Texture*) assets.LoadImage(
-            window, p.c_str(), p.c_str()
-        );
-    }
-
-    if (imageTexture == nullptr) {
-        std::cerr << "Unable to load entity image\n";
-        return false;
-    }
-
-    // Load / find entity text texture
-    glm::uvec2 textSize;
-    SDL_Texture* textTexture = (SDL_Texture*) assets.GetTexture(l.c_str());
-    if (textTexture == nullptr) {
-        textTexture = (SDL_Texture*) assets.LoadText(
-            window, l.c_str(), l.c_str(), textSize
-        );
-    }
-
-    if (textTexture == nullptr) {
-        std::cerr << "Unable to load entity text\n";
-        return false;
-    }
-
-    // Load entity
-    ecs.AddEntity(
-        Physics{
-            .velocity{vx, vy},
-            .position{px, py},
-            .size{w, h},
-            .angle{a},
-        },
-        Drawing{
-            .imageSize{w, h},
-            .textSize{textSize},
-            .imageRef{imageTexture},
-            .textRef{textTexture},
-        }
-    );
-
     return true;
 }
 
-WindowService ParseConfig(
-    const char* configPath,
-    AssetStore& assets, 
-    GameECS& ecs
-) {
-    // Sanity check the path
-    if (!std::filesystem::path(configPath).has_filename()) {
-        throw std::invalid_argument(
-            "Invalid configuration path (not a file)"
-        );
-    }
-
-    // Attempt to load config file from it
-    std::ifstream config(configPath);
+GameConfig ReadConfig(std::string_view contents) {
+    GameConfig config{};
 
-    if (!config.is_open()) {
-        throw std::runtime_error("Unable to open config file");
-    }
-
-    // Read line by line
-    // And keep track of the name of the thing to parse
-    std::string line, objectName;
+    // Read line by line, keeping track of the name of the thing to parse
+    std::string_view objectName;
 
     /// Also, keep track of parsed dependencies
     bool windowParsed = false, fontParsed = false;
-    WindowService window(
-        10, 10, 60, {255,255,255}, "Cargando..."
-    ); 
-
-    for (
-        unsigned lineNum = 0;
-        !config.eof() && std::getline(config, line);
-        lineNum += 1
-    ) {
-        std::istringstream lineStream(line);
-        lineStream >> objectName;
+
+    for (unsigned lineNum = 0; !contents.empty(); lineNum += 1) {
+        const std::size_t lineEnd = contents.find('\n');
+        TokenCursor lineStream(contents.substr(0, lineEnd));
+        contents.remove_prefix(
+            lineEnd == std::string_view::npos ? contents.size() : lineEnd + 1
+        );
+
+        // Skip blank lines
+        if (!lineStream.Next(objectName)) {
+            continue;
+        }
 
         // Game window
         if (objectName == "window") {
@@ -329,7 +218,7 @@ WindowService ParseConfig(
                 );
             }
 
-            window = std::move(ParseWindow(lineStream));
+            config.window = ParseWindow(lineStream);
             windowParsed = true;
 
             std::cout << "Parsed window" << std::endl;
@@ -349,7 +238,7 @@ WindowService ParseConfig(
                 );
             }
 
-            ParseFont(assets, lineStream);
+            config.font = ParseFont(lineStream);
             fontParsed = true;
         }
 
@@ -367,11 +256,377 @@ WindowService ParseConfig(
                 );
             }
 
-            if (!ParseEntity(window, assets, ecs, lineStream)) {
-                std::cerr << 
-                    "Unable to load entity at line " << lineNum << 
+            EntityConfig entity{};
+            entity.line = lineNum;
+
+            if (!ParseEntity(lineStream, entity)) {
+                std::cerr <<
+                    "Unable to load entity at line " << lineNum <<
                     std::endl;
-            };
+                continue;
+            }
+
+            // Drawings only hold so much text, so say when it gets cut
+            if (entity.label.size() >= Drawing::LabelCapacity) {
+                std::cerr <<
+                    "Truncating entity text tag at line " << lineNum <<
+                    " to " << Drawing::LabelCapacity - 1 << " characters" <<
+                    std::endl;
+            }
+
+            config.entities.push_back(entity);
+        }
+    }
+
+    // Every configuration needs a window and a font
+    if (!windowParsed) {
+        throw std::runtime_error("Window config is missing");
+    }
+
+    if (!fontParsed) {
+        throw std::runtime_error("Font config is missing");
+    }
+
+    return config;
+}
+
+bool ValidImagePath(std::string_view p) {
+    const std::filesystem::path path(p);
+
+    return
+        std::filesystem::exists(path) &&
+        path.has_filename() &&
+        path.has_extension();
+}
+
+WindowService BuildWindow(const WindowConfig& config, bool headless) {
+    // Only keep its size if headless
+    if (headless) {
+        return WindowService(glm::uvec2(config.width, config.height));
+    }
+
+    return std::move(
+        WindowService(
+            config.width, config.height, 60,
+            SDL_Color{
+                (unsigned char) config.red,
+                (unsigned char) config.green,
+                (unsigned char) config.blue
+            },
+            "RAM Gobbler (TM)",
+            config.vsync
+    ));
+}
+
+void BuildFont(const WindowService& window, AssetStore& assetStore,
+    const FontConfig& config) {
+    // Fonts are opened by null-terminated path
+    const std::string path(config.path);
+
+    // (Opaque, as blended glyphs get their coverage scaled by alpha)
+    assetStore.LoadFont(
+        window, path.c_str(), config.size, SDL_Color{
+            (unsigned char) config.red,
+            (unsigned char) config.green,
+            (unsigned char) config.blue,
+            255
+        }
+    );
+}
+
+bool ResolveImage(WindowService& window, AssetStore& assets,
+    const char* path, CachedImage& image) {
+    // Request / find the image asset only once
+    if (!image.loaded) {
+        image.asset = assets.GetAsset(path);
+        if (image.asset == NullAsset) {
+            image.asset = assets.RequestImage(window, path, path);
+        }
+
+        image.loaded = true;
+    }
+
+    // (Headless windows hold no textures at all)
+    return image.asset != NullAsset || window.Headless();
+}
+
+bool LookupImage(WindowService& window, AssetStore& assets,
+    std::string_view path, ImageCache& images, AssetID& asset) {
+    ImageCache::iterator image = images.find(path);
+    if (image == images.end()) {
+        image = images.emplace(
+            std::string(path),
+            CachedImage{ValidImagePath(path)}
+        ).first;
+    }
+
+    if (!image->second.valid) {
+        std::cerr << "Invalid image path for entity\n";
+        return false;
+    }
+
+    if (!ResolveImage(window, assets, image->first.c_str(), image->second)) {
+        std::cerr << "Unable to load entity image\n";
+        return false;
+    }
+
+    asset = image->second.asset;
+    return true;
+}
+
+void BatchEntity(const AssetStore& assets, const EntityConfig& entity,
+    AssetID image, EntityBatch& batch) {
+    // Keep entity text inline (truncated to fit), and measure it
+    // against the font's glyphs
+    std::array<char, Drawing::LabelCapacity> label{};
+    entity.label.copy(label.data(), label.size() - 1);
+
+    const glm::uvec2 textSize = assets.GetGlyphs().Measure(label.data());
+
+    batch.physics.push_back(Physics{
+        .velocity{entity.vx, entity.vy},
+        .position{entity.x, entity.y},
+        .previousPosition{entity.x, entity.y},
+        .size{entity.width, entity.height},
+        .angle{entity.angle},
+    });
+
+    Drawing& drawing = batch.drawings.emplace_back(Drawing{
+        .imageSize{entity.width, entity.height},
+        .textSize{textSize},
+        .image{image},
+        .label{label},
+    });
+
+    // Lay the label out once, rather than on every drawn frame
+    drawing.Layout();
+}
+
+std::vector<GameECS::EntityID> SpawnBatch(GameECS& ecs, const EntityBatch& batch) {
+    return ecs.AddEntities<Physics, Drawing>(batch.physics, batch.drawings);
+}
+
+std::string LiveName(std::string_view label, unsigned occurrence) {
+    // Labels hold no whitespace, so tell repeated ones apart past a newline
+    std::string name(label);
+    if (occurrence > 0) {
+        name += '\n';
+        name += std::to_string(occurrence);
+    }
+
+    return name;
+}
+
+/// @brief Fold some bytes onto a fingerprint (64-bit FNV-1a)
+/// @param hash Fingerprint so far
+/// @param data Bytes to fold
+/// @param size Amount of bytes
+/// @return Fingerprint of the bytes folded so far
+static std::uint64_t Fold(std::uint64_t hash, const void* data, std::size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t which = 0; which < size; ++which) {
+        hash ^= bytes[which];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+ReloadService::LiveEntity Fingerprint(const EntityConfig& entity, GameECS::EntityID id) {
+    constexpr std::uint64_t basis = 0xcbf29ce484222325ull;
+
+    // Physics get built off the box and its motion...
+    std::uint64_t physics = basis;
+    for (int parameter : {entity.width, entity.height, entity.x, entity.y, entity.vx, entity.vy}) {
+        physics = Fold(physics, &parameter, sizeof(parameter));
+    }
+
+    physics = Fold(physics, &entity.angle, sizeof(entity.angle));
+
+    // ... Drawings off the label, image and its size (strings get their
+    // length folded first, so they can't run into each other)
+    std::uint64_t drawing = basis;
+    for (std::string_view text : {entity.label, entity.image}) {
+        const std::size_t length = text.size();
+        drawing = Fold(drawing, &length, sizeof(length));
+        drawing = Fold(drawing, text.data(), text.size());
+    }
+
+    drawing = Fold(drawing, &entity.width, sizeof(entity.width));
+    drawing = Fold(drawing, &entity.height, sizeof(entity.height));
+
+    return ReloadService::LiveEntity{id, physics, drawing};
+}
+
+SceneDiff ReloadConfig(
+    const char* path,
+    AssetStore& assets,
+    WindowService& window,
+    GameECS::ManagerService& ecsManager,
+    ReloadService::LiveEntities& live
+) {
+    // Read it again, same as when parsed at first (throwing before
+    // anything changes if malformed)
+    const MappedFile file(path);
+
+    if (!file.IsOpen()) {
+        throw std::runtime_error("Unable to open config file");
+    }
+
+    const GameConfig config = ReadConfig(file.View());
+
+    // Then match its entities against the live ones by name
+    SceneDiff diff;
+    ReloadService::LiveEntities next;
+    next.reserve(config.entities.size());
+
+    std::unordered_map<std::string_view, unsigned> occurrences;
+    std::vector<std::pair<std::string, ReloadService::LiveEntity>> spawned;
+    ImageCache images;
+    EntityBatch batch, rebuilt;
+
+    for (const EntityConfig& entity : config.entities) {
+        std::string name = LiveName(entity.label, occurrences[entity.label]++);
+        const ReloadService::LiveEntities::iterator found = live.find(name);
+
+        // Keep entities whose image can't load as they were (or out, if new)
+        AssetID image = NullAsset;
+        if (!LookupImage(window, assets, entity.image, images, image)) {
+            std::cerr <<
+                "Unable to reload entity at line " << entity.line <<
+                std::endl;
+
+            if (found != live.end()) {
+                next.insert(live.extract(found));
+            }
+
+            continue;
+        }
+
+        ReloadService::LiveEntity fingerprint = Fingerprint(entity, 0);
+
+        // Newly configured entities get added all at once, later on
+        if (found == live.end()) {
+            BatchEntity(assets, entity, image, batch);
+            spawned.emplace_back(std::move(name), fingerprint);
+            continue;
+        }
+
+        // Others only get the components configured differently replaced
+        fingerprint.entity = found->second.entity;
+        const bool physicsChanged = fingerprint.physics != found->second.physics;
+        const bool drawingChanged = fingerprint.drawing != found->second.drawing;
+
+        if (physicsChanged || drawingChanged) {
+            rebuilt.physics.clear();
+            rebuilt.drawings.clear();
+            BatchEntity(assets, entity, image, rebuilt);
+
+            if (physicsChanged) {
+                ecsManager.Commands().Install(fingerprint.entity, rebuilt.physics.front());
+                diff.modified += 1;
+            }
+
+            if (drawingChanged) {
+                ecsManager.Commands().Install(fingerprint.entity, rebuilt.drawings.front());
+                diff.modified += 1;
+            }
+        }
+
+        live.erase(found);
+        next.emplace(std::move(name), fingerprint);
+    }
+
+    // Entities left unmatched are no longer configured
+    for (const auto& [name, entity] : live) {
+        ecsManager.Commands().Despawn(entity.entity);
+        diff.removed += 1;
+    }
+
+    // Add the new ones, now that they get IDs
+    const std::vector<GameECS::EntityID> ids =
+        ecsManager.AddEntities<Physics, Drawing>(batch.physics, batch.drawings);
+
+    for (std::size_t which = 0; which < ids.size(); ++which) {
+        spawned[which].second.entity = ids[which];
+        next.emplace(std::move(spawned[which].first), spawned[which].second);
+    }
+
+    diff.added = ids.size();
+    live.swap(next);
+
+    return diff;
+}
+
+WindowService ParseConfig(
+    const char* configPath,
+    AssetStore& assets,
+    GameECS& ecs,
+    bool headless,
+    ReloadService::LiveEntities* live
+) {
+    // Sanity check the path
+    if (!std::filesystem::path(configPath).has_filename()) {
+        throw std::invalid_argument(
+            "Invalid configuration path (not a file)"
+        );
+    }
+
+    // Attempt to map config file from it
+    const MappedFile file(configPath);
+
+    if (!file.IsOpen()) {
+        throw std::runtime_error("Unable to open config file");
+    }
+
+    // Read it straight off the mapped contents
+    const GameConfig config = ReadConfig(file.View());
+
+    // Build the services it configures
+    WindowService window = BuildWindow(config.window, headless);
+    BuildFont(window, assets, config.font);
+
+    // Then its entities, looking each image path up only once
+    ImageCache images;
+    EntityBatch batch;
+
+    batch.physics.reserve(config.entities.size());
+    batch.drawings.reserve(config.entities.size());
+
+    // (Naming them as reloading does, if to be reloaded)
+    std::unordered_map<std::string_view, unsigned> occurrences;
+    std::vector<std::pair<std::string, const EntityConfig*>> batched;
+
+    for (const EntityConfig& entity : config.entities) {
+        const unsigned occurrence = occurrences[entity.label]++;
+
+        AssetID image = NullAsset;
+        if (LookupImage(window, assets, entity.image, images, image)) {
+            BatchEntity(assets, entity, image, batch);
+            if (live != nullptr) {
+                batched.emplace_back(LiveName(entity.label, occurrence), &entity);
+            }
+
+            continue;
+        }
+
+        std::cerr <<
+            "Unable to load entity at line " << entity.line <<
+            std::endl;
+    }
+
+    // And add them all at once
+    const std::vector<GameECS::EntityID> ids = SpawnBatch(ecs, batch);
+
+    // Remembering which line built each one, if to be reloaded
+    if (live != nullptr) {
+        live->clear();
+
+        for (std::size_t which = 0; which < ids.size(); ++which) {
+            live->emplace(
+                std::move(batched[which].first),
+                Fingerprint(*batched[which].second, ids[which])
+            );
         }
     }
 
@@ -3,37 +3,243 @@
 // Core game definitions
 #include "Game/Core.hpp"
 
-// Service parsing
+// Line tokenizing
+#include "Utils/TokenCursor.hpp"
 
-/// @brief Construct a window service given some input config
-/// @param input Input stream containing space-delimited parameters
+// Image lookups by path
+#include <string>
+#include <string_view>
+#include <functional>
+#include <unordered_map>
+
+// Entity batches
+#include <vector>
+
+/// @brief Outcome of looking up an image path, kept so every entity
+/// sharing it skips the filesystem and asset store
+struct CachedImage {
+    /// @brief Whether the path refers to an existing image file
+    bool valid;
+    /// @brief Whether loading it was requested already
+    bool loaded = false;
+    /// @brief Asset requested for it (null if not requested or headless)
+    AssetID asset = NullAsset;
+};
+
+/// @brief Hash over paths, also for views onto them (to look them up
+/// without copies)
+struct PathHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view path) const
+    { return std::hash<std::string_view>{}(path); }
+};
+
+/// @brief Images looked up so far, by path
+using ImageCache = std::unordered_map<std::string, CachedImage, PathHash, std::equal_to<>>;
+
+/// @brief Window parameters, as configured
+struct WindowConfig {
+    /// @brief Dimensions of the window
+    int width, height;
+    /// @brief Background color hues (within 0-255)
+    int red, green, blue;
+    /// @brief Whether presenting waits for vertical sync
+    bool vsync;
+};
+
+/// @brief Font parameters, as configured
+/// @remark The path is a view onto the configuration's contents
+struct FontConfig {
+    /// @brief Path to the font file
+    std::string_view path;
+    /// @brief Text color hues (within 0-255)
+    int red, green, blue;
+    /// @brief Size of the font
+    int size;
+};
+
+/// @brief Entity parameters, as configured
+/// @remark The label and image path are views onto the configuration's
+/// contents
+struct EntityConfig {
+    /// @brief Display text
+    std::string_view label;
+    /// @brief Path to the image file
+    std::string_view image;
+    /// @brief Dimensions of the image (and colliding box)
+    int width, height;
+    /// @brief Initial position coordinates
+    int x, y;
+    /// @brief Initial velocity vector
+    int vx, vy;
+    /// @brief Angle of orientation (degrees)
+    double angle;
+    /// @brief Line of the configuration it was read from
+    unsigned line;
+};
+
+/// @brief Every parameter of a configuration
+/// @remark Views onto the configuration's contents, so these must outlive it
+struct GameConfig {
+    /// @brief Window parameters
+    WindowConfig window;
+    /// @brief Font parameters
+    FontConfig font;
+    /// @brief Parameters of every well-formed entity, in order
+    std::vector<EntityConfig> entities;
+};
+
+/// @brief Changes applied onto a live ECS by reloading its configuration
+struct SceneDiff {
+    /// @brief Entities added (newly configured)
+    std::size_t added = 0;
+    /// @brief Entities removed (no longer configured)
+    std::size_t removed = 0;
+    /// @brief Components replaced (configured differently)
+    std::size_t modified = 0;
+};
+
+/// @brief Entity components built so far, to add onto an ECS at once
+struct EntityBatch {
+    /// @brief Physics component of each entity
+    std::vector<Physics> physics;
+    /// @brief Drawing component of each entity (same order)
+    std::vector<Drawing> drawings;
+};
+
+// Configuration reading
+
+/// @brief Read window parameters off some input config
+/// @param input Tokens of the space-delimited parameters
+/// @return Validated window parameters
+WindowConfig ParseWindow(TokenCursor& input);
+
+/// @brief Read font parameters off some input config
+/// @param input Tokens of the space-delimited parameters
+/// @return Validated font parameters (its path referring to a font file)
+FontConfig ParseFont(TokenCursor& input);
+
+/// @brief Read entity parameters off some input config
+/// @param input Tokens of the space-delimited parameters
+/// @param entity Returned-by-parameter entity parameters
+/// @return True if read succesfully, false otherwise
+bool ParseEntity(TokenCursor& input, EntityConfig& entity);
+
+/// @brief Read every parameter off the contents of a configuration
+/// @param contents Contents of the configuration file
+/// @return Parameters of window, font and well-formed entities
+GameConfig ReadConfig(std::string_view contents);
+
+/// @brief Whether a path refers to an existing image file
+/// @param path Path to check
+bool ValidImagePath(std::string_view path);
+
+// Service & entity building
+
+/// @brief Construct a window service given its parameters
+/// @param config Window parameters
+/// @param headless Whether to construct a headless window instead
 /// @return Constructed window
-WindowService ParseWindow(std::istream& input);
+WindowService BuildWindow(const WindowConfig& config, bool headless = false);
 
-/// @brief Load a font asset given some parameters
+/// @brief Load a font asset given its parameters
+/// @param window Window to draw glyphs with
 /// @param assetStore Asset store to load font into
-/// @param input Input stream containing space-delimited parameters
-void ParseFont(AssetStore& assetStore, std::istream& input);
-
-/// @brief Load an entity given some parameters
-/// @param window Window to draw entities with
-/// @param assets Assets to draw entites with
-/// @param assets ECS to place entities into
-/// @param input Input stream containing space-delimited parameters
-/// @return True if loaded succesfully, false otherwise
-bool ParseEntity(WindowService& window, AssetStore& assets,
-    GameECS& ecs, std::istream& input);
+/// @param config Font parameters
+void BuildFont(const WindowService& window, AssetStore& assetStore,
+    const FontConfig& config);
+
+/// @brief Request (or find) an image asset, only once per cached image
+/// @param window Window to draw the image with
+/// @param assets Asset store to load the image into
+/// @param path Null-terminated path of the image file
+/// @param image Cached outcome of looking up that path
+/// @return True if entities may draw it, false otherwise
+/// @remark Images load off the calling thread, so entities get drawn with
+/// a placeholder until they do
+bool ResolveImage(WindowService& window, AssetStore& assets,
+    const char* path, CachedImage& image);
+
+/// @brief Look the image of an entity up (only once per path), then
+/// request it if not yet
+/// @param window Window to draw the image with
+/// @param assets Asset store to load the image into
+/// @param path Path of the image file
+/// @param images Images looked up so far
+/// @param asset Returned-by-parameter image asset to draw the entity with
+/// @return True if entities may draw it, false otherwise (reported)
+bool LookupImage(WindowService& window, AssetStore& assets,
+    std::string_view path, ImageCache& images, AssetID& asset);
+
+/// @brief Build the components of an entity onto a batch
+/// @param assets Assets to measure the entity's text with
+/// @param entity Entity parameters
+/// @param image Image asset to draw the entity with
+/// @param batch Batch to append the components onto
+void BatchEntity(const AssetStore& assets, const EntityConfig& entity,
+    AssetID image, EntityBatch& batch);
+
+/// @brief Add every entity of a batch onto an ECS at once
+/// @param ecs ECS to add the entities into
+/// @param batch Batch of entity components
+/// @return IDs of the entities added, in batch order
+std::vector<GameECS::EntityID> SpawnBatch(GameECS& ecs, const EntityBatch& batch);
+
+// Live reloading
+
+/// @brief Stable name of a configured entity
+/// @param label Label of the entity
+/// @param occurrence Entities configured with the same label before it
+/// @return Name to know the entity by across reloads
+std::string LiveName(std::string_view label, unsigned occurrence);
+
+/// @brief Fingerprint the parameters each component of an entity gets
+/// built from
+/// @param entity Entity parameters
+/// @param id ID of the entity built off them
+/// @return Live entity to remember them by
+ReloadService::LiveEntity Fingerprint(const EntityConfig& entity, GameECS::EntityID id);
+
+/// @brief Read a configuration again, then bring a live ECS up to date
+/// with it: adding newly configured entities, removing those no longer
+/// configured and replacing the components of those configured differently
+/// @param path Path to the configuration file
+/// @param assets Asset store to load new images into (already loaded ones
+/// get reused)
+/// @param window Window to draw new images with
+/// @param ecsManager ECS to bring up to date, from a service action
+/// @param live Returned-by-parameter entities built off the configuration
+/// last read (updated to this one)
+/// @return Changes applied (removals and replacements apply once the
+/// current sweep ends)
+/// @remark The window and font are only built once, so changes to their
+/// lines are ignored. Throws if the configuration is malformed, changing
+/// nothing
+SceneDiff ReloadConfig(
+    const char* path,
+    AssetStore& assets,
+    WindowService& window,
+    GameECS::ManagerService& ecsManager,
+    ReloadService::LiveEntities& live
+);
 
 // Configuration parsing
 
-/// @brief Attempt to parse and utilize the configuration 
-/// provided to build entities and assets in the game 
+/// @brief Attempt to parse and utilize the configuration
+/// provided to build entities and assets in the game
 /// @param configPath Path to the configuration file
 /// @param assets Asset store used to load texture
 /// @param ecs ECS used to add entites
+/// @param headless Whether to skip window and texture creation (entities
+/// still get simulated within the window's size)
+/// @param live Returned-by-parameter entities built, by name (to reload
+/// the configuration later on, if given)
 /// @return Window used to render textures
 WindowService ParseConfig(
     const char* path,
-    AssetStore& assets, 
-    GameECS& ecs
+    AssetStore& assets,
+    GameECS& ecs,
+    bool headless = false,
+    ReloadService::LiveEntities* live = nullptr
 );
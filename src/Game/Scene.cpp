@@ -0,0 +1,344 @@
+// Easy I/O
+#include <iostream>
+#include <fstream>
+
+// Filesystem navigation
+#include <filesystem>
+
+// Record copying & lookups
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Zero-copy reading
+#include "Utils/MappedFile.hpp"
+
+// Configuration reading & entity building
+#include "Game/Parsing.hpp"
+
+// Definitions
+#include "Game/Scene.hpp"
+
+namespace {
+    /// @brief Byte offsets of every section of a scene
+    struct SceneLayout {
+        /// @brief Offset of the string entries
+        std::size_t strings;
+        /// @brief Offset of the image entries
+        std::size_t images;
+        /// @brief Offset of the entity records
+        std::size_t entities;
+        /// @brief Offset of the string bytes
+        std::size_t bytes;
+        /// @brief Offset past the last section
+        std::size_t end;
+    };
+
+    /// @brief Round an offset up to the alignment of sections
+    constexpr std::size_t Align(std::size_t offset)
+    { return (offset + 7) & ~std::size_t{7}; }
+
+    /// @brief Lay the sections of a scene out, given its header
+    SceneLayout LayoutOf(const SceneHeader& header) {
+        SceneLayout layout;
+
+        layout.strings = Align(sizeof(SceneHeader));
+        layout.images = Align(layout.strings + header.stringCount * sizeof(SceneString));
+        layout.entities = Align(layout.images + header.imageCount * sizeof(std::uint32_t));
+        layout.bytes = Align(layout.entities + header.entityCount * sizeof(SceneEntity));
+        layout.end = layout.bytes + header.stringBytes;
+
+        return layout;
+    }
+
+    /// @brief Image entry of images whose path isn't valid
+    constexpr std::uint32_t InvalidImage = std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief Copy a record out of some (unaligned) scene contents
+    /// @tparam Record Type of record to copy
+    /// @param contents Contents of the scene
+    /// @param offset Offset of the record within the contents
+    template <typename Record>
+    Record RecordAt(std::string_view contents, std::size_t offset) {
+        Record record;
+        std::memcpy(&record, contents.data() + offset, sizeof(Record));
+        return record;
+    }
+}
+
+void BakeScene(const char* configPath, const char* scenePath) {
+    // Map and read the whole config
+    const MappedFile file(configPath);
+
+    if (!file.IsOpen()) {
+        throw std::runtime_error("Unable to open config file");
+    }
+
+    const GameConfig config = ReadConfig(file.View());
+
+    // Keep every string once (they're views onto the mapped config)
+    std::vector<SceneString> strings;
+    std::string bytes;
+    std::unordered_map<std::string_view, std::uint32_t, PathHash> stringIndices;
+
+    const auto intern = [&] (std::string_view text) {
+        const auto [where, created] = stringIndices.try_emplace(
+            text, static_cast<std::uint32_t>(strings.size()));
+
+        if (created) {
+            strings.push_back(SceneString{
+                static_cast<std::uint32_t>(bytes.size()),
+                static_cast<std::uint32_t>(text.size())
+            });
+
+            bytes.append(text);
+            bytes.push_back('\0');
+        }
+
+        return where->second;
+    };
+
+    // Fill in the services
+    SceneHeader header{};
+    header.magic = SceneMagic;
+    header.version = SceneVersion;
+    header.byteOrder = SceneByteOrder;
+
+    header.windowWidth = static_cast<std::uint32_t>(config.window.width);
+    header.windowHeight = static_cast<std::uint32_t>(config.window.height);
+    header.windowColor = {
+        (std::uint8_t) config.window.red,
+        (std::uint8_t) config.window.green,
+        (std::uint8_t) config.window.blue
+    };
+    header.windowVSync = config.window.vsync;
+
+    header.fontPath = intern(config.font.path);
+    header.fontColor = {
+        (std::uint8_t) config.font.red,
+        (std::uint8_t) config.font.green,
+        (std::uint8_t) config.font.blue
+    };
+    header.fontSize = static_cast<std::uint32_t>(config.font.size);
+
+    // Then pack the entities, looking each image path up only once
+    std::vector<std::uint32_t> images;
+    std::unordered_map<std::string_view, std::uint32_t, PathHash> imageIndices;
+    std::vector<SceneEntity> entities;
+    entities.reserve(config.entities.size());
+
+    for (const EntityConfig& entity : config.entities) {
+        auto [image, created] = imageIndices.try_emplace(entity.image, InvalidImage);
+        if (created && ValidImagePath(entity.image)) {
+            image->second = static_cast<std::uint32_t>(images.size());
+            images.push_back(intern(entity.image));
+        }
+
+        if (image->second == InvalidImage) {
+            std::cerr << "Invalid image path for entity\n" <<
+                "Unable to load entity at line " << entity.line <<
+                std::endl;
+            continue;
+        }
+
+        // (Labels get truncated here already, so shared prefixes dedupe)
+        entities.push_back(SceneEntity{
+            .velocity{entity.vx, entity.vy},
+            .position{entity.x, entity.y},
+            .size{
+                static_cast<std::uint32_t>(entity.width),
+                static_cast<std::uint32_t>(entity.height)
+            },
+            .angle = entity.angle,
+            .image = image->second,
+            .label = intern(entity.label.substr(0, Drawing::LabelCapacity - 1)),
+            .line = entity.line,
+            .padding = 0
+        });
+    }
+
+    if (bytes.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("Scene strings exceed 4 GiB");
+    }
+
+    header.stringCount = static_cast<std::uint32_t>(strings.size());
+    header.imageCount = static_cast<std::uint32_t>(images.size());
+    header.entityCount = static_cast<std::uint32_t>(entities.size());
+    header.stringBytes = static_cast<std::uint32_t>(bytes.size());
+
+    // Write every section down, padding each to its offset
+    const SceneLayout layout = LayoutOf(header);
+    std::ofstream scene(scenePath, std::ios::binary | std::ios::trunc);
+
+    if (!scene.is_open()) {
+        throw std::runtime_error("Unable to open scene file for writing");
+    }
+
+    const auto write = [&] (std::size_t offset, const void* data, std::size_t size) {
+        static constexpr char zeroes[8]{};
+        const std::size_t written = static_cast<std::size_t>(scene.tellp());
+
+        scene.write(zeroes, offset - written);
+        scene.write(static_cast<const char*>(data), size);
+    };
+
+    write(0, &header, sizeof(header));
+    write(layout.strings, strings.data(), strings.size() * sizeof(SceneString));
+    write(layout.images, images.data(), images.size() * sizeof(std::uint32_t));
+    write(layout.entities, entities.data(), entities.size() * sizeof(SceneEntity));
+    write(layout.bytes, bytes.data(), bytes.size());
+
+    if (!scene) {
+        throw std::runtime_error("Unable to write scene file");
+    }
+
+    std::cout << "Baked " << entities.size() << " entities (" <<
+        images.size() << " images, " << strings.size() << " strings) onto \"" <<
+        scenePath << "\"" << std::endl;
+}
+
+WindowService LoadScene(
+    const char* scenePath,
+    AssetStore& assets,
+    GameECS& ecs,
+    bool headless
+) {
+    // Sanity check the path
+    if (!std::filesystem::path(scenePath).has_filename()) {
+        throw std::invalid_argument(
+            "Invalid scene path (not a file)"
+        );
+    }
+
+    // Attempt to map scene file from it
+    const MappedFile file(scenePath);
+
+    if (!file.IsOpen()) {
+        throw std::runtime_error("Unable to open scene file");
+    }
+
+    const std::string_view contents = file.View();
+
+    // Validate its header and layout before trusting any offset
+    if (contents.size() < sizeof(SceneHeader)) {
+        throw std::runtime_error("Malformed scene file (truncated header)");
+    }
+
+    const SceneHeader header = RecordAt<SceneHeader>(contents, 0);
+
+    if (header.magic != SceneMagic) {
+        throw std::runtime_error("Not a scene file");
+    }
+
+    if (header.version != SceneVersion) {
+        throw std::runtime_error("Unsupported scene version (bake it again)");
+    }
+
+    if (header.byteOrder != SceneByteOrder) {
+        throw std::runtime_error("Scene baked with a different byte order");
+    }
+
+    const SceneLayout layout = LayoutOf(header);
+
+    if (layout.end > contents.size()) {
+        throw std::runtime_error("Malformed scene file (truncated sections)");
+    }
+
+    // Views onto every string, straight off the mapped contents
+    const std::string_view stringBytes = contents.substr(layout.bytes, header.stringBytes);
+    std::vector<std::string_view> strings(header.stringCount);
+
+    for (std::uint32_t which = 0; which < header.stringCount; ++which) {
+        const SceneString string = RecordAt<SceneString>(
+            contents, layout.strings + which * sizeof(SceneString));
+
+        // (Terminators included, so they may be used as C-strings)
+        if (
+            string.offset >= stringBytes.size() ||
+            string.length >= stringBytes.size() - string.offset ||
+            stringBytes[string.offset + string.length] != '\0'
+        ) {
+            throw std::runtime_error("Malformed scene file (string out of bounds)");
+        }
+
+        strings[which] = stringBytes.substr(string.offset, string.length);
+    }
+
+    const auto stringAt = [&] (std::uint32_t index) {
+        if (index >= strings.size()) {
+            throw std::runtime_error("Malformed scene file (string index out of bounds)");
+        }
+
+        return strings[index];
+    };
+
+    // Build the services it holds
+    WindowService window = BuildWindow(WindowConfig{
+        static_cast<int>(header.windowWidth),
+        static_cast<int>(header.windowHeight),
+        header.windowColor[0], header.windowColor[1], header.windowColor[2],
+        header.windowVSync != 0
+    }, headless);
+
+    BuildFont(window, assets, FontConfig{
+        stringAt(header.fontPath),
+        header.fontColor[0], header.fontColor[1], header.fontColor[2],
+        static_cast<int>(header.fontSize)
+    });
+
+    // Then its images, which get loaded once each (paths were validated
+    // when baking)
+    std::vector<std::string_view> imagePaths(header.imageCount);
+    std::vector<CachedImage> images(header.imageCount, CachedImage{true});
+
+    for (std::uint32_t which = 0; which < header.imageCount; ++which) {
+        imagePaths[which] = stringAt(RecordAt<std::uint32_t>(
+            contents, layout.images + which * sizeof(std::uint32_t)));
+    }
+
+    // And finally its entities, all added at once
+    EntityBatch batch;
+    batch.physics.reserve(header.entityCount);
+    batch.drawings.reserve(header.entityCount);
+
+    for (std::uint32_t which = 0; which < header.entityCount; ++which) {
+        const SceneEntity record = RecordAt<SceneEntity>(
+            contents, layout.entities + which * sizeof(SceneEntity));
+
+        if (record.image >= header.imageCount) {
+            throw std::runtime_error("Malformed scene file (image index out of bounds)");
+        }
+
+        const EntityConfig entity{
+            .label = stringAt(record.label),
+            .image = imagePaths[record.image],
+            .width = static_cast<int>(record.size[0]),
+            .height = static_cast<int>(record.size[1]),
+            .x = record.position[0],
+            .y = record.position[1],
+            .vx = record.velocity[0],
+            .vy = record.velocity[1],
+            .angle = record.angle,
+            .line = record.line
+        };
+
+        CachedImage& image = images[record.image];
+
+        if (!ResolveImage(window, assets, entity.image.data(), image)) {
+            std::cerr << "Unable to load entity image\n" <<
+                "Unable to load entity at line " << entity.line <<
+                std::endl;
+            continue;
+        }
+
+        BatchEntity(assets, entity, image.asset, batch);
+    }
+
+    SpawnBatch(ecs, batch);
+
+    // All is done
+    return window;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+// Core game definitions
+#include "Game/Core.hpp"
+
+// Fixed-width records
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+/// @brief Magic bytes opening every baked scene
+inline constexpr std::array<char, 4> SceneMagic{'S', 'C', 'N', 'E'};
+
+/// @brief Version of the baked scene layout (bumped on every change)
+inline constexpr std::uint32_t SceneVersion = 1;
+
+/// @brief Marker telling apart the byte order of the baking machine
+inline constexpr std::uint32_t SceneByteOrder = 0x01020304;
+
+/// @brief Fixed-size header opening a baked scene
+/// @remark Its sections follow in order, each aligned to 8 bytes: string
+/// entries, image entries, entity records, then string bytes. Strings are
+/// stored once each (null-terminated), and referred to by index
+struct SceneHeader {
+    /// @brief Magic bytes (SceneMagic)
+    std::array<char, 4> magic;
+    /// @brief Layout version (SceneVersion)
+    std::uint32_t version;
+    /// @brief Byte order marker (SceneByteOrder, as written)
+    std::uint32_t byteOrder;
+
+    /// @brief Dimensions of the window
+    std::uint32_t windowWidth, windowHeight;
+    /// @brief Background color hues of the window
+    std::array<std::uint8_t, 3> windowColor;
+    /// @brief Whether presenting waits for vertical sync
+    std::uint8_t windowVSync;
+
+    /// @brief String index of the font's path
+    std::uint32_t fontPath;
+    /// @brief Text color hues of the font
+    std::array<std::uint8_t, 3> fontColor;
+    /// @brief Unused (keeps the following field aligned)
+    std::uint8_t padding;
+    /// @brief Size of the font
+    std::uint32_t fontSize;
+
+    /// @brief Amount of string entries
+    std::uint32_t stringCount;
+    /// @brief Amount of image entries
+    std::uint32_t imageCount;
+    /// @brief Amount of entity records
+    std::uint32_t entityCount;
+    /// @brief Amount of string bytes (terminators included)
+    std::uint32_t stringBytes;
+};
+
+/// @brief Location of a string within the string bytes of a scene
+struct SceneString {
+    /// @brief Offset of its first byte
+    std::uint32_t offset;
+    /// @brief Amount of bytes (terminator excluded)
+    std::uint32_t length;
+};
+
+/// @brief Packed components of an entity within a scene
+struct SceneEntity {
+    /// @brief Initial velocity vector
+    std::array<std::int32_t, 2> velocity;
+    /// @brief Initial position coordinates
+    std::array<std::int32_t, 2> position;
+    /// @brief Dimensions of the image (and colliding box)
+    std::array<std::uint32_t, 2> size;
+    /// @brief Angle of orientation (degrees)
+    double angle;
+    /// @brief Image index of the entity's image
+    std::uint32_t image;
+    /// @brief String index of the entity's display text
+    std::uint32_t label;
+    /// @brief Line of the configuration it was baked from
+    std::uint32_t line;
+    /// @brief Unused (keeps records 8-byte aligned)
+    std::uint32_t padding;
+};
+
+static_assert(
+    std::is_trivially_copyable_v<SceneHeader> &&
+    std::is_trivially_copyable_v<SceneString> &&
+    std::is_trivially_copyable_v<SceneEntity>,
+    "Scene records must be trivially copyable"
+);
+
+static_assert(
+    sizeof(SceneHeader) == 52 && sizeof(SceneString) == 8 &&
+    sizeof(SceneEntity) == 48,
+    "Scene records must be tightly packed"
+);
+
+/// @brief Bake a configuration into a binary scene, for loading it without
+/// any text parsing
+/// @param configPath Path to the configuration file
+/// @param scenePath Path to write the scene onto
+/// @remark Entities which fail to parse or refer to missing images get
+/// left out (and reported), just like when parsing the configuration
+void BakeScene(const char* configPath, const char* scenePath);
+
+/// @brief Load a baked scene, adding all of its entities at once
+/// @param scenePath Path to the scene file
+/// @param assets Asset store used to load textures
+/// @param ecs ECS used to add entities
+/// @param headless Whether to skip window and texture creation (entities
+/// still get simulated within the window's size)
+/// @return Window used to render textures
+WindowService LoadScene(
+    const char* scenePath,
+    AssetStore& assets,
+    GameECS& ecs,
+    bool headless = false
+);
@@ -1,32 +1,85 @@
 // Definitions
 #include "Game/ServiceActions.hpp"
 
+// Easy I/O
+#include <iostream>
+
 // SDL utilities
 #include <SDL_events.h>
 
+// Timing formatting
+#include <cstdio>
+
+// Configuration reloading
+#include "Game/Parsing.hpp"
+
+void LatchInput(InputService& input) {
+    input.Latch();
+}
+
 void HandleInput(GameECS::ManagerService& ecsManager, 
-    StopwatchService& stopwatch) {
+    StopwatchService& stopwatch, WindowService& window,
+    const InputService& input) {
     bool exitGame = false;
 
-    // Check for input events
-    for (SDL_Event currentEvent; 
-        SDL_PollEvent(&currentEvent) == 1;) {
-        switch (currentEvent.type)
+    // Pixels the camera pans per key press (or repeat)
+    constexpr double cameraStep = 32.0;
+    glm::dvec2 camera = window.View().origin;
+
+    // Check for input events (pumped by the rendering thread, since
+    // only the thread owning the window may do so, and latched already)
+    for (const InputEvent& currentEvent : input.Events()) {
+        switch (currentEvent.kind)
         {
             // If exiting, stop the ECS
-            case SDL_QUIT:
+            case InputEvent::Quit:
                 exitGame = true;
                 break;
 
+            // Pan the camera while arrow keys are held down
+            case InputEvent::KeyDown:
+                switch (currentEvent.key)
+                {
+                    case SDLK_LEFT:
+                        camera.x -= cameraStep;
+                        break;
+
+                    case SDLK_RIGHT:
+                        camera.x += cameraStep;
+                        break;
+
+                    case SDLK_UP:
+                        camera.y -= cameraStep;
+                        break;
+
+                    case SDLK_DOWN:
+                        camera.y += cameraStep;
+                        break;
+
+                    // Or bring it back to the origin on Home
+                    case SDLK_HOME:
+                        camera = {0, 0};
+                        break;
+
+                    default:
+                        break;
+                }
+                break;
+
             // Check if a key was pressed (indirectly by its release)
-            case SDL_KEYUP:
-                switch (currentEvent.key.keysym.sym)
+            case InputEvent::KeyUp:
+                switch (currentEvent.key)
                 {
                     // If P is released, toggle the simulation delta
                     case SDLK_p:
                         stopwatch.Toggle();
                         break;
 
+                    // If F3 is released, toggle the profiling overlay
+                    case SDLK_F3:
+                        ecsManager.SetProfiling(!ecsManager.Profiling());
+                        break;
+
                     // If ESC is released, stop the ECS
                     case SDLK_ESCAPE:
                         exitGame = true;
@@ -42,6 +95,9 @@ void HandleInput(GameECS::ManagerService& ecsManager,
         }
     }
 
+    // Show wherever the camera ended up
+    window.MoveCamera(camera);
+
     // Request the ECS manager to stop running 
     // the systems and services
     if (exitGame) {
@@ -49,6 +105,25 @@ void HandleInput(GameECS::ManagerService& ecsManager,
     }
 }
 
+ActionTask ReloadScene(GameECS::ManagerService& ecsManager, ReloadService& reload,
+    AssetStore& assets, WindowService& window) {
+    // Wait for the config to change, checking once per sweep
+    co_await Until{[&reload] { return reload.Poll(); }};
+
+    // Keep the live entities as they are if it can't be read
+    try {
+        const SceneDiff diff = ReloadConfig(
+            reload.Path().c_str(), assets, window, ecsManager, reload.Entities());
+
+        std::cout << "Reloaded config: " << diff.added << " added, " <<
+            diff.removed << " removed, " << diff.modified <<
+            " components replaced" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Unable to reload config: " <<
+            "\"" << e.what() << "\"" << std::endl;
+    }
+}
+
 void DrawEntities(WindowService& window) {
     // If the last frame was a draw frame, commit the drawings
     if (window.OnDrawFrame()) {
@@ -59,9 +134,64 @@ void DrawEntities(WindowService& window) {
     window.AcquireDrawFrame();
 }
 
-void ResetDeltaTimer(StopwatchService& stopwatch) {
-    // Reset the physics timer after 1000 ticks
-    if (stopwatch.Milliseconds() >= 1000) {
-        stopwatch.Reset();
+void DrawProfile(GameECS::ManagerService& ecsManager, 
+    WindowService& window, const AssetStore& assets) {
+    // Only draw timings if there are any, and on draw frames
+    if (!ecsManager.Profiling() || !window.OnDrawFrame()) {
+        return;
+    }
+
+    // Draw a line per profiled scope, top to bottom
+    const GlyphCache& glyphs = assets.GetGlyphs();
+    SDL_Point origin{8, 8};
+
+    for (const ProfileEntry& entry : ecsManager.Profile()) {
+        char line[96];
+        std::snprintf(line, sizeof(line), 
+            "%-20.20s %6.2f ms  p50 %6.2f  p99 %6.2f  %zu",
+            entry.name.c_str(), entry.last, entry.p50, entry.p99, entry.entities
+        );
+
+        window.PushText(glyphs, line, origin);
+        origin.y += glyphs.Height();
     }
+
+    // Followed by how much texture memory is resident
+    const AssetStore::Residency residency = assets.Stats();
+    char line[96];
+    std::snprintf(line, sizeof(line),
+        "%-20.20s %6.1f MiB / %.0f  %zu tex  %zu evicted",
+        "Textures", residency.bytes / 1048576.0, residency.budget / 1048576.0,
+        residency.textures, residency.evictions
+    );
+
+    window.PushText(glyphs, line, origin);
+}
+
+void ResolveAssets(AssetStore& assets, const WindowService& window) {
+    // Swap placeholders for whatever got uploaded since the last sweep (and
+    // evicted ones back, acknowledging as of the latest committed frame)
+    assets.ResolveUploaded(window);
+}
+
+void AdvanceSimulation(StopwatchService& stopwatch) {
+    // Simulate as many fixed ticks as real time allows
+    stopwatch.Advance();
+}
+
+void StepSimulation(StopwatchService& stopwatch) {
+    // One tick per sweep, so runs are deterministic
+    stopwatch.AdvanceTicks(1);
+}
+
+void AwaitJobs(JobService& jobs) {
+    // Jobs submitted on the previous sweep must be done before
+    // the next one moves on
+    jobs.AwaitFrame();
+}
+
+void DetectCollisions(BroadphaseService& broadphase, const JobService& jobs) {
+    // Test the colliders recorded on the previous sweep (in parallel),
+    // so systems may respond to them on this one
+    broadphase.Detect(jobs);
 }
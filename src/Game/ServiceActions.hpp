@@ -3,17 +3,63 @@
 // Core game definitions
 #include "Game/Core.hpp"
 
+/// @brief Take the input events handed over since the previous sweep
+/// @param input Input service to latch
+void LatchInput(InputService& input);
+
 /// @brief Handle the input on a given frame
 /// @param ecsManager ECS currently taking place
 /// @param stopwatch Physics timekeeping service
+/// @param window Window service whose camera gets panned
+/// @param input Input service holding this sweep's events
 void HandleInput(GameECS::ManagerService& ecsManager, 
-    StopwatchService& stopwatch);
+    StopwatchService& stopwatch, WindowService& window,
+    const InputService& input);
+
+/// @brief Bring the entities up to date with their configuration, once it
+/// changes (suspended across sweeps until then)
+/// @param ecsManager ECS currently taking place
+/// @param reload Reload service watching the configuration
+/// @param assets Asset store to load new images into
+/// @param window Window service to draw new images with
+ActionTask ReloadScene(GameECS::ManagerService& ecsManager, ReloadService& reload,
+    AssetStore& assets, WindowService& window);
 
 /// @brief Render the entities drawn on the current frame 
 /// @param window Window service to draw entities from
 void DrawEntities(WindowService& window);
 
-/// @brief Reset the physics timer after a fixed
-/// timestep
-/// @param stopwatch 
-void ResetDeltaTimer(StopwatchService& stopwatch);
+/// @brief Draw the latest timings of the ECS over the entities, if
+/// being profiled
+/// @param ecsManager ECS currently taking place
+/// @param window Window service to draw the timings with
+/// @param assets Asset store to lay the timings out with
+void DrawProfile(GameECS::ManagerService& ecsManager, 
+    WindowService& window, const AssetStore& assets);
+
+/// @brief Make assets uploaded since the previous sweep drawable (before
+/// anything gets drawn on this one), and evicted ones no longer so
+/// @param assets Asset store loading them
+/// @param window Window service drawing them
+void ResolveAssets(AssetStore& assets, const WindowService& window);
+
+/// @brief Bank the time elapsed since the previous sweep, and
+/// turn it into fixed simulation ticks for this one
+/// @param stopwatch Physics timekeeping service
+void AdvanceSimulation(StopwatchService& stopwatch);
+
+/// @brief Simulate a single tick per sweep regardless of real time,
+/// for headless runs as fast as the CPU allows
+/// @param stopwatch Physics timekeeping service
+void StepSimulation(StopwatchService& stopwatch);
+
+/// @brief Detect collisions between entities recorded on the previous
+/// frame
+/// @param broadphase Collision detection service
+/// @param jobs Job service to spread detection with
+void DetectCollisions(BroadphaseService& broadphase, const JobService& jobs);
+
+/// @brief Wait for every job submitted during the previous frame
+/// (frame barrier)
+/// @param jobs Job service to wait on
+void AwaitJobs(JobService& jobs);
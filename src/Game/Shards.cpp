@@ -0,0 +1,112 @@
+// Strip math
+#include <algorithm>
+#include <cmath>
+
+// Definitions
+#include "Game/Shards.hpp"
+
+ShardBoundaries::ShardBoundaries(double width, std::size_t shards, double margin) :
+    _stripWidth(width / std::max<std::size_t>(1, shards)),
+    _margin(margin),
+    _ghosts(shards),
+    _outgoing(shards)
+{}
+
+std::size_t ShardBoundaries::ShardOf(double x) const {
+    // (Bodies bounce within the window, but clamp anyway)
+    const double strip = std::floor(x / _stripWidth);
+    return static_cast<std::size_t>(std::clamp(
+        strip, 0.0, static_cast<double>(_outgoing.size() - 1)
+    ));
+}
+
+void ShardBoundaries::Deliver(GameShards& shards, bool ghosts) {
+    for (std::size_t which = 0; which < shards.Size(); ++which) {
+        if (_outgoing[which].empty()) {
+            continue;
+        }
+
+        GameECS& shard = shards[which];
+        _unpacked.clear();
+        shard.UnpackEntities(_outgoing[which], _unpacked);
+        _outgoing[which].clear();
+
+        if (!ghosts) {
+            continue;
+        }
+
+        // Ghosts never move on their own
+        for (const GameECS::EntityID ghost : _unpacked) {
+            shard.SleepComponent<Physics>(ghost);
+        }
+
+        _ghosts[which].insert(_ghosts[which].end(), _unpacked.begin(), _unpacked.end());
+    }
+}
+
+void ShardBoundaries::Exchange(GameShards& shards) {
+    // Drop the ghosts copied on the previous exchange
+    for (std::size_t which = 0; which < shards.Size(); ++which) {
+        for (const GameECS::EntityID ghost : _ghosts[which]) {
+            shards[which].RemoveEntity(ghost);
+        }
+
+        _ghosts[which].clear();
+    }
+
+    // Hand over every entity lying on another shard's strip
+    for (std::size_t which = 0; which < shards.Size(); ++which) {
+        GameECS& shard = shards[which];
+        _leaving.clear();
+
+        shard.ForEachComponent<Physics>(
+            [&] (GameECS::EntityID entity, const Physics& physics) {
+                const std::size_t owner = ShardOf(physics.position.x);
+                if (owner != which) {
+                    shard.PackEntity(entity, _outgoing[owner]);
+                    _leaving.push_back(entity);
+                }
+            }
+        );
+
+        for (const GameECS::EntityID entity : _leaving) {
+            shard.RemoveEntity(entity);
+        }
+
+        _migrated += _leaving.size();
+    }
+
+    Deliver(shards, false);
+
+    // Then copy those near an edge onto the neighbouring shard
+    for (std::size_t which = 0; which < shards.Size(); ++which) {
+        const GameECS& shard = shards[which];
+        const double left = _stripWidth * which, right = left + _stripWidth;
+
+        shard.ForEachComponent<Physics>(
+            [&] (GameECS::EntityID entity, const Physics& physics) {
+                if (which > 0 && physics.position.x < left + _margin) {
+                    shard.PackEntity(entity, _outgoing[which - 1]);
+                }
+
+                if (which + 1 < shards.Size() && physics.position.x > right - _margin) {
+                    shard.PackEntity(entity, _outgoing[which + 1]);
+                }
+            }
+        );
+    }
+
+    Deliver(shards, true);
+}
+
+std::size_t ShardBoundaries::Migrated() const
+{ return _migrated; }
+
+std::size_t ShardBoundaries::Ghosts() const {
+    std::size_t ghosts = 0;
+    for (const std::vector<GameECS::EntityID>& shard : _ghosts) {
+        ghosts += shard.size();
+    }
+
+    return ghosts;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// Core game definitions
+#include "Game/Core.hpp"
+
+// Lockstep shards
+#include "ECS/ECS_Shards.hpp"
+
+// Handoff buffers
+#include <cstddef>
+#include <vector>
+
+/// @brief Shards of the game's world, swept in lockstep
+using GameShards = ShardGroup<GameECS>;
+
+/// @brief Partition of the window into vertical strips, one per shard,
+/// handing entities over as they cross from one strip onto another
+/// @remark Entities within a margin of a strip's edge also get a ghost
+/// copy on the neighbouring shard, asleep so physics never integrates it
+/// there but still collided against. Ghosts are dropped and copied anew on
+/// every exchange, so whatever happens to them is discarded
+class ShardBoundaries {
+    private:
+        /// @brief Width of every strip
+        double _stripWidth;
+
+        /// @brief Distance from edges within which entities get ghosts
+        double _margin;
+
+        /// @brief Ghost copies living on each shard
+        std::vector<std::vector<GameECS::EntityID>> _ghosts;
+
+        /// @brief Entities packed for each shard, pending to unpack
+        std::vector<std::vector<std::byte>> _outgoing;
+
+        /// @brief Entities leaving the shard being scanned
+        std::vector<GameECS::EntityID> _leaving;
+
+        /// @brief Entities unpacked onto the shard being filled
+        std::vector<GameECS::EntityID> _unpacked;
+
+        /// @brief Entities handed over so far
+        std::size_t _migrated = 0;
+
+        /// @brief Unpack every entity packed for each shard
+        /// @param shards Shards to unpack onto
+        /// @param ghosts Whether to keep them as ghosts (or for good)
+        void Deliver(GameShards& shards, bool ghosts);
+
+    public:
+        /// @brief Construct a partition of the window into strips
+        /// @param width Width of the window
+        /// @param shards Amount of strips (one per shard)
+        /// @param margin Distance from edges within which entities get
+        /// ghosts (ideally the extent of the largest collider)
+        ShardBoundaries(double width, std::size_t shards, double margin);
+
+        /// @brief Shard owning a given horizontal position
+        /// @param x Horizontal position (clamped onto the window)
+        std::size_t ShardOf(double x) const;
+
+        /// @brief Hand entities over onto the shards owning them, and copy
+        /// ghosts anew for those near edges
+        /// @param shards Shards to exchange between (idle, between steps)
+        void Exchange(GameShards& shards);
+
+        /// @brief Entities handed over from one shard onto another so far
+        std::size_t Migrated() const;
+
+        /// @brief Ghost copies living across every shard
+        std::size_t Ghosts() const;
+};
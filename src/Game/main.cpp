@@ -7,19 +7,215 @@
 // Input config parsing
 #include "Game/Parsing.hpp"
 
+// Baked scene loading
+#include "Game/Scene.hpp"
+
+// Sharded simulation
+#include "Game/Shards.hpp"
+
 // Easy I/O
 #include <iostream>
+#include <fstream>
+#include <iomanip>
 
 // Filesystem navigation
 #include <filesystem>
 
+// Command line options
+#include <cstring>
+#include <string>
+#include <optional>
+
+// Headless run timing
+#include <chrono>
+
+// Core count
+#include <thread>
+#include <algorithm>
+
+// Collider extents
+#include <cmath>
+
 // SDL bootstrapping & cleanup
 #include <SDL.h>
 #include <SDL_ttf.h>
 
+/// @brief Options provided through the command line
+struct Options {
+    /// @brief C-string path to config file on disk
+    const char* configFilepath = nullptr;
+    /// @brief Whether to simulate without window nor textures
+    bool headless = false;
+    /// @brief Ticks to simulate when headless
+    unsigned long long ticks = 0;
+    /// @brief Shards to partition the world into when headless
+    unsigned shards = 1;
+    /// @brief Whether to profile the ECS from the start
+    bool profile = false;
+    /// @brief C-string path to write a trace of the ECS onto (if any)
+    const char* tracePath = nullptr;
+    /// @brief C-string path to bake the config onto as a scene (if any)
+    const char* bakePath = nullptr;
+    /// @brief Whether to reload the config whenever it changes
+    bool watch = false;
+    /// @brief Texture memory to keep resident at most, in MiB (0 if unbounded)
+    std::size_t textureBudget = 0;
+    /// @brief Whether to draw through instanced OpenGL draw calls
+    bool instanced = false;
+};
+
+/// @brief Print the latest timings of an ECS
+/// @param ecs ECS to print the timings of
+void PrintProfile(const GameECS& ecs) {
+    std::cout 
+        << std::left << std::setw(24) << "Scope" << std::right
+        << std::setw(10) << "Last (ms)" << std::setw(10) << "p50"
+        << std::setw(10) << "p99" << std::setw(10) << "Entities" 
+        << std::endl << std::fixed << std::setprecision(3);
+
+    for (const ProfileEntry& entry : ecs.Profile()) {
+        std::cout 
+            << std::left << std::setw(24) << entry.name << std::right
+            << std::setw(10) << entry.last << std::setw(10) << entry.p50
+            << std::setw(10) << entry.p99 << std::setw(10) << entry.entities
+            << std::endl;
+    }
+
+    std::cout << std::defaultfloat;
+}
+
+/// @brief Print how much texture memory an asset store kept resident
+/// @param assets Asset store to print the residency of
+void PrintResidency(const AssetStore& assets) {
+    const AssetStore::Residency residency = assets.Stats();
+    std::cout
+        << "Textures: " << residency.textures << " resident ("
+        << residency.bytes / 1048576.0 << " MiB, budget "
+        << residency.budget / 1048576.0 << " MiB), "
+        << residency.evictions << " evicted, " << residency.reloads
+        << " reloaded, " << residency.hits << " hits, "
+        << residency.misses << " misses" << std::endl;
+}
+
+/// @brief Simulate the world partitioned into shards, each swept on its
+/// own thread in lockstep (headless only)
+/// @param options Options provided through the command line
+void RunSharded(const Options& options) {
+    std::cout << "Initializing " << options.shards << " ECS shards..." << std::endl;
+    GameShards shards(options.shards);
+
+    // Every entity gets loaded onto the first shard, then handed over onto
+    // the one owning it on the first exchange
+    std::cout << "Loading config, window & entities..." << std::endl;
+    AssetStore assetStore;
+    const bool baked = 
+        std::filesystem::path(options.configFilepath).extension() == ".scene";
+
+    WindowService windowService = baked ?
+        LoadScene(options.configFilepath, assetStore, shards[0], true) :
+        ParseConfig(options.configFilepath, assetStore, shards[0], true);
+
+    const glm::uvec2 size = windowService.Size();
+
+    // Ghosts get copied within the largest collider's diagonal of edges
+    double margin = 0;
+    shards[0].ForEachComponent<Physics>(
+        [&margin] (GameECS::EntityID, const Physics& physics) {
+            margin = std::max(margin, std::hypot(physics.size.x, physics.size.y));
+        }
+    );
+
+    ShardBoundaries boundaries(size.x, shards.Size(), margin);
+
+    // Split the cores between shards, then install each one's services
+    // (only the first gets the font, headless shards draw nothing anyway)
+    std::cout << "Installing services..." << std::endl;
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned workers = std::max(1u, cores / options.shards) - 1;
+
+    for (std::size_t which = 0; which < shards.Size(); ++which) {
+        GameECS& ecs = shards[which];
+        ecs.SetWorkerThreads(workers);
+
+        if (which == 0) {
+            ecs.InstallService(std::move(assetStore));
+            ecs.InstallService(std::move(windowService));
+        } else {
+            ecs.InstallService(AssetStore());
+            ecs.InstallService(WindowService(size));
+        }
+
+        ecs.InstallService(StopwatchService());
+        ecs.InstallService(JobService(workers));
+        ecs.InstallService(BroadphaseService());
+
+        ecs.NameSystem(0, "PhysicsSystem");
+        ecs.NameSystem(1, "CollisionSystem");
+        ecs.NameSystem(2, "DrawingSystem");
+
+        ecs.NameServiceAction(ecs.AddServiceAction(StepSimulation), "StepSimulation");
+        ecs.NameServiceAction(ecs.AddServiceAction(AwaitJobs), "AwaitJobs");
+        ecs.NameServiceAction(ecs.AddServiceAction(DetectCollisions), "DetectCollisions");
+
+        // (Traces only cover the first shard)
+        if (which == 0 && options.tracePath != nullptr) {
+            ecs.StartTrace();
+        } else if (options.profile) {
+            ecs.SetProfiling(true);
+        }
+    }
+
+    // Sweep every shard in lockstep until done, exchanging entities
+    // across boundaries after every step
+    std::cout << "Simulating " << options.ticks << " ticks..." << std::endl;
+    const StopwatchService& ticker = shards[0].GetService<StopwatchService>();
+    const auto start = std::chrono::steady_clock::now();
+
+    shards.Run([&] (GameShards& group) {
+        boundaries.Exchange(group);
+        return ticker.TotalTicks() < options.ticks;
+    });
+
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout 
+        << "Simulated " << ticker.TotalTicks() << " ticks in " 
+        << seconds << "s (" << ticker.TotalTicks() / seconds 
+        << " ticks per second), handing " << boundaries.Migrated()
+        << " entities over (" << boundaries.Ghosts() << " ghosts left)"
+        << std::endl;
+
+    for (std::size_t which = 0; which < shards.Size(); ++which) {
+        std::cout << "Shard " << which << ": " << shards[which].EntityCount()
+            << " entities" << std::endl;
+
+        if (options.profile) {
+            PrintProfile(shards[which]);
+        }
+    }
+
+    // And write the trace down, if any
+    if (options.tracePath != nullptr) {
+        std::ofstream trace(options.tracePath);
+        shards[0].WriteTrace(trace);
+
+        if (!trace) {
+            std::cerr << "Unable to write trace onto \"" 
+                << options.tracePath << "\"" << std::endl;
+        }
+    }
+}
+
 /// @brief Create game's resources and ECS given some config file
-/// @param configFilepath C-string path to config file on disk 
-void RunGame(const char* configFilepath) {
+/// @param options Options provided through the command line
+void RunGame(const Options& options) {
+    // Partitioned worlds run on their own
+    if (options.shards > 1) {
+        RunSharded(options);
+        return;
+    }
+
     // Create ECS
     std::cout << "Initializing ECS..." << std::endl;
     GameECS ecs;
@@ -27,40 +223,164 @@ void RunGame(const char* configFilepath) {
     // Create outside services
     std::cout << "Initializing services..." << std::endl;
 
-    // Asset store
+    // Asset store (within budget, if given one)
     AssetStore assetStore;
+    assetStore.SetBudget(options.textureBudget << 20);
 
-    // Window (also adds entities)
+    // Window (also adds entities), off a baked scene if given one
     std::cout << "Loading config, window & entities..." << std::endl;
-    WindowService windowService = std::move(
-        ParseConfig(configFilepath, assetStore, ecs)
-    );
+    const bool baked = 
+        std::filesystem::path(options.configFilepath).extension() == ".scene";
+
+    // (Watching the config from before reading it, so no edit goes unseen)
+    std::optional<ReloadService> reload;
+    if (options.watch) {
+        reload.emplace(options.configFilepath);
+    }
+
+    // (Instancing draws within SDL's OpenGL renderer, so prefer it)
+    if (options.instanced) {
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "opengl");
+    }
 
-    // Add systems
-    std::cout << "Adding systems..." << std::endl;
-    ecs.AddSystem(PhysicsSystem);
-    ecs.AddSystem(DrawingSystem);
+    WindowService windowService = baked ?
+        LoadScene(options.configFilepath, assetStore, ecs, options.headless) :
+        ParseConfig(options.configFilepath, assetStore, ecs, options.headless,
+            reload ? &reload->Entities() : nullptr);
+
+    // Draw through instancing, if requested (and able to)
+    if (options.instanced) {
+        windowService.UseInstancing();
+        std::cout << "Drawing through " << windowService.Backend() << std::endl;
+    }
+
+    // Systems are listed at compile time on GameECS, and spread across
+    // the available cores whenever their accesses allow it
+    ecs.SetWorkerThreads(std::max(1u, std::thread::hardware_concurrency()) - 1);
+
+    // Sleep between sweeps, once per simulation tick, instead of
+    // keeping a core busy (unless headless, which sweeps non-stop)
+    StopwatchService stopwatch;
+    if (!options.headless) {
+        ecs.SetLoopPolicy(LoopPolicy::Sleep, 1.0 / stopwatch.Step());
+    }
 
     // Install services
     std::cout << "Installing services..." << std::endl;
     ecs.InstallService(std::move(assetStore));
     ecs.InstallService(std::move(windowService));
-    ecs.InstallService(StopwatchService());
+    ecs.InstallService(std::move(stopwatch));
+    ecs.InstallService(
+        JobService(std::max(1u, std::thread::hardware_concurrency()) - 1)
+    );
+    ecs.InstallService(BroadphaseService());
+
+    // Hand input over from the window's thread (headless runs have none)
+    if (!options.headless) {
+        ecs.InstallService(InputService());
+    }
+
+    // Reload the config whenever it changes, if watched
+    if (reload) {
+        ecs.InstallService(std::move(*reload));
+    }
+
+    // Name systems for profiling (the ones listed on GameECS come first)
+    ecs.NameSystem(0, "PhysicsSystem");
+    ecs.NameSystem(1, "CollisionSystem");
+    ecs.NameSystem(2, "DrawingSystem");
+
+    // Profile from the start, if requested
+    if (options.tracePath != nullptr) {
+        ecs.StartTrace();
+    } else if (options.profile) {
+        ecs.SetProfiling(true);
+    }
 
     // Add actions
     std::cout << "Adding service actions..." << std::endl;
-    ecs.AddServiceAction(HandleInput);
-    ecs.AddServiceAction(DrawEntities);
-    ecs.AddServiceAction(ResetDeltaTimer);
-
-    // Starting running the ECS thread
-    std::cout << "Starting ECS..." << std::endl;
-    // ecs.Dispatch(); -> Multithreading and SDL might not work together
-    ecs.Run();
-
-    // Wait for it to stop
-    // ecs.AwaitStop(); -> See comment above
-    std::cout << "Quitting ECS..." << std::endl;
+    if (options.headless) {
+        ecs.NameServiceAction(ecs.AddServiceAction(StepSimulation), "StepSimulation");
+        ecs.NameServiceAction(ecs.AddServiceAction(AwaitJobs), "AwaitJobs");
+        ecs.NameServiceAction(ecs.AddServiceAction(DetectCollisions), "DetectCollisions");
+
+        // Sweep right on this thread, as fast as possible, until done
+        std::cout << "Simulating " << options.ticks << " ticks..." << std::endl;
+        const StopwatchService& ticker = ecs.GetService<StopwatchService>();
+        const auto start = std::chrono::steady_clock::now();
+
+        while (ticker.TotalTicks() < options.ticks) {
+            ecs.Sweep();
+        }
+
+        const double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+        std::cout 
+            << "Simulated " << ticker.TotalTicks() << " ticks in " 
+            << seconds << "s (" << ticker.TotalTicks() / seconds 
+            << " ticks per second, " << ticker.TotalTicks() * ticker.Step() 
+            << "s simulated)" << std::endl;
+    } else {
+        ecs.NameServiceAction(ecs.AddServiceAction(LatchInput), "LatchInput");
+        ecs.NameServiceAction(ecs.AddServiceAction(HandleInput), "HandleInput");
+        if (options.watch) {
+            ecs.NameServiceAction(ecs.AddServiceAction(ReloadScene), "ReloadScene");
+        }
+
+        ecs.NameServiceAction(ecs.AddServiceAction(ResolveAssets), "ResolveAssets");
+        ecs.NameServiceAction(ecs.AddServiceAction(DrawEntities), "DrawEntities");
+        ecs.NameServiceAction(ecs.AddServiceAction(DrawProfile), "DrawProfile");
+        ecs.NameServiceAction(ecs.AddServiceAction(AdvanceSimulation), "AdvanceSimulation");
+        ecs.NameServiceAction(ecs.AddServiceAction(AwaitJobs), "AwaitJobs");
+        ecs.NameServiceAction(ecs.AddServiceAction(DetectCollisions), "DetectCollisions");
+
+        // Starting running the ECS thread
+        std::cout << "Starting ECS..." << std::endl;
+        ecs.Dispatch();
+
+        // Meanwhile, own the renderer on this thread: pump window events
+        // (handing them over to the simulation), upload assets decoded so
+        // far (a budget's worth per frame) and present whatever the
+        // simulation committed last
+        WindowService& window = ecs.GetService<WindowService>();
+        AssetStore& assets = ecs.GetService<AssetStore>();
+        InputService& input = ecs.GetService<InputService>();
+        while (ecs.Running()) {
+            input.Pump();
+            assets.UploadDecoded(window);
+
+            // Don't spin while waiting for the next committed frame (vertical
+            // sync, if on, already blocks on presenting)
+            if (!window.Present()) {
+                SDL_Delay(1);
+            }
+        }
+
+        // Wait for it to stop
+        ecs.AwaitStop();
+        std::cout << "Quitting ECS..." << std::endl;
+    }
+
+    // Report the latest timings (and texture residency, if windowed), if
+    // profiled
+    if (options.profile) {
+        PrintProfile(ecs);
+        if (!options.headless) {
+            PrintResidency(ecs.GetService<AssetStore>());
+        }
+    }
+
+    // And write the trace down, if any
+    if (options.tracePath != nullptr) {
+        std::ofstream trace(options.tracePath);
+        ecs.WriteTrace(trace);
+
+        if (!trace) {
+            std::cerr << "Unable to write trace onto \"" 
+                << options.tracePath << "\"" << std::endl;
+        }
+    }
 }
 
 /// @brief Initialize game resources and cleanup afterwards
@@ -68,31 +388,109 @@ void RunGame(const char* configFilepath) {
 /// @param args Vector of c-string CLI arguments
 /// @return 0 on success, negative status code on error
 int main(int argc, char* args[]) {
+    // Collect the options provided
+    Options options;
+    bool validOptions = argc >= 2;
+
+    for (int which = 1; validOptions && which < argc; ++which) {
+        if (std::strcmp(args[which], "--headless") == 0) {
+            options.headless = true;
+        } else if (std::strcmp(args[which], "--ticks") == 0 && which + 1 < argc) {
+            try {
+                options.ticks = std::stoull(args[++which]);
+            } catch (const std::exception&) {
+                validOptions = false;
+            }
+        } else if (std::strcmp(args[which], "--shards") == 0 && which + 1 < argc) {
+            try {
+                options.shards = static_cast<unsigned>(std::stoul(args[++which]));
+            } catch (const std::exception&) {
+                validOptions = false;
+            }
+        } else if (std::strcmp(args[which], "--profile") == 0) {
+            options.profile = true;
+        } else if (std::strcmp(args[which], "--trace") == 0 && which + 1 < argc) {
+            options.tracePath = args[++which];
+        } else if (std::strcmp(args[which], "--bake") == 0 && which + 1 < argc) {
+            options.bakePath = args[++which];
+        } else if (std::strcmp(args[which], "--watch") == 0) {
+            options.watch = true;
+        } else if (std::strcmp(args[which], "--instanced") == 0) {
+            options.instanced = true;
+        } else if (std::strcmp(args[which], "--texture-budget") == 0 && which + 1 < argc) {
+            try {
+                options.textureBudget = std::stoull(args[++which]);
+            } catch (const std::exception&) {
+                validOptions = false;
+            }
+        } else if (options.configFilepath == nullptr && args[which][0] != '-') {
+            options.configFilepath = args[which];
+        } else {
+            validOptions = false;
+        }
+    }
+
+    // Headless runs must know when to stop (and only they may be sharded),
+    // while only windowed ones may watch a (non-baked) config, budget
+    // textures or draw through instancing
+    validOptions = validOptions && options.configFilepath != nullptr &&
+        options.headless == (options.ticks > 0) &&
+        options.shards > 0 && (options.headless || options.shards == 1) &&
+        (!options.headless || (options.textureBudget == 0 && !options.instanced)) &&
+        (!options.watch || (!options.headless && options.bakePath == nullptr &&
+            std::filesystem::path(options.configFilepath).extension() != ".scene"));
+
     // Make note of the usage when not provided
-    // the proper amount of args
-    if (argc != 2) {
+    // the proper args
+    if (!validOptions) {
         std::cout 
             << "Usage: " << std::endl 
-            << args[0] << " <config filename path>" << std::endl;
+            << args[0] << " <config filename path> [--watch] [--texture-budget <MiB>] " 
+            << "[--instanced] [--profile] [--trace <path>]" << std::endl
+            << args[0] << " <config filename path> --headless --ticks <N> " 
+            << "[--shards <N>] [--profile] [--trace <path>]" << std::endl
+            << args[0] << " <config filename path> --bake <scene path>" 
+            << std::endl
+            << "(Config files ending in .scene are loaded as baked scenes)" 
+            << std::endl;
 
         return -2;
     }
 
     if (
-        !std::filesystem::exists(args[1]) ||
-        !std::filesystem::path(args[1]).has_filename()
+        !std::filesystem::exists(options.configFilepath) ||
+        !std::filesystem::path(options.configFilepath).has_filename()
     ) {
         std::cerr 
             << "Invalid path for configuration file: "
-            << "\"" << args[1] << "\""
+            << "\"" << options.configFilepath << "\""
             << std::endl;
 
         return -1;
     }
 
-    // Initialize SDL
+    // Baking needs no SDL at all, just the config
+    if (options.bakePath != nullptr) {
+        try {
+            BakeScene(options.configFilepath, options.bakePath);
+        } catch(const std::exception& e) {
+            std::cerr 
+                << "An error ocurred while baking the scene: "
+                << "\"" << e.what() << "\""
+                << std::endl;
+
+            return -1;
+        }
+
+        return 0;
+    }
+
+    // Initialize SDL (without video nor audio if headless)
     std::cout << "Initializing SDL..." << std::endl;
-    if (SDL_Init(SDL_INIT_EVERYTHING) != 0) {
+    const Uint32 subsystems = options.headless ?
+        SDL_INIT_TIMER | SDL_INIT_EVENTS : SDL_INIT_EVERYTHING;
+
+    if (SDL_Init(subsystems) != 0) {
         SDL_Log("SDL_Init error: %s\n", SDL_GetError());
         return -1;
     }
@@ -107,7 +505,7 @@ int main(int argc, char* args[]) {
     // Run game until exited or an error occurs
     std::cout << "Bootstrapping game..." << std::endl;
     try {
-        RunGame(args[1]);
+        RunGame(options);
     } catch(const std::exception& e) {
         std::cerr 
             << "An error ocurred while running the game: "
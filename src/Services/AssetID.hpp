@@ -0,0 +1,15 @@
+#pragma once
+
+// Fixed-width handles
+#include <cstdint>
+
+/// @brief Stable handle to an asset held by the asset store
+/// @remark Kept trivial so components may hold it, value-initialize it
+/// (i.e. AssetID{}) for the null asset
+using AssetID = std::uint32_t;
+
+/// @brief Asset that is never drawn
+inline constexpr AssetID NullAsset = 0;
+
+/// @brief Asset drawn in place of those still loading
+inline constexpr AssetID PlaceholderAsset = 1;
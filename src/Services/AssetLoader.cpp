@@ -0,0 +1,149 @@
+#include "Services/AssetLoader.hpp"
+
+// Image decoding
+#include <SDL_image.h>
+
+// Error reporting
+#include "stdio.h"
+
+// Thread count
+#include <algorithm>
+
+AssetLoader::AssetLoader(unsigned threads) {
+    _workers.reserve(threads);
+    for (unsigned which = 0; which < std::max(1u, threads); ++which) {
+        _workers.emplace_back(
+            [this](std::stop_token stoken) { Work(stoken); }
+        );
+    }
+}
+
+AssetLoader::~AssetLoader() {
+    for (std::jthread& worker : _workers) {
+        worker.request_stop();
+    }
+
+    _workers.clear();
+
+    // Nobody is left to upload these
+    for (Decoded& decoded : _decoded) {
+        SDL_FreeSurface(decoded.surface);
+    }
+}
+
+void AssetLoader::Work(std::stop_token stoken) {
+    while (true) {
+        Job job;
+
+        {
+            std::unique_lock lock(_mutex);
+            if (!_wake.wait(lock, stoken, [&]{ return !_jobs.empty(); })) {
+                return;
+            }
+
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+
+        SDL_Surface* surface = nullptr;
+
+        if (!job.text) {
+            // Decode the image
+            surface = IMG_Load(job.source.c_str());
+
+            if (surface == nullptr) {
+                fprintf(
+                    stderr,
+                    "AssetLoader: DecodeImage couldn't load image at path \"%s\": %s\n",
+                    job.source.c_str(),
+                    IMG_GetError()
+                );
+            }
+        } else {
+            // Or rasterize the text, one at a time
+            std::lock_guard fontLock(_fontMutex);
+
+            if (_font != nullptr) {
+                surface = TTF_RenderText_Solid(_font, job.source.c_str(), _fontColor);
+            }
+
+            if (surface == nullptr) {
+                fprintf(
+                    stderr,
+                    "AssetLoader: RenderText couldn't generate surface for text \"%s\": %s\n",
+                    job.source.c_str(),
+                    _font == nullptr ? "missing font" : TTF_GetError()
+                );
+            }
+        }
+
+        // Failures get handed over too, so their assets stop loading
+        std::lock_guard lock(_mutex);
+        _decoded.push_back(Decoded{job.asset, surface});
+    }
+}
+
+void AssetLoader::Queue(Job job) {
+    {
+        std::lock_guard lock(_mutex);
+        _jobs.push_back(std::move(job));
+    }
+
+    _wake.notify_one();
+}
+
+void AssetLoader::DecodeImage(AssetID asset, std::string path)
+{ Queue(Job{asset, std::move(path), false}); }
+
+void AssetLoader::RenderText(AssetID asset, std::string text)
+{ Queue(Job{asset, std::move(text), true}); }
+
+std::mutex& AssetLoader::FontMutex()
+{ return _fontMutex; }
+
+void AssetLoader::SetFont(TTF_Font* font, SDL_Color color) {
+    _font = font;
+    _fontColor = color;
+}
+
+std::size_t AssetLoader::TakeDecoded(std::size_t byteBudget,
+    std::vector<Decoded>& decoded) {
+    std::lock_guard lock(_mutex);
+
+    std::size_t taken = 0, bytes = 0;
+    while (!_decoded.empty() && (taken == 0 || bytes < byteBudget)) {
+        const Decoded& next = _decoded.front();
+        if (next.surface != nullptr) {
+            bytes += static_cast<std::size_t>(next.surface->pitch) * next.surface->h;
+        }
+
+        decoded.push_back(next);
+        _decoded.pop_front();
+        taken += 1;
+    }
+
+    return taken;
+}
+
+void AssetLoader::Publish(const std::vector<Uploaded>& uploaded) {
+    std::lock_guard lock(_mutex);
+    _uploaded.insert(_uploaded.end(), uploaded.begin(), uploaded.end());
+}
+
+void AssetLoader::TakeUploaded(std::vector<Uploaded>& uploaded) {
+    std::lock_guard lock(_mutex);
+    uploaded.insert(uploaded.end(), _uploaded.begin(), _uploaded.end());
+    _uploaded.clear();
+}
+
+void AssetLoader::AcknowledgeEvictions(std::uint64_t seen, std::uint64_t commit) {
+    std::lock_guard lock(_mutex);
+    _evictionsSeen = seen;
+    _evictionsCommit = commit;
+}
+
+void AssetLoader::EvictionsAcknowledged(std::uint64_t& seen, std::uint64_t& commit) {
+    std::lock_guard lock(_mutex);
+    seen = _evictionsSeen;
+    commit = _evictionsCommit;
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+// Asset handles
+#include "Services/AssetID.hpp"
+
+// Texture region handles
+#include "Services/TextureAtlas.hpp"
+
+// SDL surface and color
+#include <SDL_surface.h>
+#include <SDL_pixels.h>
+
+// SDL font
+#include <SDL_ttf.h>
+
+// Queues
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Worker threads
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stop_token>
+
+/// @brief Pool of threads decoding images and rasterizing texts off the
+/// renderer's thread
+/// @remark Threads hand surfaces over through three queues: requests
+/// (from the simulation), decoded surfaces (taken by the renderer's thread
+/// to upload) and uploaded regions (taken back by the simulation). Texts
+/// are rasterized one at a time, since fonts can't be shared across threads.
+/// The renderer's thread also hands evictions over through the uploaded
+/// queue, and the simulation acknowledges them back
+class AssetLoader {
+    public:
+        /// @brief Surface decoded for an asset (null if decoding failed)
+        struct Decoded {
+            /// @brief Asset to upload the surface for
+            AssetID asset;
+            /// @brief Decoded surface (owned by whoever takes it)
+            SDL_Surface* surface;
+        };
+
+        /// @brief Region uploaded for an asset (empty if uploading failed)
+        struct Uploaded {
+            /// @brief Asset the region belongs to
+            AssetID asset;
+            /// @brief Uploaded region
+            TextureRegion region;
+            /// @brief Whether the asset got evicted instead (along with its
+            /// region, which may no longer be drawn from)
+            bool evicted = false;
+        };
+
+    private:
+        /// @brief Asset waiting for a thread to decode or rasterize it
+        struct Job {
+            /// @brief Asset to decode the surface for
+            AssetID asset;
+            /// @brief Path of the image, or text to rasterize
+            std::string source;
+            /// @brief Whether the source is a text rather than a path
+            bool text;
+        };
+
+        /// @brief Guards every queue
+        std::mutex _mutex;
+
+        /// @brief Signals workers of new jobs
+        std::condition_variable_any _wake;
+
+        /// @brief Jobs waiting for a thread
+        std::deque<Job> _jobs;
+
+        /// @brief Surfaces waiting to be uploaded
+        std::deque<Decoded> _decoded;
+
+        /// @brief Regions waiting to be taken back
+        std::vector<Uploaded> _uploaded;
+
+        /// @brief Evictions taken back and acknowledged so far
+        std::uint64_t _evictionsSeen = 0;
+
+        /// @brief Frames committed as of the latest acknowledgement
+        std::uint64_t _evictionsCommit = 0;
+
+        /// @brief Guards the font (and anyone else using it)
+        std::mutex _fontMutex;
+
+        /// @brief Font to rasterize texts with (not owned)
+        TTF_Font* _font = nullptr;
+
+        /// @brief Color to rasterize texts with
+        SDL_Color _fontColor{0, 0, 0, 255};
+
+        /// @brief Worker threads (last, so they stop before the rest goes)
+        std::vector<std::jthread> _workers;
+
+        /// @brief Main loop of each worker thread
+        /// @param stoken Stop token of the worker thread
+        void Work(std::stop_token stoken);
+
+        /// @brief Queue a job for the workers
+        void Queue(Job job);
+
+    public:
+        /// @brief Start a given amount of worker threads
+        /// @param threads Amount of threads (at least one)
+        explicit AssetLoader(unsigned threads);
+
+        AssetLoader(const AssetLoader&) = delete;
+        AssetLoader& operator=(const AssetLoader&) = delete;
+
+        /// @brief Stop and join every worker thread, freeing surfaces
+        /// nobody took
+        ~AssetLoader();
+
+        /// @brief Decode an image file into a surface, eventually
+        /// @param asset Asset to upload the surface for
+        /// @param path Path of the image file
+        void DecodeImage(AssetID asset, std::string path);
+
+        /// @brief Rasterize a text into a surface, eventually
+        /// @param asset Asset to upload the surface for
+        /// @param text Text to rasterize
+        void RenderText(AssetID asset, std::string text);
+
+        /// @brief Mutex guarding the font, to hold while using it
+        /// elsewhere (or replacing it)
+        std::mutex& FontMutex();
+
+        /// @brief Set the font to rasterize texts with
+        /// @param font Font to use (not owned)
+        /// @param color Color to use
+        /// @remark FontMutex() must be held meanwhile
+        void SetFont(TTF_Font* font, SDL_Color color);
+
+        /// @brief Take decoded surfaces, up to some amount of bytes
+        /// @param byteBudget Most bytes of pixels to take (at least one
+        /// surface is taken regardless, so large ones don't get stuck)
+        /// @param decoded Returned-by-parameter surfaces taken (appended)
+        /// @return Amount of surfaces taken
+        std::size_t TakeDecoded(std::size_t byteBudget, std::vector<Decoded>& decoded);
+
+        /// @brief Hand uploaded regions back
+        /// @param uploaded Regions uploaded
+        void Publish(const std::vector<Uploaded>& uploaded);
+
+        /// @brief Take every region handed back so far
+        /// @param uploaded Returned-by-parameter regions taken (appended)
+        void TakeUploaded(std::vector<Uploaded>& uploaded);
+
+        /// @brief Acknowledge evictions taken back, so nothing drawn past
+        /// a given frame uses their regions
+        /// @param seen Evictions taken back so far
+        /// @param commit Frames committed so far (none but the next one
+        /// may still draw from evicted regions)
+        void AcknowledgeEvictions(std::uint64_t seen, std::uint64_t commit);
+
+        /// @brief Get the latest acknowledgement of evictions
+        /// @param seen Returned-by-parameter evictions taken back so far
+        /// @param commit Returned-by-parameter frames committed by then
+        void EvictionsAcknowledged(std::uint64_t& seen, std::uint64_t& commit);
+};
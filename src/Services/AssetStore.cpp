@@ -6,14 +6,52 @@
 // Error reporting
 #include "stdio.h"
 
-AssetStore::AssetStore()
+// Loading thread count
+#include <thread>
+#include <algorithm>
+
+// Thread ownership errors
+#include <stdexcept>
+
+AssetStore::AssetStore() :
+_slots{
+    AssetSlot{TextureRegion{}, true},
+    AssetSlot{TextureRegion{}, false}
+},
+_sources(2)
 {}
 
 AssetStore::AssetStore(AssetStore &&other) {
-    // Steal the other asset store service's font 
-    // and textures
+    // Steal the other asset store service's font, 
+    // textures and their regions
     _font = std::move(other._font);
-    _textures = std::move(other._textures);
+    _atlas = std::move(other._atlas);
+    _slots = std::move(other._slots);
+    _names = std::move(other._names);
+    _glyphs = other._glyphs;
+
+    // And whatever it's still loading (or evicting)
+    _pending = other._pending;
+    _loader = std::move(other._loader);
+    _published = other._published.exchange(nullptr);
+    _uploading = other._uploading.load();
+    _uploader = other._uploader;
+    _placeholderUploaded = other._placeholderUploaded;
+    _sources = std::move(other._sources);
+    _placed = std::move(other._placed);
+    _evicting = std::move(other._evicting);
+    _noticesPublished = other._noticesPublished;
+    _noticesSeen = other._noticesSeen;
+    _evicted = std::move(other._evicted);
+    _reloads = other._reloads;
+
+    // Along with its residency
+    _budget = other._budget.load();
+    _residentBytes = other._residentBytes.load();
+    _residentTextures = other._residentTextures.load();
+    _evictions = other._evictions.load();
+    _hits = other._hits.load();
+    _misses = other._misses.load();
 
     // Keep track of its color
     _fontColor = other._fontColor;
@@ -23,10 +61,36 @@ AssetStore::~AssetStore()
 {}
 
 AssetStore &AssetStore::operator=(AssetStore &&other) {
-    // Steal the other asset store service's font 
-    // and textures
+    // Steal the other asset store service's font, 
+    // textures and their regions
     _font = std::move(other._font);
-    _textures = std::move(other._textures);
+    _atlas = std::move(other._atlas);
+    _slots = std::move(other._slots);
+    _names = std::move(other._names);
+    _glyphs = other._glyphs;
+
+    // And whatever it's still loading (or evicting)
+    _pending = other._pending;
+    _loader = std::move(other._loader);
+    _published = other._published.exchange(nullptr);
+    _uploading = other._uploading.load();
+    _uploader = other._uploader;
+    _placeholderUploaded = other._placeholderUploaded;
+    _sources = std::move(other._sources);
+    _placed = std::move(other._placed);
+    _evicting = std::move(other._evicting);
+    _noticesPublished = other._noticesPublished;
+    _noticesSeen = other._noticesSeen;
+    _evicted = std::move(other._evicted);
+    _reloads = other._reloads;
+
+    // Along with its residency
+    _budget = other._budget.load();
+    _residentBytes = other._residentBytes.load();
+    _residentTextures = other._residentTextures.load();
+    _evictions = other._evictions.load();
+    _hits = other._hits.load();
+    _misses = other._misses.load();
 
     // Keep track of its color
     _fontColor = other._fontColor;
@@ -34,8 +98,8 @@ AssetStore &AssetStore::operator=(AssetStore &&other) {
     return *this;
 }
 
-const TTF_Font* AssetStore::LoadFont(const char *filepath, 
-    unsigned fontSize, SDL_Color color) {
+const TTF_Font* AssetStore::LoadFont(const WindowService &window,
+    const char *filepath, unsigned fontSize, SDL_Color color) {
     // Try to load font with given size
     TTF_Font* font = TTF_OpenFont(filepath, fontSize);
 
@@ -51,20 +115,110 @@ const TTF_Font* AssetStore::LoadFont(const char *filepath,
         return nullptr;
     }
 
+    // Glyphs get packed onto the atlas, so it must be ours still
+    CheckAtlasOwner();
+
     // Otherwise, replace previous font (if any) with current one
+    // (texts being rasterized meanwhile keep the previous one until done)
+    std::unique_lock<std::mutex> lock = LockFont();
     _font.reset(font);
+    _fontColor = color;
+
+    if (AssetLoader* loader = _published.load(std::memory_order_acquire)) {
+        loader->SetFont(font, color);
+    }
+
+    // Then rasterize its glyphs onto the atlas once and for all
+    if (!_glyphs.Build(window._renderer.get(), font, color, _atlas)) {
+        fprintf(
+            stderr,
+            "AssetStore: LoadFont couldn't cache every glyph of font at " \
+            "path \"%s\"\n",
+            filepath
+        );
+    }
+
+    Account();
 
     // And return newly loaded font
     return font;
 }
 
-const SDL_Texture* AssetStore::LoadImage(const WindowService &window, 
+TextureRegion AssetStore::Pack(const WindowService &window,
+    SDL_Surface *surface, bool evictable) {
+    // Copy the surface onto the atlas (if still ours)
+    // We need to quickly examine the guts of the window to locate the renderer
+    CheckAtlasOwner();
+    TextureRegion region = _atlas.Pack(window._renderer.get(), surface, evictable);
+
+    // Surface is no longer needed
+    SDL_FreeSurface(surface);
+
+    Account();
+    return region;
+}
+
+void AssetStore::Account() {
+    _residentBytes.store(_atlas.Bytes(), std::memory_order_relaxed);
+    _residentTextures.store(_atlas.Textures(), std::memory_order_relaxed);
+}
+
+void AssetStore::CheckAtlasOwner() const {
+    if (_uploading.load(std::memory_order_acquire) &&
+        std::this_thread::get_id() != _uploader) {
+        throw std::logic_error(
+            "AssetStore: atlas used off the uploading thread " \
+            "(load right away before uploads start)"
+        );
+    }
+}
+
+AssetID AssetStore::AddAsset(const char* nickname, const TextureRegion& region,
+    bool ready) {
+    const AssetID asset = static_cast<AssetID>(_slots.size());
+    _slots.push_back(AssetSlot{region, ready});
+    _sources.emplace_back();
+    _names.Insert(nickname, asset);
+
+    return asset;
+}
+
+AssetLoader& AssetStore::Loader() {
+    if (_loader == nullptr) {
+        // Leave a core for each of the simulation and the renderer
+        _loader = std::make_unique<AssetLoader>(
+            std::max(2u, std::thread::hardware_concurrency()) - 1
+        );
+
+        {
+            std::lock_guard lock(_loader->FontMutex());
+            _loader->SetFont(_font.get(), _fontColor);
+        }
+
+        // Only then may the uploading thread see them
+        _published.store(_loader.get(), std::memory_order_release);
+    }
+
+    return *_loader;
+}
+
+std::unique_lock<std::mutex> AssetStore::LockFont() {
+    AssetLoader* loader = _published.load(std::memory_order_acquire);
+
+    return loader != nullptr ?
+        std::unique_lock<std::mutex>(loader->FontMutex()) :
+        std::unique_lock<std::mutex>();
+}
+
+TextureRegion AssetStore::LoadImage(const WindowService &window, 
     const char *filepath, const char *nickname) {
-    // Attempt to reserve an empty spot on the associative container
-    auto [slot, placed] = _textures.try_emplace(nickname, nullptr);
+    // Headless windows can't hold textures, so don't bother decoding
+    if (window.Headless()) {
+        return TextureRegion{};
+    }
 
-    // Report failure if it ocurred (nick already utilized)
-    if (!placed) {
+    // Report failure if the nick is already utilized
+    if (_names.Contains(nickname)) {
         fprintf(
             stderr, 
             "AssetStore: LoadImage couldn't reserve spot given " \
@@ -72,15 +226,14 @@ const SDL_Texture* AssetStore::LoadImage(const WindowService &window,
             nickname
         );
 
-        return nullptr;
+        return TextureRegion{};
     }
 
-    // Attempt to load image located at path as a texture
-    // We need to quickly examine the guts of the window to locate the renderer
-    SDL_Texture* texture = IMG_LoadTexture(window._renderer.get(), filepath);
+    // Attempt to load image located at path as a surface
+    SDL_Surface* image = IMG_Load(filepath);
 
     // Report failure if it ocurred
-    if (texture == nullptr) {
+    if (image == nullptr) {
         fprintf(
             stderr, 
             "AssetStore: LoadImage couldn't load image at path \"%s\": %s\n",
@@ -88,49 +241,69 @@ const SDL_Texture* AssetStore::LoadImage(const WindowService &window,
             IMG_GetError()
         );
 
-        // Free the reserved spot
-        _textures.erase(slot);
+        return TextureRegion{};
+    }
 
-        return nullptr;
+    // Then pack it onto the atlas
+    const TextureRegion region = Pack(window, image);
+
+    // Report failure if it ocurred
+    if (!region) {
+        fprintf(
+            stderr, 
+            "AssetStore: LoadImage couldn't pack image at path \"%s\"\n",
+            filepath
+        );
+
+        return TextureRegion{};
     }
 
-    // Assign the created texture to the reserved slot
-    slot->second.reset(texture);
+    // Name the packed region
+    AddAsset(nickname, region, true);
 
-    // And return newly created texture
-    return texture;
+    // And return newly packed region
+    return region;
 }
 
-const SDL_Texture *AssetStore::LoadText(const WindowService& window, 
+TextureRegion AssetStore::LoadText(const WindowService& window, 
     const char *text, const char *nickname) {
     // Call specialization, but discard return by parameter
     glm::uvec2 ignored;
     return LoadText(window, text, nickname, ignored);
 }
 
-const SDL_Texture *AssetStore::LoadText(const WindowService &window, const char *text, 
+TextureRegion AssetStore::LoadText(const WindowService &window, const char *text, 
     const char *nickname, glm::uvec2 &size) {
     // Report missing font (if at all)
     if (_font == nullptr) {
         fprintf(stderr, "AssetStore: LoadText missing font\n");
-        return nullptr;
+        return TextureRegion{};
     }
 
-    // Attempt to reserve an empty spot on the associative container
-    auto [slot, placed] = _textures.try_emplace(nickname, nullptr);
+    // Text can't be rasterized while loading threads use the font
+    std::unique_lock<std::mutex> lock = LockFont();
+
+    // Headless windows can't hold textures, so only measure the text
+    if (window.Headless()) {
+        int width = 0, height = 0;
+        TTF_SizeText(_font.get(), text, &width, &height);
+        size = {static_cast<unsigned>(width), static_cast<unsigned>(height)};
 
-    // Report failure if it ocurred (nick already utilized)
-    if (!placed) {
+        return TextureRegion{};
+    }
+
+    // Report failure if the nick is already utilized
+    if (_names.Contains(nickname)) {
         fprintf(
             stderr, 
             "AssetStore: LoadText spot already assigned for nick \"%s\"\n",
             nickname
         );
 
-        return nullptr;
+        return TextureRegion{};
     }
 
-    // Attempt to create a surface and then a texture for the given text
+    // Attempt to create a surface for the given text
     SDL_Surface* textSurface =
     TTF_RenderText_Solid(_font.get(), text, _fontColor); 
 
@@ -143,44 +316,34 @@ const SDL_Texture *AssetStore::LoadText(const WindowService &window, const char
             TTF_GetError()
         );
 
-        // Free the reserved spot
-        _textures.erase(slot);
-
-        return nullptr;
+        return TextureRegion{};
     }
 
-    // Record the text's width and height
-    unsigned width = textSurface->w, height = textSurface->h;
-
-    SDL_Texture* textTexture = 
-    SDL_CreateTextureFromSurface(window._renderer.get(), textSurface);
-
-    // Generated surface is no longer needed
-    SDL_FreeSurface(textSurface);
+    // Then pack it onto the atlas
+    const TextureRegion region = Pack(window, textSurface);
 
-    // Report texture generation errors
-    if (textTexture == nullptr) {
+    // Report packing errors
+    if (!region) {
         fprintf(
             stderr, 
-            "AssetStore: LoadText couldn't generate texture for text \"%s\": %s\n",
-            text,
-            SDL_GetError()
+            "AssetStore: LoadText couldn't pack texture for text \"%s\"\n",
+            text
         );
 
-        // Free the reserved spot
-        _textures.erase(slot);
-
-        return nullptr;
+        return TextureRegion{};
     }
 
-    // Assign the created texture to the reserved slot
-    slot->second.reset(textTexture);
+    // Name the packed region
+    AddAsset(nickname, region, true);
 
     // And the width and height to the caller
-    size = {width, height};
+    size = {
+        static_cast<unsigned>(region.region.w),
+        static_cast<unsigned>(region.region.h)
+    };
 
-    // And return newly created texture
-    return textTexture;
+    // And return newly packed region
+    return region;
 }
 
 const TTF_Font *AssetStore::GetFont()
@@ -189,22 +352,368 @@ const TTF_Font *AssetStore::GetFont()
 const SDL_Color &AssetStore::GetFontColor()
 { return _fontColor; }
 
-const SDL_Texture *AssetStore::GetTexture(const char *nickname) {
+const GlyphCache &AssetStore::GetGlyphs() const
+{ return _glyphs; }
+
+AssetID AssetStore::RequestImage(const WindowService& window,
+    const char* filepath, const char* nickname) {
+    // Headless windows can't hold textures, so don't bother decoding
+    if (window.Headless()) {
+        return NullAsset;
+    }
+
+    // Share assets already requested under the same nick
+    const AssetID existing = GetAsset(nickname);
+    if (existing != NullAsset) {
+        return existing;
+    }
+
+    // Otherwise, draw the placeholder until decoded and uploaded
+    const AssetID asset = AddAsset(nickname, TextureRegion{}, false);
+    _sources[asset] = AssetSource{filepath, false};
+    _pending += 1;
+
+    Loader().DecodeImage(asset, filepath);
+
+    return asset;
+}
+
+AssetID AssetStore::RequestText(const WindowService& window, const char* text,
+    const char* nickname, glm::uvec2& size) {
+    // Report missing font (if at all)
+    if (_font == nullptr) {
+        fprintf(stderr, "AssetStore: RequestText missing font\n");
+        return NullAsset;
+    }
+
+    // Measure the text right away (rasterizing it is what takes long)
+    {
+        std::unique_lock<std::mutex> lock = LockFont();
+
+        int width = 0, height = 0;
+        TTF_SizeText(_font.get(), text, &width, &height);
+        size = {static_cast<unsigned>(width), static_cast<unsigned>(height)};
+    }
+
+    // Headless windows can't hold textures, so only measure the text
+    if (window.Headless()) {
+        return NullAsset;
+    }
+
+    // Share assets already requested under the same nick
+    const AssetID existing = GetAsset(nickname);
+    if (existing != NullAsset) {
+        return existing;
+    }
+
+    // Otherwise, draw the placeholder until rasterized and uploaded
+    const AssetID asset = AddAsset(nickname, TextureRegion{}, false);
+    _sources[asset] = AssetSource{text, true};
+    _pending += 1;
+
+    Loader().RenderText(asset, text);
+
+    return asset;
+}
+
+std::size_t AssetStore::UploadDecoded(WindowService& window,
+    std::size_t byteBudget) {
+    // (Started on the resolving thread, so only seen once published)
+    AssetLoader* loader = _published.load(std::memory_order_acquire);
+    if (loader == nullptr || window.Headless()) {
+        return 0;
+    }
+
+    // From now on, the atlas belongs to the first thread uploading
+    if (!_uploading.load(std::memory_order_relaxed)) {
+        _uploader = std::this_thread::get_id();
+        _uploading.store(true, std::memory_order_release);
+    }
+
+    CheckAtlasOwner();
+
+    // Upload the placeholder first of all (a grey checkerboard)
+    if (!_placeholderUploaded) {
+        SDL_Surface* checker =
+        SDL_CreateRGBSurfaceWithFormat(0, 8, 8, 32, SDL_PIXELFORMAT_RGBA32);
+
+        if (checker != nullptr) {
+            SDL_FillRect(checker, nullptr, SDL_MapRGB(checker->format, 96, 96, 96));
+
+            for (int y = 0; y < 8; y += 4) {
+                for (int x = (y / 4) % 2 * 4; x < 8; x += 8) {
+                    const SDL_Rect square{x, y, 4, 4};
+                    SDL_FillRect(checker, &square,
+                        SDL_MapRGB(checker->format, 160, 160, 160));
+                }
+            }
+        }
+
+        _uploaded.push_back(AssetLoader::Uploaded{
+            PlaceholderAsset,
+            checker != nullptr ? Pack(window, checker) : TextureRegion{}
+        });
+
+        _placeholderUploaded = true;
+    }
+
+    // Then as many decoded surfaces as the budget allows
+    _decoded.clear();
+    loader->TakeDecoded(byteBudget, _decoded);
+
+    // (Requested assets may be requested again, so they may be evicted,
+    // and count as drawn right away so they aren't before being drawn)
+    for (const AssetLoader::Decoded& decoded : _decoded) {
+        TextureRegion region{};
+
+        if (decoded.surface != nullptr) {
+            region = Pack(window, decoded.surface, true);
+
+            if (!region) {
+                fprintf(
+                    stderr,
+                    "AssetStore: UploadDecoded couldn't pack asset #%u\n",
+                    static_cast<unsigned>(decoded.asset)
+                );
+            } else {
+                _placed.emplace_back(region.page, decoded.asset);
+                window.StampTexture(region.page);
+            }
+        }
+
+        _uploaded.push_back(AssetLoader::Uploaded{decoded.asset, region});
+    }
+
+    // Then keep within budget, handing evictions back along with uploads
+    const std::size_t uploaded = _uploaded.size();
+    ReleaseEvicted(window);
+    EvictOverBudget(window);
+
+    // And hand them back to be resolved
+    if (!_uploaded.empty()) {
+        loader->Publish(_uploaded);
+        _uploaded.clear();
+    }
+
+    return uploaded;
+}
+
+void AssetStore::ReleaseEvicted(WindowService& window) {
+    if (_evicting.empty()) {
+        return;
+    }
+
+    // Once every eviction of a texture is acknowledged, the frame committed
+    // right after may still draw from it, but none after that one
+    std::uint64_t seen = 0, commit = 0;
+    _published.load(std::memory_order_acquire)->EvictionsAcknowledged(seen, commit);
+
+    const bool drained = window.Presented() >= commit + 2;
+
+    std::erase_if(_evicting, [&](const Eviction& eviction) {
+        if (!drained || seen < eviction.notices) {
+            return false;
+        }
+
+        _atlas.Evict(eviction.texture);
+        window.ForgetTexture(eviction.texture);
+        _evictions.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    });
+
+    Account();
+}
+
+void AssetStore::EvictOverBudget(WindowService& window) {
+    const std::size_t budget = _budget.load(std::memory_order_relaxed);
+    if (budget == 0) {
+        return;
+    }
+
+    // Textures being evicted already don't count against it
+    std::size_t resident = _atlas.Bytes();
+    for (const Eviction& eviction : _evicting) {
+        resident -= eviction.bytes;
+    }
+
+    while (resident > budget) {
+        // Pick the least recently drawn texture out of its grace period (if
+        // none, every evictable one is in use)
+        std::size_t victim = _atlas.Textures();
+        std::uint64_t oldest = UINT64_MAX;
+
+        for (std::size_t page = 0; page < _atlas.Textures(); ++page) {
+            const std::uint64_t drawn = window.LastDrawn(_atlas.TextureAt(page));
+            if (_atlas.Evictable(page) && drawn < oldest &&
+                drawn + EvictionGrace <= window.Presented()) {
+                victim = page;
+                oldest = drawn;
+            }
+        }
+
+        if (victim == _atlas.Textures()) {
+            return;
+        }
+
+        // Stop packing onto it, and hand every asset on it back as evicted
+        SDL_Texture* texture = _atlas.TextureAt(victim);
+        const std::size_t bytes = _atlas.BytesAt(victim);
+        _atlas.Seal(texture);
+
+        const std::uint64_t published = _noticesPublished;
+        std::erase_if(_placed, [&](const std::pair<SDL_Texture*, AssetID>& placed) {
+            if (placed.first != texture) {
+                return false;
+            }
+
+            _uploaded.push_back(AssetLoader::Uploaded{
+                placed.second, TextureRegion{texture, SDL_Rect{}}, true
+            });
+            _noticesPublished += 1;
+            return true;
+        });
+
+        // (Textures nothing got resolved onto can go right away)
+        if (_noticesPublished == published) {
+            _atlas.Evict(texture);
+            window.ForgetTexture(texture);
+            _evictions.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            _evicting.push_back(Eviction{texture, _noticesPublished, bytes});
+        }
+
+        resident -= bytes;
+    }
+
+    Account();
+}
+
+std::size_t AssetStore::ResolveUploaded(const WindowService& window) {
+    if (_loader == nullptr) {
+        return 0;
+    }
+
+    std::vector<AssetLoader::Uploaded> uploaded;
+    _loader->TakeUploaded(uploaded);
+
+    // (Failed ones resolve to an empty region, so they stop drawing)
+    const std::uint64_t seen = _noticesSeen;
+    for (const AssetLoader::Uploaded& asset : uploaded) {
+        AssetSlot& slot = _slots[asset.asset];
+
+        // Evicted ones stop drawing from their region right away
+        if (asset.evicted) {
+            if (slot.ready && slot.region.page == asset.region.page) {
+                slot.ready = false;
+                slot.evicted = true;
+                _evicted.push_back(asset.asset);
+            }
+
+            _noticesSeen += 1;
+            continue;
+        }
+
+        slot.region = asset.region;
+        slot.ready = true;
+
+        if (asset.asset != PlaceholderAsset) {
+            _pending -= 1;
+        }
+    }
+
+    // Let the uploading thread know, so it destroys them once no frame
+    // committed from now on (but the next) draws from them
+    if (_noticesSeen != seen) {
+        _loader->AcknowledgeEvictions(_noticesSeen, window.Committed());
+    }
+
+    // Then request evicted assets drawn since again
+    std::erase_if(_evicted, [this](AssetID asset) {
+        AssetSlot& slot = _slots[asset];
+        if (!slot.wanted.exchange(false, std::memory_order_relaxed)) {
+            return false;
+        }
+
+        const AssetSource& source = _sources[asset];
+        if (source.text) {
+            Loader().RenderText(asset, source.source);
+        } else {
+            Loader().DecodeImage(asset, source.source);
+        }
+
+        slot.evicted = false;
+        _pending += 1;
+        _reloads += 1;
+        return true;
+    });
+
+    return uploaded.size();
+}
+
+void AssetStore::SetBudget(std::size_t bytes)
+{ _budget.store(bytes, std::memory_order_relaxed); }
+
+AssetStore::Residency AssetStore::Stats() const {
+    return Residency{
+        _residentBytes.load(std::memory_order_relaxed),
+        _budget.load(std::memory_order_relaxed),
+        _residentTextures.load(std::memory_order_relaxed),
+        _evictions.load(std::memory_order_relaxed),
+        _evicted.size(),
+        _reloads,
+        _hits.load(std::memory_order_relaxed),
+        _misses.load(std::memory_order_relaxed)
+    };
+}
+
+std::size_t AssetStore::Pending() const
+{ return _pending; }
+
+bool AssetStore::Ready(AssetID asset) const
+{ return asset < _slots.size() && _slots[asset].ready; }
+
+const TextureRegion& AssetStore::Texture(AssetID asset) const {
+    if (asset >= _slots.size()) {
+        return _slots[NullAsset].region;
+    }
+
+    // (Counted without read-modify-writes, see _hits)
+    const AssetSlot& slot = _slots[asset];
+    if (slot.ready) {
+        _hits.store(_hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return slot.region;
+    }
+
+    if (slot.evicted) {
+        slot.wanted.store(true, std::memory_order_relaxed);
+    }
+
+    _misses.store(_misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return _slots[PlaceholderAsset].region;
+}
+
+AssetID AssetStore::GetAsset(std::string_view nickname) const {
+    const std::uint32_t asset = _names.Find(nickname);
+
+    return asset == InternTable::Missing ? NullAsset : asset;
+}
+
+TextureRegion AssetStore::GetTexture(const char *nickname) {
     // Lookup texture by nickname
-    const auto whichTexture = _textures.find(nickname);
+    const AssetID asset = GetAsset(nickname);
 
-    // Report found value (or nil if not found)
-    if (whichTexture == _textures.cend()) {
-        return nullptr;
+    // Report found value (or an empty handle if not found)
+    if (asset == NullAsset) {
+        return TextureRegion{};
     }
 
-    const SDL_Texture* texture = whichTexture->second.get();
+    const TextureRegion& texture = Texture(asset);
 
     // Warn if its nil
-    if (texture == nullptr) {
+    if (!texture) {
         fprintf(
             stderr, 
-            "AssetStore: GetTexture returned null pointer for nick \"%s\"\n",
+            "AssetStore: GetTexture returned empty region for nick \"%s\"\n",
             nickname
         );
     }
@@ -18,8 +18,29 @@
 // Memory safe container for textures
 #include "Utils/MemoryAliases.hpp"
 
-// Associative container for texture
-#include <map>
+// Packing of textures onto shared pages
+#include "Services/TextureAtlas.hpp"
+
+// Stable asset handles, and their loading off the renderer's thread
+#include "Services/AssetID.hpp"
+#include "Services/AssetLoader.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Residency accounting and thread ownership
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Per-glyph text rendering
+#include "Services/GlyphCache.hpp"
+
+// Interned asset names
+#include "Utils/InternTable.hpp"
+#include <string_view>
 
 // Window drawing service for texture formatting
 #include "Services/WindowService.hpp"
@@ -31,22 +52,229 @@
 class WindowService;
 
 /// @brief Lifetime and named-access provider of assets
+/// @remark Images and texts are packed onto shared atlas pages, and
+/// handed out as regions of them. For headless windows no texture is ever
+/// created: loads hand out empty regions, and fonts only cache metrics.
+/// Assets may also be requested asynchronously: worker threads decode
+/// them, the renderer's thread uploads them (UploadDecoded) and the
+/// simulation resolves them (ResolveUploaded), drawing a placeholder
+/// meanwhile. The atlas belongs to the thread loading right away until
+/// another one starts uploading, and only to the uploading one from then
+/// on (loading right away afterwards throws). Given a budget of texture bytes, the uploading thread also evicts the
+/// least recently drawn pages of requested assets while over it: their
+/// assets get drawn as the placeholder again, and requested anew once drawn
 class AssetStore : public Service {
+    public:
+        /// @brief Default most bytes of pixels uploaded per call
+        static constexpr std::size_t DefaultUploadBudget = 4 << 20;
+
+        /// @brief Frames a texture is kept for after last drawn (or
+        /// uploaded), regardless of the budget
+        static constexpr std::uint64_t EvictionGrace = 8;
+
+        /// @brief Residency of textures, and of the assets drawn
+        struct Residency {
+            /// @brief Bytes of pixels held by textures
+            std::size_t bytes;
+            /// @brief Most bytes of pixels to hold (zero if unlimited)
+            std::size_t budget;
+            /// @brief Textures held (atlas pages and standalone ones)
+            std::size_t textures;
+            /// @brief Textures evicted so far
+            std::uint64_t evictions;
+            /// @brief Assets evicted and not drawn since
+            std::size_t evicted;
+            /// @brief Assets requested again after being evicted
+            std::uint64_t reloads;
+            /// @brief Times assets were drawn while resident
+            std::uint64_t hits;
+            /// @brief Times assets were drawn while loading or evicted
+            /// (the placeholder got drawn instead)
+            std::uint64_t misses;
+        };
+
     private:
+        /// @brief Region of an asset, along with whether it loaded
+        struct AssetSlot {
+            /// @brief Region to draw the asset with
+            TextureRegion region;
+            /// @brief Whether it's done loading (if not, the placeholder
+            /// gets drawn instead)
+            bool ready;
+            /// @brief Whether its region got evicted (so it's not ready, nor
+            /// loading)
+            bool evicted = false;
+            /// @brief Whether it was drawn since evicted (so it gets
+            /// requested again)
+            mutable std::atomic<bool> wanted = false;
+
+            AssetSlot(const TextureRegion& region, bool ready) :
+            region(region), ready(ready) {}
+
+            AssetSlot(const AssetSlot& other) :
+            region(other.region), ready(other.ready), evicted(other.evicted),
+            wanted(other.wanted.load(std::memory_order_relaxed)) {}
+
+            AssetSlot& operator=(const AssetSlot& other) {
+                region = other.region;
+                ready = other.ready;
+                evicted = other.evicted;
+                wanted.store(other.wanted.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+                return *this;
+            }
+        };
+
+        /// @brief What an asset gets requested from, to request it again
+        /// once evicted
+        struct AssetSource {
+            /// @brief Path of the image, or text to rasterize (empty if
+            /// loaded right away, so never evicted)
+            std::string source;
+            /// @brief Whether the source is a text rather than a path
+            bool text = false;
+        };
+
+        /// @brief Texture being evicted, waiting for every frame drawn from
+        /// it to be gone
+        struct Eviction {
+            /// @brief Texture being evicted
+            SDL_Texture* texture;
+            /// @brief Evictions handed over by the time its own were
+            std::uint64_t notices;
+            /// @brief Bytes of pixels it holds
+            std::size_t bytes;
+        };
+
         /// @brief Font shared across all texts
         Memory::unique_ptr_with_deleter<TTF_Font, TTF_CloseFont> 
         _font = nullptr;
         /// @brief Font color
         SDL_Color _fontColor{0, 0, 0, 255};
 
-        /// @brief Stored, name-accesible textures
-        std::map<
-            std::string, 
-            Memory::unique_ptr_with_deleter<
-                SDL_Texture,
-                SDL_DestroyTexture
-            >
-        > _textures;
+        /// @brief Pages owning every loaded texture (loading thread until
+        /// uploads start, uploading thread after)
+        TextureAtlas _atlas;
+
+        /// @brief Region of every asset, by ID (null and placeholder first)
+        std::vector<AssetSlot> _slots;
+
+        /// @brief ID of every named asset, by nickname (only looked up when
+        /// loading, drawing goes by ID alone)
+        InternTable _names;
+
+        /// @brief Assets requested but not yet resolved
+        std::size_t _pending = 0;
+
+        /// @brief Threads loading assets (started on the first request, by
+        /// the resolving thread)
+        std::unique_ptr<AssetLoader> _loader;
+
+        /// @brief Loading threads as published to every other thread (null
+        /// until started)
+        std::atomic<AssetLoader*> _published = nullptr;
+
+        /// @brief Whether some thread started uploading (see _uploader)
+        std::atomic<bool> _uploading = false;
+
+        /// @brief Thread uploading onto the atlas, once uploads started
+        std::thread::id _uploader;
+
+        /// @brief Whether the placeholder was uploaded already (uploading
+        /// thread)
+        bool _placeholderUploaded = false;
+
+        /// @brief Surfaces taken for uploading, kept across calls
+        /// (uploading thread)
+        std::vector<AssetLoader::Decoded> _decoded;
+
+        /// @brief Regions uploaded or taken back, kept across calls
+        /// (uploading thread)
+        std::vector<AssetLoader::Uploaded> _uploaded;
+
+        /// @brief Glyphs of the loaded font
+        GlyphCache _glyphs;
+
+        /// @brief Source of every asset, by ID
+        std::vector<AssetSource> _sources;
+
+        /// @brief Page of every evictable asset uploaded (uploading thread)
+        std::vector<std::pair<SDL_Texture*, AssetID>> _placed;
+
+        /// @brief Textures being evicted (uploading thread)
+        std::vector<Eviction> _evicting;
+
+        /// @brief Evictions handed over so far (uploading thread)
+        std::uint64_t _noticesPublished = 0;
+
+        /// @brief Evictions taken back so far (resolving thread)
+        std::uint64_t _noticesSeen = 0;
+
+        /// @brief Assets evicted and not drawn since (resolving thread)
+        std::vector<AssetID> _evicted;
+
+        /// @brief Assets requested again after being evicted (resolving thread)
+        std::uint64_t _reloads = 0;
+
+        /// @brief Most bytes of pixels to hold (zero if unlimited)
+        std::atomic<std::size_t> _budget = 0;
+
+        /// @brief Bytes of pixels held, as of the latest upload or eviction
+        std::atomic<std::size_t> _residentBytes = 0;
+
+        /// @brief Textures held, as of the latest upload or eviction
+        std::atomic<std::size_t> _residentTextures = 0;
+
+        /// @brief Textures evicted so far
+        std::atomic<std::uint64_t> _evictions = 0;
+
+        /// @brief Times assets were drawn while resident
+        /// @remark Counted without read-modify-writes, since drawing
+        /// happens on a single thread (so approximate otherwise)
+        mutable std::atomic<std::uint64_t> _hits = 0;
+
+        /// @brief Times assets were drawn while loading or evicted
+        mutable std::atomic<std::uint64_t> _misses = 0;
+
+        /// @brief Pack a surface onto the atlas
+        /// @param window Window service utilized to draw
+        /// @param surface Surface to pack (freed afterwards)
+        /// @param evictable Whether the region may be evicted later on
+        /// @return Handle to packed region, or an empty handle on error
+        TextureRegion Pack(const WindowService& window, SDL_Surface* surface,
+            bool evictable = false);
+
+        /// @brief Publish how many bytes and textures the atlas holds
+        void Account();
+
+        /// @brief Check the calling thread owns the atlas (see _atlas)
+        /// @remark Throws if uploads started on another thread
+        void CheckAtlasOwner() const;
+
+        /// @brief Destroy the textures being evicted whose every frame
+        /// drawn from them is gone
+        /// @param window Window service drawing them
+        void ReleaseEvicted(WindowService& window);
+
+        /// @brief Evict the least recently drawn textures while over budget
+        /// @param window Window service drawing them
+        void EvictOverBudget(WindowService& window);
+
+        /// @brief Name a new asset
+        /// @param nickname Unused nickname to assign to the asset
+        /// @param region Region to draw it with
+        /// @param ready Whether it's done loading
+        /// @return ID of the new asset
+        AssetID AddAsset(const char* nickname, const TextureRegion& region, bool ready);
+
+        /// @brief Start the loading threads, if not yet (publishing them to
+        /// the uploading thread)
+        /// @return Loading threads
+        /// @remark From the resolving thread
+        AssetLoader& Loader();
+
+        /// @brief Lock the font against the loading threads (if started)
+        std::unique_lock<std::mutex> LockFont();
 
     public:
         /// @brief Construct an empty asset store
@@ -65,29 +293,30 @@ class AssetStore : public Service {
         /// @return Reference to this asset store
         AssetStore& operator=(AssetStore&& other);
 
-        /// @brief Load a font to use across all texts
+        /// @brief Load a font to use across all texts, and cache its glyphs
+        /// @param window Window service utilized to draw 
         /// @param path (Relative) filepath to load font from
         /// @param fontSize Size of font
         /// @param color Color of font
         /// @return Pointer to valid font if loaded sucessfully, nullptr otherwise
-        const TTF_Font* LoadFont(const char* filepath, unsigned fontSize = 10, 
-            SDL_Color color = SDL_Color{0, 0, 0, 255});
+        const TTF_Font* LoadFont(const WindowService& window, const char* filepath,
+            unsigned fontSize = 10, SDL_Color color = SDL_Color{0, 0, 0, 255});
 
         /// @brief Load an image given that its a supported format
         /// @param window Window service utilized to draw 
         /// @param filepath (Relative) filepath of image file on disk
         /// @param nickname Unused nickname to assign to resulting texture 
         /// @remark If the nickname isn't provided, the filepath will be used on its place 
-        /// @return Pointer to valid texture if loaded sucessfully, nullptr otherwise
-        const SDL_Texture* LoadImage(const WindowService& window, const char* filepath, 
+        /// @return Handle to texture region if loaded sucessfully, empty handle otherwise
+        TextureRegion LoadImage(const WindowService& window, const char* filepath, 
             const char* nickname);
 
         /// @brief Load a texture based on some text message
         /// @param window Window service utilized to draw 
         /// @param text Text to be rendered
         /// @param nickname Unused nickname to assign to resulting texture 
-        /// @return Pointer to valid texture if loaded sucessfully, nullptr otherwise
-        const SDL_Texture* LoadText(const WindowService& window, const char* text, 
+        /// @return Handle to texture region if loaded sucessfully, empty handle otherwise
+        TextureRegion LoadText(const WindowService& window, const char* text, 
             const char* nickname);
 
         /// @brief Load a texture based on some text message
@@ -95,10 +324,79 @@ class AssetStore : public Service {
         /// @param text Text to be rendered
         /// @param nickname Unused nickname to assign to resulting texture 
         /// @param size Returned-by-parameter size of resulting texture 
-        /// @return Pointer to valid texture if loaded sucessfully, nullptr otherwise
-        const SDL_Texture* LoadText(const WindowService& window, const char* text, 
+        /// @return Handle to texture region if loaded sucessfully, empty handle otherwise
+        TextureRegion LoadText(const WindowService& window, const char* text, 
             const char* nickname, glm::uvec2& size);
 
+        /// @brief Request an image to be loaded off this thread
+        /// @param window Window service utilized to draw
+        /// @param filepath (Relative) filepath of image file on disk
+        /// @param nickname Nickname to assign to the resulting asset
+        /// @return ID of the asset (the existing one, if the nickname is
+        /// taken already), or the null asset if headless
+        /// @remark The asset is drawn as a placeholder until resolved, and
+        /// as nothing at all if it fails to load
+        AssetID RequestImage(const WindowService& window, const char* filepath,
+            const char* nickname);
+
+        /// @brief Request a text to be rasterized off this thread
+        /// @param window Window service utilized to draw
+        /// @param text Text to be rendered
+        /// @param nickname Unused nickname to assign to the resulting asset
+        /// @param size Returned-by-parameter size of the text, once drawn
+        /// @return ID of the asset (the existing one, if the nickname is
+        /// taken already), or the null asset if headless or missing a font
+        AssetID RequestText(const WindowService& window, const char* text,
+            const char* nickname, glm::uvec2& size);
+
+        /// @brief Upload surfaces decoded so far onto the atlas, then
+        /// evict textures while over budget (see SetBudget())
+        /// @param window Window service utilized to draw
+        /// @param byteBudget Most bytes of pixels to upload (at least one
+        /// surface is uploaded regardless)
+        /// @return Amount of surfaces uploaded
+        /// @remark Must be called from the thread owning the renderer
+        std::size_t UploadDecoded(WindowService& window,
+            std::size_t byteBudget = DefaultUploadBudget);
+
+        /// @brief Make the regions uploaded so far drawable (and those
+        /// evicted not), requesting evicted assets drawn since again
+        /// @param window Window service the assets get drawn with
+        /// @return Amount of assets resolved
+        /// @remark Must be called from the thread using the assets (e.g.
+        /// the simulation), while nothing else draws them
+        std::size_t ResolveUploaded(const WindowService& window);
+
+        /// @brief Set the most bytes of pixels textures may hold
+        /// @param bytes Budget of bytes, or zero for no budget (the default)
+        /// @remark Textures of assets loaded right away (like the font's
+        /// glyphs) are never evicted, so they may keep it exceeded
+        void SetBudget(std::size_t bytes);
+
+        /// @brief Get the residency of textures and assets drawn so far
+        /// @remark From the thread using the assets
+        Residency Stats() const;
+
+        /// @brief Amount of requested assets not yet resolved
+        std::size_t Pending() const;
+
+        /// @brief Whether an asset is done loading
+        /// @param asset ID of the asset
+        bool Ready(AssetID asset) const;
+
+        /// @brief Retrieve the region to draw an asset with
+        /// @param asset ID of the asset
+        /// @return Const-reference to its region if done loading, to the
+        /// placeholder's if still loading or evicted (empty handle if unknown)
+        /// @remark Counts as drawing the asset (see Stats()), and marks
+        /// evicted ones to be requested again
+        const TextureRegion& Texture(AssetID asset) const;
+
+        /// @brief Retrieve an asset stored in the asset store
+        /// @param nickname Nickname assigned to the asset when loaded
+        /// @return ID of the asset if found, the null asset otherwise
+        AssetID GetAsset(std::string_view nickname) const;
+
         /// @brief Retrieve the font stored in the asset store
         /// @return Pointer to valid font if found, nullptr otherwise
         const TTF_Font* GetFont();
@@ -107,10 +405,14 @@ class AssetStore : public Service {
         /// @return Const-reference to font color stored 
         const SDL_Color& GetFontColor();
 
+        /// @brief Retrieve the glyphs cached for the loaded font
+        /// @return Const-reference to glyph cache (empty if no font loaded)
+        const GlyphCache& GetGlyphs() const;
+
         /// @brief Retrieve a texture stored in the asset store
         /// @param nickname Nickname assigned to the texture when loaded
-        /// @return Pointer to valid texture if found, nullptr otherwise
-        const SDL_Texture* GetTexture(const char* nickname);
+        /// @return Handle to texture region if found, empty handle otherwise
+        TextureRegion GetTexture(const char* nickname);
 };
 
 static_assert(
@@ -0,0 +1,233 @@
+#include "Services/BroadphaseService.hpp"
+
+// Rotation math
+#include <cmath>
+#include <numbers>
+
+// Sorting and prefix sums
+#include <algorithm>
+#include <numeric>
+
+// Merging contacts found in parallel
+#include <mutex>
+
+namespace {
+    /// @brief Dot product of two vectors
+    inline double Dot(const glm::dvec2& left, const glm::dvec2& right)
+    { return left.x * right.x + left.y * right.y; }
+
+    /// @brief Sorting key of some cell coordinates
+    inline std::uint64_t CellKey(std::int32_t x, std::int32_t y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+            static_cast<std::uint32_t>(y);
+    }
+
+    /// @brief Local axes of an oriented box
+    inline void AxesOf(const Collider& collider, glm::dvec2 axes[2]) {
+        const double radians = (collider.angle * std::numbers::pi) / 180.0;
+        const double cosine = std::cos(radians), sine = std::sin(radians);
+
+        axes[0] = {cosine, sine};
+        axes[1] = {-sine, cosine};
+    }
+
+    /// @brief Test two oriented boxes for overlap (separating axis theorem)
+    /// @param first First box
+    /// @param second Second box
+    /// @param normal Returned-by-parameter unit axis of least overlap,
+    /// pointing from the first box towards the second
+    /// @param depth Returned-by-parameter overlap along the normal
+    /// @return True if they overlap, false otherwise
+    bool Overlaps(const Collider& first, const Collider& second,
+        glm::dvec2& normal, double& depth) {
+        glm::dvec2 axes[4];
+        AxesOf(first, &axes[0]);
+        AxesOf(second, &axes[2]);
+
+        const glm::dvec2 between = second.center - first.center;
+        depth = INFINITY;
+
+        // Project both boxes onto each candidate axis
+        for (const glm::dvec2& axis : axes) {
+            const double firstRadius =
+                first.halfSize.x * std::abs(Dot(axes[0], axis)) +
+                first.halfSize.y * std::abs(Dot(axes[1], axis));
+            const double secondRadius =
+                second.halfSize.x * std::abs(Dot(axes[2], axis)) +
+                second.halfSize.y * std::abs(Dot(axes[3], axis));
+
+            const double distance = Dot(between, axis);
+            const double overlap = firstRadius + secondRadius - std::abs(distance);
+
+            // Any gap means they're apart
+            if (overlap <= 0) {
+                return false;
+            }
+
+            // Otherwise, keep the axis needing the least push
+            if (overlap < depth) {
+                depth = overlap;
+                normal = distance < 0 ? -axis : axis;
+            }
+        }
+
+        return true;
+    }
+}
+
+BroadphaseService::BroadphaseService(double cellSize) :
+_cellSize(cellSize)
+{}
+
+void BroadphaseService::Record(std::uint64_t entity,
+    const glm::dvec2 &center, const glm::uvec2 &size, double angle) {
+    _recording.push_back(Collider{
+        entity, center, glm::dvec2(size) / 2.0, angle
+    });
+}
+
+void BroadphaseService::Detect(const JobService &jobs) {
+    // Test what was recorded, and start recording anew
+    _colliders.swap(_recording);
+    _recording.clear();
+    _contacts.clear();
+
+    const std::size_t count = _colliders.size();
+    if (count < 2) {
+        return;
+    }
+
+    // Find the cells overlapped by each collider's bounding box
+    _bounds.resize(count * 4);
+    _offsets.resize(count + 1);
+
+    jobs.ParallelFor(count, 256, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t which = begin; which < end; ++which) {
+            const Collider& collider = _colliders[which];
+
+            glm::dvec2 axes[2];
+            AxesOf(collider, axes);
+
+            const glm::dvec2 extent{
+                std::abs(axes[0].x) * collider.halfSize.x +
+                std::abs(axes[1].x) * collider.halfSize.y,
+                std::abs(axes[0].y) * collider.halfSize.x +
+                std::abs(axes[1].y) * collider.halfSize.y
+            };
+
+            std::int32_t* bounds = &_bounds[which * 4];
+            bounds[0] = static_cast<std::int32_t>(
+                std::floor((collider.center.x - extent.x) / _cellSize));
+            bounds[1] = static_cast<std::int32_t>(
+                std::floor((collider.center.y - extent.y) / _cellSize));
+            bounds[2] = static_cast<std::int32_t>(
+                std::floor((collider.center.x + extent.x) / _cellSize));
+            bounds[3] = static_cast<std::int32_t>(
+                std::floor((collider.center.y + extent.y) / _cellSize));
+
+            _offsets[which + 1] =
+                static_cast<std::size_t>(bounds[2] - bounds[0] + 1) *
+                static_cast<std::size_t>(bounds[3] - bounds[1] + 1);
+        }
+    });
+
+    // Lay out every collider's entries contiguously...
+    _offsets[0] = 0;
+    std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+    _entries.resize(_offsets[count]);
+
+    // ... Then fill them in
+    jobs.ParallelFor(count, 256, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t which = begin; which < end; ++which) {
+            const std::int32_t* bounds = &_bounds[which * 4];
+            CellEntry* entry = &_entries[_offsets[which]];
+
+            for (std::int32_t y = bounds[1]; y <= bounds[3]; ++y) {
+                for (std::int32_t x = bounds[0]; x <= bounds[2]; ++x) {
+                    *entry++ = CellEntry{
+                        CellKey(x, y), x, y, static_cast<std::uint32_t>(which)
+                    };
+                }
+            }
+        }
+    });
+
+    // Group entries by cell
+    std::sort(_entries.begin(), _entries.end(),
+        [](const CellEntry& left, const CellEntry& right) {
+            return left.key < right.key ||
+                (left.key == right.key && left.collider < right.collider);
+        }
+    );
+
+    _cells.clear();
+    for (std::size_t which = 0; which < _entries.size(); ++which) {
+        if (which == 0 || _entries[which].key != _entries[which - 1].key) {
+            _cells.push_back(which);
+        }
+    }
+    _cells.push_back(_entries.size());
+
+    // Test candidate pairs sharing a cell, one batch of cells per job
+    std::mutex contactsMutex;
+    const std::size_t cells = _cells.size() - 1;
+
+    jobs.ParallelFor(cells, 64, [&](std::size_t begin, std::size_t end) {
+        std::vector<Contact> found;
+
+        for (std::size_t cell = begin; cell < end; ++cell) {
+            const std::size_t first = _cells[cell], last = _cells[cell + 1];
+
+            for (std::size_t left = first; left < last; ++left) {
+                const CellEntry& entry = _entries[left];
+                const std::int32_t* leftBounds = &_bounds[entry.collider * 4];
+
+                for (std::size_t right = left + 1; right < last; ++right) {
+                    const std::uint32_t other = _entries[right].collider;
+                    const std::int32_t* rightBounds = &_bounds[other * 4];
+
+                    // Only test each pair on the first cell both share
+                    if (entry.x != std::max(leftBounds[0], rightBounds[0]) ||
+                        entry.y != std::max(leftBounds[1], rightBounds[1])) {
+                        continue;
+                    }
+
+                    const Collider& a = _colliders[entry.collider];
+                    const Collider& b = _colliders[other];
+
+                    glm::dvec2 normal;
+                    double depth;
+                    if (Overlaps(a, b, normal, depth)) {
+                        found.push_back(Contact{a.entity, b.entity, normal, depth});
+                        found.push_back(Contact{b.entity, a.entity, -normal, depth});
+                    }
+                }
+            }
+        }
+
+        std::lock_guard lock(contactsMutex);
+        _contacts.insert(_contacts.end(), found.begin(), found.end());
+    });
+
+    // Sort contacts by entity, so each one can find its own
+    std::sort(_contacts.begin(), _contacts.end(),
+        [](const Contact& left, const Contact& right) {
+            return left.entity < right.entity ||
+                (left.entity == right.entity && left.other < right.other);
+        }
+    );
+}
+
+std::span<const Contact> BroadphaseService::ContactsOf(std::uint64_t entity) const {
+    const auto first = std::lower_bound(_contacts.begin(), _contacts.end(), entity,
+        [](const Contact& contact, std::uint64_t id) { return contact.entity < id; }
+    );
+    const auto last = std::upper_bound(first, _contacts.end(), entity,
+        [](std::uint64_t id, const Contact& contact) { return id < contact.entity; }
+    );
+
+    return std::span<const Contact>(first, last);
+}
+
+std::size_t BroadphaseService::Contacts() const
+{ return _contacts.size(); }
@@ -0,0 +1,118 @@
+#pragma once
+
+// Core definition for service
+#include "ECS/ECS_Core.hpp"
+
+// Parallel grid rebuild and pair testing
+#include "Services/JobService.hpp"
+
+// GLM vector math
+#include <glm/vec2.hpp>
+
+// Fixed-width handles
+#include <cstddef>
+#include <cstdint>
+
+// Collider and contact storage
+#include <vector>
+#include <span>
+
+/// @brief Oriented box recorded for collision detection
+struct Collider {
+    /// @brief ID of the entity owning the box
+    std::uint64_t entity;
+    /// @brief Center coordinates
+    glm::dvec2 center;
+    /// @brief Half of the width and height
+    glm::dvec2 halfSize;
+    /// @brief Angle of orientation (degrees)
+    double angle;
+};
+
+/// @brief Overlap between two colliders, as seen from one of them
+struct Contact {
+    /// @brief ID of the entity the contact is reported to
+    std::uint64_t entity;
+    /// @brief ID of the entity overlapping it
+    std::uint64_t other;
+    /// @brief Unit vector pointing from the entity towards the other
+    glm::dvec2 normal;
+    /// @brief Distance to move apart along the normal to stop overlapping
+    double depth;
+};
+
+/// @brief Entity-entity collision detection over a uniform spatial grid
+/// @remark Only occupied cells are stored, as runs of entries sorted by
+/// cell key (so the grid is unbounded, like a spatial hash). Colliders
+/// recorded during a sweep get tested on the next call to Detect(), which
+/// rebuilds the grid and tests candidate pairs (OBB against OBB, via the
+/// separating axis theorem) in parallel over cells
+class BroadphaseService : public Service {
+    private:
+        /// @brief Colliders lying on a given grid cell
+        struct CellEntry {
+            /// @brief Packed cell coordinates (sorting key)
+            std::uint64_t key;
+            /// @brief Cell coordinates
+            std::int32_t x, y;
+            /// @brief Index of collider
+            std::uint32_t collider;
+        };
+
+        /// @brief Width and height of every grid cell
+        double _cellSize;
+
+        /// @brief Colliders recorded since the last detection
+        std::vector<Collider> _recording;
+
+        /// @brief Colliders being tested
+        std::vector<Collider> _colliders;
+
+        /// @brief Cell bounds (min x, min y, max x, max y) of each collider
+        std::vector<std::int32_t> _bounds;
+
+        /// @brief First cell entry of each collider (plus the total at the end)
+        std::vector<std::size_t> _offsets;
+
+        /// @brief Cell entries of every collider, sorted by cell
+        std::vector<CellEntry> _entries;
+
+        /// @brief First entry of each cell (plus the total at the end)
+        std::vector<std::size_t> _cells;
+
+        /// @brief Contacts found on the latest detection, sorted by entity
+        std::vector<Contact> _contacts;
+
+    public:
+        /// @brief Construct an empty broadphase
+        /// @param cellSize Width and height of grid cells (pixels), ideally
+        /// around the size of the typical collider
+        explicit BroadphaseService(double cellSize = 64.0);
+
+        /// @brief Record a collider to test on the next detection
+        /// @param entity ID of the entity owning the box
+        /// @param center Center coordinates
+        /// @param size Width and height
+        /// @param angle Angle of orientation (degrees)
+        void Record(std::uint64_t entity, const glm::dvec2& center,
+            const glm::uvec2& size, double angle);
+
+        /// @brief Test every collider recorded since the last detection
+        /// against each other, replacing the contacts found before
+        /// @param jobs Job service to spread the work with
+        void Detect(const JobService& jobs);
+
+        /// @brief Contacts reported to a given entity on the latest detection
+        /// @param entity ID of the entity
+        /// @return View onto its contacts (empty if none)
+        std::span<const Contact> ContactsOf(std::uint64_t entity) const;
+
+        /// @brief Amount of contacts found on the latest detection (each
+        /// overlap is reported to both entities)
+        std::size_t Contacts() const;
+};
+
+static_assert(
+    ServiceType<BroadphaseService>,
+    "BroadphaseService service constraint violated"
+);
@@ -0,0 +1,92 @@
+#pragma once
+
+// SDL texture and rect
+#include <SDL_render.h>
+
+// Command storage
+#include <vector>
+#include <array>
+
+// Lock-free buffer exchange
+#include <atomic>
+#include <cstdint>
+
+/// @brief Plain request to draw a texture rect
+struct DrawCommand {
+    /// @brief Texture to draw from
+    SDL_Texture* texture;
+    /// @brief Source rect coordinates within the texture
+    SDL_Rect source;
+    /// @brief Destination rect coordinates
+    SDL_Rect rect;
+    /// @brief Angle (in degrees) to rotate texture at
+    double angle;
+};
+
+/// @brief Triple-buffered list of draw commands, handed over from a
+/// single producer thread (simulation) to a single consumer thread (render)
+/// @remark Neither side ever blocks: the producer always has a buffer to
+/// record onto, and the consumer always gets the latest published one.
+/// Every published buffer is numbered, so the consumer may tell which
+/// publish it is drawing (e.g. to know no older one is left in flight)
+class DrawCommandBuffer {
+    private:
+        /// @brief Flag marking the shared buffer as not yet consumed
+        static constexpr std::uint8_t Fresh = 0x4;
+
+        /// @brief Mask extracting the buffer index from a slot
+        static constexpr std::uint8_t IndexMask = 0x3;
+
+        /// @brief Underlying command lists
+        std::array<std::vector<DrawCommand>, 3> _buffers;
+
+        /// @brief Buffer being recorded onto by the producer
+        std::uint8_t _back = 0;
+
+        /// @brief Buffer published, but not owned by either side
+        /// (along with the fresh flag)
+        std::atomic<std::uint8_t> _shared = 1;
+
+        /// @brief Buffer being consumed by the consumer
+        std::uint8_t _front = 2;
+
+        /// @brief Number of the publish each buffer was last recorded for
+        std::array<std::uint64_t, 3> _sequences{};
+
+        /// @brief Buffers published so far (producer side)
+        std::uint64_t _published = 0;
+
+    public:
+        /// @brief Commands being recorded (producer side)
+        inline std::vector<DrawCommand>& Back()
+        { return _buffers[_back]; }
+
+        /// @brief Publish the recorded commands, and start recording
+        /// onto a cleared buffer (producer side)
+        void Publish() {
+            _sequences[_back] = ++_published;
+            _back = _shared.exchange(_back | Fresh) & IndexMask;
+            _buffers[_back].clear();
+        }
+
+        /// @brief Amount of buffers published so far (producer side)
+        std::uint64_t Published() const
+        { return _published; }
+
+        /// @brief Number of the publish the latest acquired commands were
+        /// recorded for, zero if none were acquired yet (consumer side)
+        std::uint64_t Sequence() const
+        { return _sequences[_front]; }
+
+        /// @brief Take the latest published commands, if new ones were
+        /// published since the last call (consumer side)
+        /// @return Pointer to commands, or nullptr if none are new
+        const std::vector<DrawCommand>* Acquire() {
+            if ((_shared.load() & Fresh) == 0) {
+                return nullptr;
+            }
+
+            _front = _shared.exchange(_front) & IndexMask;
+            return &_buffers[_front];
+        }
+};
@@ -0,0 +1,408 @@
+#include "Services/GLRenderBackend.hpp"
+
+// SDL's OpenGL entry points and renderer info
+#include <SDL_video.h>
+
+// Error throwing
+#include <stdexcept>
+
+// Error output
+#include <SDL_log.h>
+#include <SDL_error.h>
+
+// Driver names, instance layout and growth
+#include <cstring>
+#include <cstddef>
+#include <bit>
+#include <numbers>
+
+namespace {
+    /// @brief Vertex shader expanding every instance onto a rotated quad
+    /// (a triangle strip of its top-left, top-right, bottom-left and
+    /// bottom-right corners), rotated around its center like
+    /// SDL_RenderCopyEx does
+    constexpr const char* VertexSource = R"(
+        #version 330
+        layout(location = 0) in vec4 rect;
+        layout(location = 1) in vec4 source;
+        layout(location = 2) in float angle;
+
+        uniform vec2 screen;
+        out vec2 coordinates;
+
+        void main() {
+            vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+            vec2 offset = (corner - 0.5) * rect.zw;
+            float cosine = cos(angle), sine = sin(angle);
+
+            vec2 position = rect.xy + 0.5 * rect.zw + vec2(
+                offset.x * cosine - offset.y * sine,
+                offset.x * sine + offset.y * cosine
+            );
+
+            vec2 normalized = position / screen * 2.0 - 1.0;
+            gl_Position = vec4(normalized.x, -normalized.y, 0.0, 1.0);
+            coordinates = source.xy + corner * source.zw;
+        }
+    )";
+
+    /// @brief Fragment shader sampling the bound texture
+    constexpr const char* FragmentSource = R"(
+        #version 330
+        in vec2 coordinates;
+
+        uniform sampler2D atlas;
+        out vec4 color;
+
+        void main() {
+            color = texture(atlas, coordinates);
+        }
+    )";
+
+    /// @brief Load an OpenGL entry point through SDL
+    /// @param function Returned-by-parameter entry point
+    /// @param name Name of the entry point
+    /// @return True if available, false otherwise
+    template <typename Function>
+    inline bool LoadFunction(Function& function, const char* name) {
+        function = reinterpret_cast<Function>(SDL_GL_GetProcAddress(name));
+        return function != nullptr;
+    }
+
+    /// @brief Flags the instance buffer is created and mapped with
+    constexpr GLbitfield MappingFlags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+}
+
+GLRenderBackend::GLRenderBackend(SDL_Renderer *renderer, std::size_t capacity) :
+_renderer(renderer) {
+    // Only SDL's OpenGL driver shares its context (and textures)
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(_renderer, &info) != 0 ||
+        std::strcmp(info.name, "opengl") != 0) {
+        throw std::runtime_error("Renderer doesn't draw through OpenGL");
+    }
+
+    if (!Load()) {
+        throw std::runtime_error("OpenGL lacks instancing or persistent buffers");
+    }
+
+    // Build the program, sampling from the first texture unit
+    const GLuint vertex = Compile(GL_VERTEX_SHADER, VertexSource);
+    const GLuint fragment = Compile(GL_FRAGMENT_SHADER, FragmentSource);
+
+    GLint linked = GL_FALSE;
+    if (vertex != 0 && fragment != 0) {
+        _program = _gl.CreateProgram();
+        _gl.AttachShader(_program, vertex);
+        _gl.AttachShader(_program, fragment);
+        _gl.LinkProgram(_program);
+        _gl.GetProgramiv(_program, GL_LINK_STATUS, &linked);
+
+        if (linked != GL_TRUE) {
+            GLchar log[512] = "";
+            _gl.GetProgramInfoLog(_program, sizeof(log), nullptr, log);
+            SDL_Log("GLRenderBackend: program link error: %s\n", log);
+        }
+    }
+
+    // (Shaders are no longer needed once linked)
+    if (vertex != 0) {
+        _gl.DeleteShader(vertex);
+    }
+
+    if (fragment != 0) {
+        _gl.DeleteShader(fragment);
+    }
+
+    if (linked != GL_TRUE) {
+        if (_program != 0) {
+            _gl.DeleteProgram(_program);
+        }
+
+        throw std::runtime_error("Unable to build instancing program");
+    }
+
+    _screen = _gl.GetUniformLocation(_program, "screen");
+    _gl.UseProgram(_program);
+    _gl.Uniform1i(_gl.GetUniformLocation(_program, "atlas"), 0);
+    _gl.UseProgram(0);
+
+    // Then the buffer instances get written onto
+    _gl.GenVertexArrays(1, &_vertexArray);
+    if (!Allocate(capacity)) {
+        _gl.DeleteVertexArrays(1, &_vertexArray);
+        _gl.DeleteProgram(_program);
+        throw std::runtime_error("Unable to map instance buffer");
+    }
+}
+
+GLRenderBackend::~GLRenderBackend() {
+    Release();
+    _gl.DeleteVertexArrays(1, &_vertexArray);
+    _gl.DeleteProgram(_program);
+}
+
+bool GLRenderBackend::Load() {
+    // Drivers hand out entry points they don't implement (e.g. on GLX), so
+    // check the context's version before loading any (GL_MAJOR_VERSION is
+    // only known from 3.0 on, so older ones report zero)
+    if (!LoadFunction(_gl.GetIntegerv, "glGetIntegerv")) {
+        return false;
+    }
+
+    GLint major = 0, minor = 0;
+    _gl.GetIntegerv(GL_MAJOR_VERSION, &major);
+    _gl.GetIntegerv(GL_MINOR_VERSION, &minor);
+
+    // Instancing (and GLSL 3.30) needs 3.3, persistent buffers 4.4 or
+    // ARB_buffer_storage
+    const bool instancing = major > 3 || (major == 3 && minor >= 3);
+    const bool persistent = major > 4 || (major == 4 && minor >= 4) ||
+        SDL_GL_ExtensionSupported("GL_ARB_buffer_storage");
+
+    if (!instancing || !persistent) {
+        SDL_Log("GLRenderBackend: OpenGL %d.%d lacks %s\n", major, minor,
+            !instancing ? "instancing (3.3)" : "persistent buffers (4.4)");
+        return false;
+    }
+
+    return
+        LoadFunction(_gl.Enable, "glEnable") &&
+        LoadFunction(_gl.BlendFuncSeparate, "glBlendFuncSeparate") &&
+        LoadFunction(_gl.CreateShader, "glCreateShader") &&
+        LoadFunction(_gl.ShaderSource, "glShaderSource") &&
+        LoadFunction(_gl.CompileShader, "glCompileShader") &&
+        LoadFunction(_gl.GetShaderiv, "glGetShaderiv") &&
+        LoadFunction(_gl.GetShaderInfoLog, "glGetShaderInfoLog") &&
+        LoadFunction(_gl.DeleteShader, "glDeleteShader") &&
+        LoadFunction(_gl.CreateProgram, "glCreateProgram") &&
+        LoadFunction(_gl.AttachShader, "glAttachShader") &&
+        LoadFunction(_gl.LinkProgram, "glLinkProgram") &&
+        LoadFunction(_gl.GetProgramiv, "glGetProgramiv") &&
+        LoadFunction(_gl.GetProgramInfoLog, "glGetProgramInfoLog") &&
+        LoadFunction(_gl.DeleteProgram, "glDeleteProgram") &&
+        LoadFunction(_gl.UseProgram, "glUseProgram") &&
+        LoadFunction(_gl.GetUniformLocation, "glGetUniformLocation") &&
+        LoadFunction(_gl.Uniform1i, "glUniform1i") &&
+        LoadFunction(_gl.Uniform2f, "glUniform2f") &&
+        LoadFunction(_gl.GenVertexArrays, "glGenVertexArrays") &&
+        LoadFunction(_gl.BindVertexArray, "glBindVertexArray") &&
+        LoadFunction(_gl.DeleteVertexArrays, "glDeleteVertexArrays") &&
+        LoadFunction(_gl.GenBuffers, "glGenBuffers") &&
+        LoadFunction(_gl.BindBuffer, "glBindBuffer") &&
+        LoadFunction(_gl.DeleteBuffers, "glDeleteBuffers") &&
+        LoadFunction(_gl.BufferStorage, "glBufferStorage") &&
+        LoadFunction(_gl.MapBufferRange, "glMapBufferRange") &&
+        LoadFunction(_gl.UnmapBuffer, "glUnmapBuffer") &&
+        LoadFunction(_gl.EnableVertexAttribArray, "glEnableVertexAttribArray") &&
+        LoadFunction(_gl.VertexAttribPointer, "glVertexAttribPointer") &&
+        LoadFunction(_gl.VertexAttribDivisor, "glVertexAttribDivisor") &&
+        LoadFunction(_gl.DrawArraysInstanced, "glDrawArraysInstanced") &&
+        LoadFunction(_gl.FenceSync, "glFenceSync") &&
+        LoadFunction(_gl.ClientWaitSync, "glClientWaitSync") &&
+        LoadFunction(_gl.DeleteSync, "glDeleteSync") &&
+        LoadFunction(_gl.ActiveTexture, "glActiveTexture");
+}
+
+GLuint GLRenderBackend::Compile(GLenum type, const char *source) {
+    const GLuint shader = _gl.CreateShader(type);
+    _gl.ShaderSource(shader, 1, &source, nullptr);
+    _gl.CompileShader(shader);
+
+    GLint compiled = GL_FALSE;
+    _gl.GetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (compiled != GL_TRUE) {
+        GLchar log[512] = "";
+        _gl.GetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        SDL_Log("GLRenderBackend: shader compile error: %s\n", log);
+
+        _gl.DeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+void GLRenderBackend::Await(std::size_t section) {
+    GLsync& fence = _fences[section];
+    if (fence == nullptr) {
+        return;
+    }
+
+    // Flush on the first wait only, so the fence surely gets signaled
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while (_gl.ClientWaitSync(fence, flags, 1'000'000'000) == GL_TIMEOUT_EXPIRED) {
+        flags = 0;
+    }
+
+    _gl.DeleteSync(fence);
+    fence = nullptr;
+}
+
+bool GLRenderBackend::Allocate(std::size_t capacity) {
+    Release();
+
+    // Create immutable storage for every section, mapped once and for all
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>(capacity * Sections * sizeof(Instance));
+
+    _gl.GenBuffers(1, &_buffer);
+    _gl.BindBuffer(GL_ARRAY_BUFFER, _buffer);
+    _gl.BufferStorage(GL_ARRAY_BUFFER, bytes, nullptr, MappingFlags);
+    _instances = static_cast<Instance*>(
+        _gl.MapBufferRange(GL_ARRAY_BUFFER, 0, bytes, MappingFlags));
+    _gl.BindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (_instances == nullptr) {
+        SDL_Log("GLRenderBackend: unable to map %zu instances\n", capacity * Sections);
+        Release();
+        return false;
+    }
+
+    _capacity = capacity;
+    _section = 0;
+
+    // Every attribute advances once per instance (pointed at per draw)
+    _gl.BindVertexArray(_vertexArray);
+    for (GLuint attribute = 0; attribute < 3; ++attribute) {
+        _gl.EnableVertexAttribArray(attribute);
+        _gl.VertexAttribDivisor(attribute, 1);
+    }
+    _gl.BindVertexArray(0);
+
+    return true;
+}
+
+void GLRenderBackend::Release() {
+    if (_buffer == 0) {
+        return;
+    }
+
+    // The GPU may still be reading any section
+    for (std::size_t section = 0; section < Sections; ++section) {
+        Await(section);
+    }
+
+    if (_instances != nullptr) {
+        _gl.BindBuffer(GL_ARRAY_BUFFER, _buffer);
+        _gl.UnmapBuffer(GL_ARRAY_BUFFER);
+        _gl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    _gl.DeleteBuffers(1, &_buffer);
+    _buffer = 0;
+    _instances = nullptr;
+    _capacity = 0;
+}
+
+const char *GLRenderBackend::Name() const
+{ return "OpenGL (instanced)"; }
+
+std::size_t GLRenderBackend::Draw(const std::vector<DrawCommand> &commands,
+    std::vector<SDL_Texture*> &drawn) {
+    if (commands.empty()) {
+        return 0;
+    }
+
+    // Group commands by texture, keeping push order within each group
+    SortByTexture(commands);
+
+    // Grow sections to fit the whole frame if needed
+    if (commands.size() > _capacity && !Allocate(std::bit_ceil(commands.size()))) {
+        return 0;
+    }
+
+    // Write onto the section the GPU read the longest ago
+    Await(_section);
+    Instance* instances = _instances + _section * _capacity;
+
+    // Let SDL issue whatever it queued (the clear) before drawing over it
+    SDL_RenderFlush(_renderer);
+
+    int width = 1, height = 1;
+    SDL_GetRendererOutputSize(_renderer, &width, &height);
+
+    _gl.UseProgram(_program);
+    _gl.Uniform2f(_screen, static_cast<GLfloat>(width), static_cast<GLfloat>(height));
+    _gl.BindVertexArray(_vertexArray);
+    _gl.BindBuffer(GL_ARRAY_BUFFER, _buffer);
+    _gl.ActiveTexture(GL_TEXTURE0);
+
+    // Blend like SDL_BLENDMODE_BLEND
+    _gl.Enable(GL_BLEND);
+    _gl.BlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA,
+        GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Then draw each run of instances sharing a texture on a single call
+    std::size_t drawCalls = 0;
+    for (std::size_t begin = 0; begin < _order.size();) {
+        SDL_Texture* texture = _order[begin]->texture;
+
+        std::size_t end = begin + 1;
+        while (end < _order.size() && _order[end]->texture == texture) {
+            end += 1;
+        }
+
+        // Texture coordinates are normalized over the whole texture (and
+        // scaled by however much of it SDL actually uses)
+        float usedWidth = 1.0f, usedHeight = 1.0f;
+        if (SDL_GL_BindTexture(texture, &usedWidth, &usedHeight) != 0) {
+            SDL_Log("SDL_GL_BindTexture error: %s\n", SDL_GetError());
+            begin = end;
+            continue;
+        }
+
+        drawn.push_back(texture);
+
+        int textureWidth = 1, textureHeight = 1;
+        SDL_QueryTexture(texture, NULL, NULL, &textureWidth, &textureHeight);
+        const float scaleX = usedWidth / textureWidth;
+        const float scaleY = usedHeight / textureHeight;
+
+        for (std::size_t which = begin; which < end; ++which) {
+            const DrawCommand& command = *_order[which];
+            const SDL_Rect& rect = command.rect;
+            const SDL_Rect& source = command.source;
+
+            instances[which] = Instance{
+                {
+                    static_cast<GLfloat>(rect.x), static_cast<GLfloat>(rect.y),
+                    static_cast<GLfloat>(rect.w), static_cast<GLfloat>(rect.h)
+                },
+                {
+                    source.x * scaleX, source.y * scaleY,
+                    source.w * scaleX, source.h * scaleY
+                },
+                static_cast<GLfloat>((command.angle * std::numbers::pi) / 180.0)
+            };
+        }
+
+        // Point the attributes at this run's instances
+        const std::size_t offset = (_section * _capacity + begin) * sizeof(Instance);
+        _gl.VertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+            reinterpret_cast<const void*>(offset + offsetof(Instance, rect)));
+        _gl.VertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+            reinterpret_cast<const void*>(offset + offsetof(Instance, source)));
+        _gl.VertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Instance),
+            reinterpret_cast<const void*>(offset + offsetof(Instance, angle)));
+
+        _gl.DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4,
+            static_cast<GLsizei>(end - begin));
+        SDL_GL_UnbindTexture(texture);
+
+        drawCalls += 1;
+        begin = end;
+    }
+
+    // Fence the section, so it's not written again until read
+    _fences[_section] = _gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _section = (_section + 1) % Sections;
+
+    // Unbind everything, so SDL only ever finds its own state bound (it
+    // merely clears and presents in between)
+    _gl.BindVertexArray(0);
+    _gl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    _gl.UseProgram(0);
+
+    return drawCalls;
+}
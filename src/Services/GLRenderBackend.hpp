@@ -0,0 +1,148 @@
+#pragma once
+
+// Backend interface
+#include "Services/RenderBackend.hpp"
+
+// OpenGL types, constants and function pointer types
+#include <SDL_opengl.h>
+
+// Instance ring
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/// @brief Backend drawing every run of commands sharing a texture on a
+/// single instanced OpenGL call
+/// @remark Draws within the context of SDL's own OpenGL renderer, binding
+/// its textures (so atlas pages, glyphs and evictions work unchanged).
+/// Instance data is written straight into a persistently mapped buffer,
+/// split into sections used round-robin and fenced, so writing a frame
+/// never waits on the GPU reading the previous ones. Quads get expanded
+/// and rotated on the GPU. Requires SDL's "opengl" renderer driver, along
+/// with OpenGL 3.3 and persistent buffers (4.4 or ARB_buffer_storage)
+class GLRenderBackend : public RenderBackend {
+    public:
+        /// @brief Per-quad data read by the vertex shader
+        struct Instance {
+            /// @brief Destination rect (x, y, width, height), in pixels
+            GLfloat rect[4];
+            /// @brief Source rect (u, v, width, height), normalized
+            GLfloat source[4];
+            /// @brief Angle (in radians) to rotate clockwise at
+            GLfloat angle;
+        };
+
+        /// @brief Sections of the instance buffer written round-robin
+        static constexpr std::size_t Sections = 3;
+
+        /// @brief Default instances a section fits (grown on demand)
+        static constexpr std::size_t DefaultCapacity = 1 << 14;
+
+    private:
+        /// @brief OpenGL entry points (loaded through SDL, so nothing
+        /// links against OpenGL itself)
+        struct Functions {
+            decltype(&glGetIntegerv) GetIntegerv;
+            decltype(&glEnable) Enable;
+            PFNGLBLENDFUNCSEPARATEPROC BlendFuncSeparate;
+            PFNGLCREATESHADERPROC CreateShader;
+            PFNGLSHADERSOURCEPROC ShaderSource;
+            PFNGLCOMPILESHADERPROC CompileShader;
+            PFNGLGETSHADERIVPROC GetShaderiv;
+            PFNGLGETSHADERINFOLOGPROC GetShaderInfoLog;
+            PFNGLDELETESHADERPROC DeleteShader;
+            PFNGLCREATEPROGRAMPROC CreateProgram;
+            PFNGLATTACHSHADERPROC AttachShader;
+            PFNGLLINKPROGRAMPROC LinkProgram;
+            PFNGLGETPROGRAMIVPROC GetProgramiv;
+            PFNGLGETPROGRAMINFOLOGPROC GetProgramInfoLog;
+            PFNGLDELETEPROGRAMPROC DeleteProgram;
+            PFNGLUSEPROGRAMPROC UseProgram;
+            PFNGLGETUNIFORMLOCATIONPROC GetUniformLocation;
+            PFNGLUNIFORM1IPROC Uniform1i;
+            PFNGLUNIFORM2FPROC Uniform2f;
+            PFNGLGENVERTEXARRAYSPROC GenVertexArrays;
+            PFNGLBINDVERTEXARRAYPROC BindVertexArray;
+            PFNGLDELETEVERTEXARRAYSPROC DeleteVertexArrays;
+            PFNGLGENBUFFERSPROC GenBuffers;
+            PFNGLBINDBUFFERPROC BindBuffer;
+            PFNGLDELETEBUFFERSPROC DeleteBuffers;
+            PFNGLBUFFERSTORAGEPROC BufferStorage;
+            PFNGLMAPBUFFERRANGEPROC MapBufferRange;
+            PFNGLUNMAPBUFFERPROC UnmapBuffer;
+            PFNGLENABLEVERTEXATTRIBARRAYPROC EnableVertexAttribArray;
+            PFNGLVERTEXATTRIBPOINTERPROC VertexAttribPointer;
+            PFNGLVERTEXATTRIBDIVISORPROC VertexAttribDivisor;
+            PFNGLDRAWARRAYSINSTANCEDPROC DrawArraysInstanced;
+            PFNGLFENCESYNCPROC FenceSync;
+            PFNGLCLIENTWAITSYNCPROC ClientWaitSync;
+            PFNGLDELETESYNCPROC DeleteSync;
+            PFNGLACTIVETEXTUREPROC ActiveTexture;
+        };
+
+        /// @brief Renderer whose context and textures get drawn with
+        /// (owned by the window)
+        SDL_Renderer* _renderer;
+        /// @brief OpenGL entry points
+        Functions _gl{};
+        /// @brief Program expanding instances onto textured quads
+        GLuint _program = 0;
+        /// @brief Location of the uniform holding the screen size
+        GLint _screen = -1;
+        /// @brief Vertex array reading instances
+        GLuint _vertexArray = 0;
+        /// @brief Persistently mapped instance buffer
+        GLuint _buffer = 0;
+        /// @brief Mapping of the instance buffer (every section)
+        Instance* _instances = nullptr;
+        /// @brief Instances a section fits
+        std::size_t _capacity = 0;
+        /// @brief Section to write the next frame onto
+        std::size_t _section = 0;
+        /// @brief Fence over the latest frame drawn from each section
+        std::array<GLsync, Sections> _fences{};
+
+        /// @brief Check the context's version and extensions, then load
+        /// every OpenGL entry point needed
+        /// @return True if the context supports them all, false otherwise
+        bool Load();
+
+        /// @brief Compile a shader
+        /// @param type Type of shader
+        /// @param source GLSL source
+        /// @return Shader, or zero on error (reported)
+        GLuint Compile(GLenum type, const char* source);
+
+        /// @brief Wait for the GPU to be done reading a section
+        /// @param section Section to wait on
+        void Await(std::size_t section);
+
+        /// @brief (Re)create the instance buffer, with sections of a
+        /// given size
+        /// @param capacity Instances a section fits
+        /// @return True if mapped, false otherwise (reported, leaving none)
+        bool Allocate(std::size_t capacity);
+
+        /// @brief Release the instance buffer, once done reading
+        void Release();
+
+    public:
+        /// @brief Start drawing through the OpenGL context of a renderer
+        /// @param renderer Renderer to draw with (must outlive the backend,
+        /// and be current on the calling thread)
+        /// @param capacity Instances a section fits at first
+        /// @remark Throws if the renderer or OpenGL don't support it
+        explicit GLRenderBackend(SDL_Renderer* renderer,
+            std::size_t capacity = DefaultCapacity);
+
+        GLRenderBackend(const GLRenderBackend&) = delete;
+        GLRenderBackend& operator=(const GLRenderBackend&) = delete;
+
+        /// @brief Release every OpenGL object created
+        ~GLRenderBackend() override;
+
+        const char* Name() const override;
+
+        std::size_t Draw(const std::vector<DrawCommand>& commands,
+            std::vector<SDL_Texture*>& drawn) override;
+};
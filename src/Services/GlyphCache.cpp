@@ -0,0 +1,74 @@
+#include "Services/GlyphCache.hpp"
+
+// Error output
+#include <SDL_log.h>
+
+bool GlyphCache::Build(SDL_Renderer *renderer, TTF_Font *font,
+    SDL_Color color, TextureAtlas &atlas) {
+    bool complete = true;
+
+    // Forget glyphs of any previous font
+    _glyphs = {};
+    _height = TTF_FontHeight(font);
+
+    for (char character = First; character <= Last; ++character) {
+        Glyph& glyph = _glyphs[character - First];
+
+        // Record how far the pen moves past the glyph
+        int minX, maxX, minY, maxY, advance;
+        if (TTF_GlyphMetrics(font, character,
+            &minX, &maxX, &minY, &maxY, &advance) != 0) {
+            complete = false;
+            continue;
+        }
+
+        glyph.advance = advance;
+
+        // Blank glyphs (like spaces) only move the pen, and nothing
+        // gets rasterized without a renderer
+        if (maxX <= minX || renderer == nullptr) {
+            continue;
+        }
+
+        // Rasterize the glyph, already placed within its line
+        SDL_Surface* surface = TTF_RenderGlyph_Blended(font, character, color);
+        if (surface == nullptr) {
+            SDL_Log("TTF_RenderGlyph_Blended error: %s\n", TTF_GetError());
+            complete = false;
+            continue;
+        }
+
+        glyph.texture = atlas.Pack(renderer, surface);
+        SDL_FreeSurface(surface);
+
+        if (!glyph.texture) {
+            complete = false;
+        }
+    }
+
+    return complete;
+}
+
+const Glyph *GlyphCache::Find(char character) const {
+    if (character < First || character > Last) {
+        return nullptr;
+    }
+
+    return &_glyphs[character - First];
+}
+
+glm::uvec2 GlyphCache::Measure(std::string_view text) const {
+    int width = 0;
+
+    // Sum up the advance of every glyph
+    for (char character : text) {
+        if (const Glyph* glyph = Find(character)) {
+            width += glyph->advance;
+        }
+    }
+
+    return {static_cast<unsigned>(width), static_cast<unsigned>(_height)};
+}
+
+int GlyphCache::Height() const
+{ return _height; }
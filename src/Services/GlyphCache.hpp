@@ -0,0 +1,65 @@
+#pragma once
+
+// SDL font
+#include <SDL_ttf.h>
+
+// Packing of glyphs onto shared pages
+#include "Services/TextureAtlas.hpp"
+
+// Pair data packing
+#include <glm/vec2.hpp>
+
+// Glyph table and text views
+#include <array>
+#include <string_view>
+
+/// @brief Rasterized glyph along with its placement metrics
+struct Glyph {
+    /// @brief Region holding the glyph (empty for blank glyphs)
+    TextureRegion texture;
+    /// @brief Horizontal offset to the next glyph's pen position
+    int advance;
+};
+
+/// @brief Table of glyphs of a font, rasterized once onto atlas pages
+/// @remark Text gets laid out as one quad per glyph at draw time,
+/// so no texture is created per string. Covers printable ASCII only,
+/// and ignores kerning
+class GlyphCache {
+    public:
+        /// @brief First glyph cached
+        static constexpr char First = ' ';
+        /// @brief Last glyph cached
+        static constexpr char Last = '~';
+
+    private:
+        /// @brief Cached glyphs, indexed from the first one
+        std::array<Glyph, Last - First + 1> _glyphs{};
+
+        /// @brief Height of every line of text
+        int _height = 0;
+
+    public:
+        /// @brief Rasterize every glyph of a font onto an atlas
+        /// @param renderer Renderer to create atlas pages with (if null,
+        /// only the metrics get cached, e.g. for headless runs)
+        /// @param font Font to rasterize
+        /// @param color Color to rasterize glyphs with
+        /// @param atlas Atlas to pack glyphs onto
+        /// @return True if every visible glyph got cached, false otherwise
+        bool Build(SDL_Renderer* renderer, TTF_Font* font, SDL_Color color,
+            TextureAtlas& atlas);
+
+        /// @brief Find a cached glyph
+        /// @param character Character to find the glyph of
+        /// @return Pointer to glyph if cached, nullptr otherwise
+        const Glyph* Find(char character) const;
+
+        /// @brief Compute the dimensions of a laid out text
+        /// @param text Text to measure (uncached glyphs are skipped)
+        /// @return 2D vector of width and height
+        glm::uvec2 Measure(std::string_view text) const;
+
+        /// @brief Height of every line of text
+        int Height() const;
+};
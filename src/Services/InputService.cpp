@@ -0,0 +1,115 @@
+#include "Services/InputService.hpp"
+
+// Moving rings and state over
+#include <utility>
+
+InputService::InputService():
+_ring(std::make_unique<Ring>())
+{}
+
+InputService::InputService(InputService &&other) :
+_ring(std::move(other._ring)), _events(std::move(other._events)),
+_keys(other._keys) {
+    // Leave the other one usable, with a ring of its own
+    other._ring = std::make_unique<Ring>();
+    other._keys.reset();
+}
+
+InputService::~InputService()
+{}
+
+InputService &InputService::operator=(InputService &&other) {
+    std::swap(_ring, other._ring);
+    std::swap(_events, other._events);
+    std::swap(_keys, other._keys);
+    return *this;
+}
+
+bool InputService::Push(const InputEvent& event) {
+    // Only this thread moves the tail, so a relaxed load suffices for it
+    const std::size_t tail = _ring->tail.load(std::memory_order_relaxed);
+    if (tail - _ring->head.load(std::memory_order_acquire) == Capacity) {
+        _ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Publish the event only once written
+    _ring->events[tail & (Capacity - 1)] = event;
+    _ring->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+void InputService::Pump() {
+    SDL_PumpEvents();
+
+    // Take the window's events off its queue in batches, keeping those
+    // relevant to the simulation
+    constexpr int batchSize = 32;
+    SDL_Event batch[batchSize];
+
+    for (int taken; (taken = SDL_PeepEvents(batch, batchSize,
+        SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT)) > 0;) {
+        for (int which = 0; which < taken; ++which) {
+            const SDL_Event& event = batch[which];
+
+            switch (event.type)
+            {
+                case SDL_QUIT:
+                    Push(InputEvent{event.quit.timestamp, 0, 0, InputEvent::Quit, 0});
+                    break;
+
+                case SDL_KEYDOWN:
+                case SDL_KEYUP:
+                    Push(InputEvent{
+                        event.key.timestamp,
+                        static_cast<Sint32>(event.key.keysym.sym),
+                        static_cast<Uint16>(event.key.keysym.scancode),
+                        event.type == SDL_KEYDOWN ?
+                            InputEvent::KeyDown : InputEvent::KeyUp,
+                        event.key.repeat
+                    });
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+void InputService::Latch() {
+    _events.clear();
+
+    // Take every event published so far at once, then free their room
+    const std::size_t head = _ring->head.load(std::memory_order_relaxed);
+    const std::size_t tail = _ring->tail.load(std::memory_order_acquire);
+
+    for (std::size_t position = head; position != tail; ++position) {
+        const InputEvent& event = _ring->events[position & (Capacity - 1)];
+        _events.push_back(event);
+
+        // Keep the state of every key up to date, in order
+        if (event.kind != InputEvent::Quit && event.scancode < _keys.size()) {
+            _keys.set(event.scancode, event.kind == InputEvent::KeyDown);
+        }
+    }
+
+    _ring->head.store(tail, std::memory_order_release);
+}
+
+std::span<const InputEvent> InputService::Events() const {
+    return _events;
+}
+
+bool InputService::Held(SDL_Scancode scancode) const {
+    const std::size_t key = static_cast<std::size_t>(scancode);
+    return key < _keys.size() && _keys.test(key);
+}
+
+const InputService::KeyState &InputService::Keys() const {
+    return _keys;
+}
+
+std::size_t InputService::Dropped() const {
+    return _ring->dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+// SDL-provided datatypes for events and keys
+#include <SDL_events.h>
+
+// Core definition for service
+#include "ECS/ECS_Core.hpp"
+
+// Lock-free ring
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+// Per-tick events and key state
+#include <vector>
+#include <span>
+#include <bitset>
+
+/// @brief Compact record of an input event
+struct InputEvent {
+    /// @brief Kinds of events recorded
+    enum Kind : Uint8 {
+        /// @brief Window asked to close
+        Quit,
+        /// @brief Key pressed (or repeated, if held down)
+        KeyDown,
+        /// @brief Key released
+        KeyUp
+    };
+
+    /// @brief Milliseconds from SDL initialization to the event
+    Uint32 timestamp;
+    /// @brief Virtual key (layout dependent, zero unless a key event)
+    Sint32 key;
+    /// @brief Physical key (layout independent, zero unless a key event)
+    Uint16 scancode;
+    /// @brief Kind of event
+    Kind kind;
+    /// @brief Whether the key press comes from holding the key down
+    Uint8 repeat;
+};
+
+/// @brief Input service, handing events over from the thread owning the
+/// window onto the simulation one
+/// @remark Only the thread owning the window may pump its events, so it
+/// calls Pump() on its own loop, pushing compact records onto a
+/// single-producer / single-consumer lock-free ring. Once per sweep, the
+/// simulation calls Latch(), draining the ring into this sweep's events and
+/// a snapshot of which keys are held down, which systems then read without
+/// any syscalls nor locks. Events not fitting the ring get dropped (and
+/// counted) rather than blocking the window's thread
+class InputService : public Service {
+    public:
+        /// @brief Events the ring holds at most
+        static constexpr std::size_t Capacity = 256;
+
+        /// @brief State of every key, by scancode
+        using KeyState = std::bitset<SDL_NUM_SCANCODES>;
+
+    private:
+        /// @brief Ring of events handed over across threads
+        struct Ring {
+            /// @brief Events, indexed by position modulo capacity
+            InputEvent events[Capacity];
+            /// @brief Position of the next event to pop (consumer-owned)
+            alignas(64) std::atomic<std::size_t> head{0};
+            /// @brief Position of the next event to push (producer-owned)
+            alignas(64) std::atomic<std::size_t> tail{0};
+            /// @brief Events dropped for lack of room
+            std::atomic<std::size_t> dropped{0};
+        };
+
+        static_assert((Capacity & (Capacity - 1)) == 0,
+            "Input ring capacity must be a power of two");
+
+        /// @brief Ring of events (kept apart, so the service stays movable)
+        std::unique_ptr<Ring> _ring;
+
+        /// @brief Events latched on the current sweep, in order
+        std::vector<InputEvent> _events;
+
+        /// @brief Keys held down as of the latest latch
+        KeyState _keys;
+
+        /// @brief Push an event onto the ring (producer only)
+        /// @return Whether there was room for it
+        bool Push(const InputEvent& event);
+
+    public:
+        /// @brief Create an input service with an empty ring
+        InputService();
+
+        /// @brief Construct an input service by taking the ring of another
+        /// @param other Input service to take the ring from
+        InputService(InputService&& other);
+
+        /// @brief Destroy the current input service
+        ~InputService();
+
+        /// @brief Take the ring and state of another input service
+        /// @param other Input service to take the ring from
+        /// @return Reference to this input service
+        InputService& operator=(InputService&& other);
+
+        /// @brief Pump the window's events, pushing the relevant ones onto
+        /// the ring (quitting and keys, the rest get discarded)
+        /// @remark Must be called by the thread owning the window, the only
+        /// producer of the ring
+        void Pump();
+
+        /// @brief Drain the ring into this sweep's events, updating the
+        /// state of every key along the way
+        /// @remark Must be called by the simulation, the only consumer of
+        /// the ring, once per sweep before reading anything
+        void Latch();
+
+        /// @brief Get the events latched on the current sweep, in order
+        std::span<const InputEvent> Events() const;
+
+        /// @brief Get whether a key is held down, as of the latest latch
+        /// @param scancode Physical key to check
+        bool Held(SDL_Scancode scancode) const;
+
+        /// @brief Get the state of every key, as of the latest latch
+        const KeyState& Keys() const;
+
+        /// @brief Get the amount of events dropped for lack of room on the
+        /// ring since creation
+        std::size_t Dropped() const;
+};
+
+static_assert(
+    ServiceType<InputService>,
+    "InputService service constraint violated"
+);
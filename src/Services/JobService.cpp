@@ -0,0 +1,423 @@
+#include "Services/JobService.hpp"
+
+// Worker threads and their synchronization
+#include <thread>
+#include <condition_variable>
+#include <stop_token>
+
+// Storage
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+struct JobService::QueuedJob {
+    /// @brief Job to run
+    Job job;
+    /// @brief Counter to report its completion onto
+    JobCounter* counter;
+};
+
+namespace {
+    using QueuedJob = JobService::QueuedJob;
+
+    /// @brief Fixed-capacity Chase-Lev deque of jobs
+    /// @remark Only the owning thread may Push() and Pop(), while any thread
+    /// may Steal()
+    class WorkStealingDeque {
+        private:
+            /// @brief Ring buffer of jobs (power of two sized)
+            std::vector<std::atomic<QueuedJob*>> _buffer;
+
+            /// @brief Mask to wrap indices onto the buffer
+            const std::int64_t _mask;
+
+            /// @brief Next index to steal from
+            std::atomic<std::int64_t> _top = 0;
+
+            /// @brief Next index to push onto
+            std::atomic<std::int64_t> _bottom = 0;
+
+        public:
+            explicit WorkStealingDeque(std::size_t capacity) :
+            _buffer(capacity), _mask(static_cast<std::int64_t>(capacity) - 1)
+            {}
+
+            /// @brief Push a job onto the owner's end
+            /// @return False if the deque is full
+            bool Push(QueuedJob* job) {
+                const std::int64_t bottom = _bottom.load(std::memory_order_relaxed);
+                const std::int64_t top = _top.load(std::memory_order_acquire);
+
+                if (bottom - top > _mask) {
+                    return false;
+                }
+
+                _buffer[bottom & _mask].store(job, std::memory_order_relaxed);
+                _bottom.store(bottom + 1, std::memory_order_seq_cst);
+                return true;
+            }
+
+            /// @brief Pop a job from the owner's end
+            /// @return Job, or nullptr if empty
+            QueuedJob* Pop() {
+                const std::int64_t bottom =
+                    _bottom.load(std::memory_order_relaxed) - 1;
+                _bottom.store(bottom, std::memory_order_seq_cst);
+                std::int64_t top = _top.load(std::memory_order_seq_cst);
+
+                // Empty
+                if (top > bottom) {
+                    _bottom.store(bottom + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                QueuedJob* job = _buffer[bottom & _mask].load(std::memory_order_relaxed);
+
+                // Last job, race against thieves for it
+                if (top == bottom) {
+                    if (!_top.compare_exchange_strong(top, top + 1,
+                        std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                        job = nullptr;
+                    }
+
+                    _bottom.store(bottom + 1, std::memory_order_relaxed);
+                }
+
+                return job;
+            }
+
+            /// @brief Steal a job from the opposite end
+            /// @return Job, or nullptr if empty or lost a race
+            QueuedJob* Steal() {
+                std::int64_t top = _top.load(std::memory_order_seq_cst);
+                const std::int64_t bottom = _bottom.load(std::memory_order_seq_cst);
+
+                if (top >= bottom) {
+                    return nullptr;
+                }
+
+                QueuedJob* job = _buffer[top & _mask].load(std::memory_order_relaxed);
+
+                if (!_top.compare_exchange_strong(top, top + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    return nullptr;
+                }
+
+                return job;
+            }
+    };
+
+    /// @brief Capacity of each worker's deque
+    constexpr std::size_t DequeCapacity = 4096;
+}
+
+struct JobService::State {
+    /// @brief Deque owned by each worker thread
+    std::vector<std::unique_ptr<WorkStealingDeque>> deques;
+
+    /// @brief Jobs submitted from threads outside the pool
+    std::deque<QueuedJob*> inbox;
+
+    /// @brief Guards the inbox, and the sleep of idle workers
+    std::mutex mutex;
+
+    /// @brief Wakes idle workers up
+    std::condition_variable_any wake;
+
+    /// @brief Jobs queued but not yet picked up
+    std::atomic<std::size_t> queued = 0;
+
+    /// @brief Jobs submitted but not yet finished (across all counters)
+    std::atomic<std::size_t> outstanding = 0;
+
+    /// @brief Whether jobs are run inline instead of being queued
+    std::atomic<bool> stopped = false;
+
+    /// @brief Counter for jobs submitted onto the current frame
+    JobCounter frame;
+
+    /// @brief Worker threads (declared last, so they stop first)
+    std::vector<std::jthread> workers;
+};
+
+namespace {
+    /// @brief Pool the current thread works for (if any)
+    thread_local const JobService::State* currentPool = nullptr;
+
+    /// @brief Index of the current thread within its pool
+    thread_local std::size_t currentWorker = 0;
+}
+
+void JobService::Execute(State& state, QueuedJob* queued) {
+    JobCounter* counter = queued->counter;
+
+    try {
+        queued->job();
+    } catch (...) {
+        // Keep the first error only
+        std::lock_guard lock(counter->_errorMutex);
+        if (!counter->_error) {
+            counter->_error = std::current_exception();
+        }
+    }
+
+    delete queued;
+
+    counter->_pending.fetch_sub(1);
+    state.outstanding.fetch_sub(1);
+}
+
+JobService::QueuedJob* JobService::Take(State& state, std::size_t self) {
+    QueuedJob* job = nullptr;
+    const std::size_t workers = state.deques.size();
+
+    // Own deque first
+    if (self < workers) {
+        job = state.deques[self]->Pop();
+    }
+
+    // Then steal from the others, starting with the next one
+    for (std::size_t offset = 1; job == nullptr && offset <= workers; ++offset) {
+        const std::size_t victim = (self + offset) % workers;
+        if (victim != self) {
+            job = state.deques[victim]->Steal();
+        }
+    }
+
+    // Then check outside submissions
+    if (job == nullptr && state.queued.load() != 0) {
+        std::lock_guard lock(state.mutex);
+        if (!state.inbox.empty()) {
+            job = state.inbox.front();
+            state.inbox.pop_front();
+        }
+    }
+
+    if (job != nullptr) {
+        state.queued.fetch_sub(1);
+    }
+
+    return job;
+}
+
+JobService::JobService(unsigned threads) :
+_state(std::make_unique<State>()) {
+    State& state = *_state;
+
+    for (unsigned which = 0; which < threads; ++which) {
+        state.deques.push_back(std::make_unique<WorkStealingDeque>(DequeCapacity));
+    }
+
+    for (unsigned which = 0; which < threads; ++which) {
+        state.workers.emplace_back([&state, which](std::stop_token stoken) {
+            currentPool = &state;
+            currentWorker = which;
+
+            while (!stoken.stop_requested()) {
+                if (QueuedJob* job = Take(state, which)) {
+                    Execute(state, job);
+                    continue;
+                }
+
+                // Sleep until something is queued
+                std::unique_lock lock(state.mutex);
+                state.wake.wait(lock, stoken, [&] { return state.queued.load() != 0; });
+            }
+        });
+    }
+}
+
+JobService::JobService(JobService &&other) :
+_state(std::move(other._state))
+{}
+
+JobService::~JobService() {
+    if (_state != nullptr) {
+        OnStop();
+    }
+}
+
+JobService &JobService::operator=(JobService &&other) {
+    // Let our own jobs finish before taking over
+    if (_state != nullptr) {
+        OnStop();
+    }
+
+    _state = std::move(other._state);
+    return *this;
+}
+
+unsigned JobService::Threads() const {
+    return _state == nullptr ?
+        0 : static_cast<unsigned>(_state->workers.size());
+}
+
+void JobService::Enqueue(Job &&job, JobCounter &counter) const {
+    counter._pending.fetch_add(1);
+
+    // Queue it unless stopped, or if there's nobody else to run it
+    QueuedJob* queued = nullptr;
+    if (_state != nullptr && !_state->workers.empty()) {
+        State& state = *_state;
+
+        if (currentPool == &state) {
+            // Workers only submit from within a job still outstanding, so
+            // the pool can't be done draining while they check
+            if (!state.stopped.load()) {
+                queued = new QueuedJob{std::move(job), &counter};
+                state.outstanding.fetch_add(1);
+                state.queued.fetch_add(1);
+
+                // Onto their own deque, or the inbox if full
+                if (!state.deques[currentWorker]->Push(queued)) {
+                    std::lock_guard lock(state.mutex);
+                    state.inbox.push_back(queued);
+                } else {
+                    // (Synchronized with the predicate check of sleepers)
+                    std::lock_guard lock(state.mutex);
+                }
+            }
+        } else {
+            // Everyone else checks under the mutex OnStop() stops with, so
+            // either the job counts as outstanding or it runs inline
+            std::lock_guard lock(state.mutex);
+            if (!state.stopped.load()) {
+                queued = new QueuedJob{std::move(job), &counter};
+                state.outstanding.fetch_add(1);
+                state.queued.fetch_add(1);
+                state.inbox.push_back(queued);
+            }
+        }
+
+        // Wake a sleeping worker up
+        if (queued != nullptr) {
+            state.wake.notify_one();
+            return;
+        }
+    }
+
+    try {
+        job();
+    } catch (...) {
+        std::lock_guard lock(counter._errorMutex);
+        if (!counter._error) { counter._error = std::current_exception(); }
+    }
+
+    counter._pending.fetch_sub(1);
+}
+
+bool JobService::RunPending() const {
+    if (_state == nullptr) {
+        return false;
+    }
+
+    const std::size_t self = currentPool == _state.get() ?
+        currentWorker : _state->deques.size();
+
+    if (QueuedJob* job = Take(*_state, self)) {
+        Execute(*_state, job);
+        return true;
+    }
+
+    return false;
+}
+
+void JobService::Submit(JobCounter &counter, Job job) const {
+    Enqueue(std::move(job), counter);
+}
+
+void JobService::Submit(Job job) const {
+    if (_state == nullptr) {
+        job();
+        return;
+    }
+
+    Enqueue(std::move(job), _state->frame);
+}
+
+void JobService::Wait(JobCounter &counter) const {
+    // Help out while waiting
+    while (!counter.Done()) {
+        if (!RunPending()) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Report (and clear) the first error raised
+    std::exception_ptr error;
+    {
+        std::lock_guard lock(counter._errorMutex);
+        std::swap(error, counter._error);
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+JobService::Completion JobService::Await(JobCounter &counter) const {
+    return Completion{
+        {[&counter] { return counter.Done(); }}, this, &counter
+    };
+}
+
+void JobService::ParallelFor(std::size_t count, std::size_t grain,
+    const std::function<void (std::size_t, std::size_t)>& function) const {
+    // Split into as many chunks as threads can take, but no finer than grain
+    const std::size_t threads = Threads() + 1;
+    const std::size_t chunks = std::max<std::size_t>(1, std::min<std::size_t>(
+        threads * 4, count / std::max<std::size_t>(1, grain)
+    ));
+
+    if (chunks == 1) {
+        function(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        const std::size_t begin = count * chunk / chunks;
+        const std::size_t end = count * (chunk + 1) / chunks;
+
+        Submit(counter, [&function, begin, end] { function(begin, end); });
+    }
+
+    Wait(counter);
+}
+
+void JobService::AwaitFrame() const {
+    if (_state == nullptr) {
+        return;
+    }
+
+    Wait(_state->frame);
+}
+
+void JobService::OnStop() {
+    if (_state == nullptr) {
+        return;
+    }
+
+    // Any further job runs inline...
+    {
+        std::lock_guard lock(_state->mutex);
+        _state->stopped = true;
+    }
+
+    // ... While the outstanding ones finish
+    while (_state->outstanding.load() != 0) {
+        if (!RunPending()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobService::OnStart() {
+    if (_state == nullptr) {
+        return;
+    }
+
+    // Queue jobs onto the workers again (after a previous OnStop)
+    std::lock_guard lock(_state->mutex);
+    _state->stopped = false;
+}
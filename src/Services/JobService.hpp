@@ -0,0 +1,160 @@
+#pragma once
+
+// Core definition for service
+#include "ECS/ECS_Core.hpp"
+
+// Awaitable job completion
+#include "ECS/ECS_Coroutines.hpp"
+
+// Fixed-width counters
+#include <cstddef>
+#include <cstdint>
+
+// Job storage
+#include <functional>
+#include <memory>
+
+// Counters and error reporting
+#include <atomic>
+#include <mutex>
+#include <exception>
+
+/// @brief Counter of outstanding jobs submitted together, to wait on
+class JobCounter {
+    friend class JobService;
+
+    private:
+        /// @brief Jobs submitted but not yet finished
+        std::atomic<std::size_t> _pending = 0;
+
+        /// @brief First error raised by a job, if any
+        std::exception_ptr _error;
+
+        /// @brief Guards the error
+        std::mutex _errorMutex;
+
+    public:
+        /// @brief Whether every job submitted on this counter is done
+        bool Done() const
+        { return _pending.load() == 0; }
+};
+
+/// @brief Work-stealing pool of threads running fine-grained jobs
+/// @remark Every thread owns a lock-free deque: it pushes and pops its
+/// own jobs from one end, while idle threads steal from the other end.
+/// Submission is thread-safe, so systems may take this service by
+/// const-reference and still run concurrently
+class JobService : public Service {
+    public:
+        using Job = std::function<void ()>;
+
+        /// @brief Shared state of the pool (kept behind a pointer so the
+        /// service remains movable while threads refer to it)
+        struct State;
+
+        /// @brief Job queued onto the pool, along with its counter
+        struct QueuedJob;
+
+        /// @brief Awaitable resuming a coroutine service action once every
+        /// job on a counter is done, rethrowing the first error raised
+        struct Completion : Until {
+            /// @brief Service the jobs were submitted onto
+            const JobService* jobs;
+            /// @brief Counter the jobs were submitted with
+            JobCounter* counter;
+
+            void await_resume() const
+            { jobs->Wait(*counter); }
+        };
+
+    private:
+        /// @brief Worker threads, deques and queues
+        std::unique_ptr<State> _state;
+
+        /// @brief Queue a job onto the pool
+        /// @param job Job to run
+        /// @param counter Counter to report completion onto
+        void Enqueue(Job&& job, JobCounter& counter) const;
+
+        /// @brief Run a queued job and report its completion
+        /// @param state Pool the job was queued onto
+        /// @param queued Job to run (freed afterwards)
+        static void Execute(State& state, QueuedJob* queued);
+
+        /// @brief Take a job from anywhere in the pool
+        /// @param state Pool to take from
+        /// @param self Index of the calling worker (or past-the-end if external)
+        /// @return Job, or nullptr if none
+        static QueuedJob* Take(State& state, std::size_t self);
+
+        /// @brief Run a single pending job, if any, on the calling thread
+        /// @return True if a job was run, false otherwise
+        bool RunPending() const;
+
+    public:
+        /// @brief Start a pool of worker threads
+        /// @param threads Amount of worker threads (zero runs every job
+        /// inline on the submitting thread)
+        explicit JobService(unsigned threads);
+
+        /// @brief Construct a job service by stealing the threads of another
+        /// @param other Job service to take underlying threads from
+        JobService(JobService&& other);
+
+        /// @brief Drain every outstanding job, then stop the worker threads
+        ~JobService();
+
+        /// @brief Drain this job service, then steal the threads of another
+        /// @param other Job service to take underlying threads from
+        /// @return Reference to this job service
+        JobService& operator=(JobService&& other);
+
+        /// @brief Amount of worker threads
+        unsigned Threads() const;
+
+        /// @brief Submit a job onto a given counter
+        /// @param counter Counter to wait for the job with
+        /// @param job Job to run
+        void Submit(JobCounter& counter, Job job) const;
+
+        /// @brief Submit a job onto the current frame
+        /// @param job Job to run before the next frame barrier
+        void Submit(Job job) const;
+
+        /// @brief Wait until every job on a given counter is done, running
+        /// pending jobs meanwhile
+        /// @param counter Counter jobs were submitted with
+        /// @remark Rethrows the first error raised by any of them
+        void Wait(JobCounter& counter) const;
+
+        /// @brief Await every job on a given counter from a coroutine service
+        /// action, without blocking the sweep
+        /// @param counter Counter jobs were submitted with
+        /// @remark Both the service and the counter must outlive the
+        /// awaiting coroutine
+        Completion Await(JobCounter& counter) const;
+
+        /// @brief Split a range of indices into jobs, and wait for them
+        /// @param count Amount of indices (e.g. entities) to process
+        /// @param grain Least amount of indices per job
+        /// @param function Callable taking a begin and past-the-end index
+        void ParallelFor(std::size_t count, std::size_t grain,
+            const std::function<void (std::size_t, std::size_t)>& function) const;
+
+        /// @brief Wait until every job submitted onto the current frame
+        /// is done (frame barrier)
+        void AwaitFrame() const;
+
+        /// @brief Drain every outstanding job, and run any further job inline
+        /// @remark Invoked by the ECS once it stops running
+        void OnStop();
+
+        /// @brief Queue jobs onto the worker threads again, if stopped
+        /// @remark Invoked by the ECS whenever it starts running
+        void OnStart();
+};
+
+static_assert(
+    ServiceType<JobService>,
+    "JobService service constraint violated"
+);
@@ -0,0 +1,37 @@
+#include "Services/ReloadService.hpp"
+
+// Moving watches and entities over
+#include <utility>
+
+ReloadService::ReloadService(const char* path):
+_watch(std::make_unique<FileWatch>(path))
+{}
+
+ReloadService::ReloadService(ReloadService &&other) :
+_watch(std::move(other._watch)), _entities(std::move(other._entities))
+{}
+
+ReloadService::~ReloadService()
+{}
+
+ReloadService &ReloadService::operator=(ReloadService &&other) {
+    std::swap(_watch, other._watch);
+    std::swap(_entities, other._entities);
+    return *this;
+}
+
+bool ReloadService::Poll() {
+    return _watch != nullptr && _watch->Changed();
+}
+
+std::string ReloadService::Path() const {
+    return _watch != nullptr ? _watch->Path().string() : std::string();
+}
+
+ReloadService::LiveEntities &ReloadService::Entities() {
+    return _entities;
+}
+
+const ReloadService::LiveEntities &ReloadService::Entities() const {
+    return _entities;
+}
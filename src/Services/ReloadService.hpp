@@ -0,0 +1,78 @@
+#pragma once
+
+// Core definition for service
+#include "ECS/ECS_Core.hpp"
+
+// File change notifications
+#include "Utils/FileWatch.hpp"
+
+// Live entities by name
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/// @brief Live-reloading service, watching a configuration file and
+/// remembering which entity each of its entity lines built
+/// @remark Entities are known by a stable name (their configured label),
+/// along with fingerprints of what each of their components got built
+/// from, so reloading only touches the components whose lines changed
+class ReloadService : public Service {
+    public:
+        /// @brief Entity built off a configuration line
+        struct LiveEntity {
+            /// @brief ID of the entity
+            std::uint64_t entity;
+            /// @brief Fingerprint of the parameters its physics got built from
+            std::uint64_t physics;
+            /// @brief Fingerprint of the parameters its drawing got built from
+            std::uint64_t drawing;
+        };
+
+        /// @brief Live entities, by name
+        using LiveEntities = std::unordered_map<std::string, LiveEntity>;
+
+    private:
+        /// @brief Watch over the configuration file (kept apart, so the
+        /// service stays movable)
+        std::unique_ptr<FileWatch> _watch;
+
+        /// @brief Entities built off the latest configuration read
+        LiveEntities _entities;
+
+    public:
+        /// @brief Start watching a configuration file
+        /// @param path Path to the configuration file
+        explicit ReloadService(const char* path);
+
+        /// @brief Construct a reload service by taking the watch of another
+        /// @param other Reload service to take the watch from
+        ReloadService(ReloadService&& other);
+
+        /// @brief Destroy the current reload service
+        ~ReloadService();
+
+        /// @brief Take the watch and entities of another reload service
+        /// @param other Reload service to take the watch from
+        /// @return Reference to this reload service
+        ReloadService& operator=(ReloadService&& other);
+
+        /// @brief Check whether the configuration changed since the previous
+        /// check (without blocking)
+        /// @return True if it should be read again, false otherwise
+        bool Poll();
+
+        /// @brief Get the path to the configuration file
+        std::string Path() const;
+
+        /// @brief Get the entities built off the latest configuration read
+        LiveEntities& Entities();
+
+        /// @brief Get the entities built off the latest configuration read
+        const LiveEntities& Entities() const;
+};
+
+static_assert(
+    ServiceType<ReloadService>,
+    "ReloadService service constraint violated"
+);
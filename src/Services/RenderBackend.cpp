@@ -0,0 +1,150 @@
+#include "Services/RenderBackend.hpp"
+
+// Batch sorting and CPU-side rotation
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+// Error output
+#include <SDL_log.h>
+#include <SDL_error.h>
+
+void RenderBackend::SortByTexture(const std::vector<DrawCommand> &commands) {
+    _order.clear();
+    for (const DrawCommand& command : commands) {
+        _order.push_back(&command);
+    }
+
+    std::stable_sort(_order.begin(), _order.end(),
+        [](const DrawCommand* left, const DrawCommand* right) {
+            return left->texture < right->texture;
+        }
+    );
+}
+
+SDLRenderBackend::SDLRenderBackend(SDL_Renderer *renderer) :
+_renderer(renderer)
+{}
+
+const char *SDLRenderBackend::Name() const
+{ return _batching ? "SDL_Renderer (batched)" : "SDL_Renderer"; }
+
+void SDLRenderBackend::SetBatching(bool batching)
+{ _batching = batching; }
+
+std::size_t SDLRenderBackend::Draw(const std::vector<DrawCommand> &commands,
+    std::vector<SDL_Texture*> &drawn) {
+    return _batching ?
+        DrawBatched(commands, drawn) : DrawImmediate(commands, drawn);
+}
+
+std::size_t SDLRenderBackend::DrawImmediate(
+    const std::vector<DrawCommand> &commands, std::vector<SDL_Texture*> &drawn) {
+    // Issue a draw call per command and report any errors (noting each
+    // texture once per run drawing from it)
+    for (const DrawCommand& command : commands) {
+        if (drawn.empty() || drawn.back() != command.texture) {
+            drawn.push_back(command.texture);
+        }
+
+        if (SDL_RenderCopyEx(_renderer, command.texture, &command.source,
+            &command.rect, command.angle, NULL, SDL_FLIP_NONE) != 0) {
+            SDL_Log("SDL_RenderCopy error: %s\n", SDL_GetError());
+        }
+    }
+
+    return commands.size();
+}
+
+std::size_t SDLRenderBackend::DrawBatched(
+    const std::vector<DrawCommand> &commands, std::vector<SDL_Texture*> &drawn) {
+    // Group commands by texture, keeping push order within each group
+    SortByTexture(commands);
+
+    // Grow the shared quad indices to fit the whole frame if needed
+    // (every batch starts at its own vertex pointer, so they're reusable)
+    for (size_t quad = _indices.size() / 6; quad < commands.size(); ++quad) {
+        const int first = static_cast<int>(quad * 4);
+        _indices.insert(_indices.end(), {
+            first, first + 1, first + 2,
+            first + 2, first + 1, first + 3
+        });
+    }
+
+    // Expand every command onto a quad (top-left, top-right, bottom-left,
+    // bottom-right), rotated around its center like SDL_RenderCopyEx does
+    _vertices.resize(commands.size() * 4);
+
+    constexpr SDL_Color white{255, 255, 255, 255};
+    constexpr float offsetX[4] = {-0.5f, 0.5f, -0.5f, 0.5f};
+    constexpr float offsetY[4] = {-0.5f, -0.5f, 0.5f, 0.5f};
+    constexpr float cornerX[4] = {0.0f, 1.0f, 0.0f, 1.0f};
+    constexpr float cornerY[4] = {0.0f, 0.0f, 1.0f, 1.0f};
+
+    // Then submit each run of quads sharing a texture on a single call
+    std::size_t drawCalls = 0;
+    for (size_t begin = 0; begin < _order.size();) {
+        SDL_Texture* texture = _order[begin]->texture;
+
+        size_t end = begin + 1;
+        while (end < _order.size() && _order[end]->texture == texture) {
+            end += 1;
+        }
+
+        drawn.push_back(texture);
+
+        // Texture coordinates are normalized over the whole texture
+        int textureWidth = 1, textureHeight = 1;
+        SDL_QueryTexture(texture, NULL, NULL, &textureWidth, &textureHeight);
+        const float scaleX = 1.0f / textureWidth;
+        const float scaleY = 1.0f / textureHeight;
+
+        for (size_t which = begin; which < end; ++which) {
+            const DrawCommand& command = *_order[which];
+            const SDL_Rect& rect = command.rect;
+            const SDL_Rect& source = command.source;
+            SDL_Vertex* quad = &_vertices[which * 4];
+
+            const float width = static_cast<float>(rect.w);
+            const float height = static_cast<float>(rect.h);
+            const float centerX = rect.x + width * 0.5f;
+            const float centerY = rect.y + height * 0.5f;
+
+            // Unrotated quads (like text) skip the trigonometry
+            float cosine = 1.0f, sine = 0.0f;
+            if (command.angle != 0.0) {
+                const double radians = (command.angle * std::numbers::pi) / 180.0;
+                cosine = static_cast<float>(std::cos(radians));
+                sine = static_cast<float>(std::sin(radians));
+            }
+
+            // Branch-free over the corners, so it vectorizes
+            for (int corner = 0; corner < 4; ++corner) {
+                const float x = offsetX[corner] * width;
+                const float y = offsetY[corner] * height;
+
+                quad[corner].position = SDL_FPoint{
+                    centerX + x * cosine - y * sine,
+                    centerY + x * sine + y * cosine
+                };
+                quad[corner].color = white;
+                quad[corner].tex_coord = SDL_FPoint{
+                    (source.x + cornerX[corner] * source.w) * scaleX,
+                    (source.y + cornerY[corner] * source.h) * scaleY
+                };
+            }
+        }
+
+        const int quads = static_cast<int>(end - begin);
+        if (SDL_RenderGeometry(_renderer, texture,
+            &_vertices[begin * 4], quads * 4,
+            _indices.data(), quads * 6) != 0) {
+            SDL_Log("SDL_RenderGeometry error: %s\n", SDL_GetError());
+        }
+
+        drawCalls += 1;
+        begin = end;
+    }
+
+    return drawCalls;
+}
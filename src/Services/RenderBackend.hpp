@@ -0,0 +1,84 @@
+#pragma once
+
+// SDL renderer
+#include <SDL_render.h>
+
+// Draw commands to replay
+#include "Services/DrawCommands.hpp"
+
+// Batch storage
+#include <cstddef>
+#include <vector>
+
+/// @brief Way of drawing the commands committed to a window
+/// @remark Backends are only ever used from the thread owning the window's
+/// renderer, which clears the screen before drawing and presents after.
+/// Every backend draws from the renderer's textures (like the atlas pages)
+class RenderBackend {
+    protected:
+        /// @brief Commands of the frame being drawn, sorted by texture
+        std::vector<const DrawCommand*> _order;
+
+        /// @brief Group commands by texture, keeping push order within
+        /// each group (onto _order)
+        /// @param commands Commands to group
+        void SortByTexture(const std::vector<DrawCommand>& commands);
+
+    public:
+        virtual ~RenderBackend() = default;
+
+        /// @brief Get a human-readable name for the backend
+        virtual const char* Name() const = 0;
+
+        /// @brief Set whether drawings are batched per texture, if the
+        /// backend draws at all otherwise
+        /// @param batching True to batch, false to issue a draw call per
+        /// drawing
+        virtual void SetBatching(bool /*batching*/)
+        {}
+
+        /// @brief Draw the commands of a frame onto the cleared screen
+        /// @param commands Commands to draw
+        /// @param drawn Textures drawn from (appended to, once per run of
+        /// commands drawing from the same one)
+        /// @return Amount of draw calls issued
+        virtual std::size_t Draw(const std::vector<DrawCommand>& commands,
+            std::vector<SDL_Texture*>& drawn) = 0;
+};
+
+/// @brief Backend drawing through SDL_Renderer alone, whatever its driver
+/// @remark Available everywhere, so it's the fallback for every other one
+class SDLRenderBackend : public RenderBackend {
+    private:
+        /// @brief Renderer to draw with (owned by the window)
+        SDL_Renderer* _renderer;
+        /// @brief Whether commands are batched per texture
+        bool _batching = true;
+        /// @brief Quad vertices of the frame being batched
+        std::vector<SDL_Vertex> _vertices;
+        /// @brief Quad indices shared by every batch (grown on demand)
+        std::vector<int> _indices;
+
+        /// @brief Draw each command on its own SDL_RenderCopyEx call
+        std::size_t DrawImmediate(const std::vector<DrawCommand>& commands,
+            std::vector<SDL_Texture*>& drawn);
+
+        /// @brief Draw every command sharing a texture on a single
+        /// SDL_RenderGeometry call, rotating quads on the CPU
+        /// @remark Commands are stably sorted by texture, so drawing order
+        /// only holds between commands sharing a texture
+        std::size_t DrawBatched(const std::vector<DrawCommand>& commands,
+            std::vector<SDL_Texture*>& drawn);
+
+    public:
+        /// @brief Draw through a given renderer
+        /// @param renderer Renderer to draw with (must outlive the backend)
+        explicit SDLRenderBackend(SDL_Renderer* renderer);
+
+        const char* Name() const override;
+
+        void SetBatching(bool batching) override;
+
+        std::size_t Draw(const std::vector<DrawCommand>& commands,
+            std::vector<SDL_Texture*>& drawn) override;
+};
@@ -1,12 +1,22 @@
 #include "Services/StopwatchService.hpp"
-#include "StopwatchService.hpp"
+
+// Tick rounding
+#include <cmath>
+#include <algorithm>
 
 StopwatchService::StopwatchService():
-_msOnReset(SDL_GetTicks64())
+_msOnReset(SDL_GetTicks64()), 
+_counterOnAdvance(SDL_GetPerformanceCounter()),
+_counterFrequency(SDL_GetPerformanceFrequency())
 {}
 
 StopwatchService::StopwatchService(StopwatchService &&other) :
-_msOnReset(other._msOnReset), _active(other._active) 
+_msOnReset(other._msOnReset), _active(other._active),
+_counterOnAdvance(other._counterOnAdvance), 
+_counterFrequency(other._counterFrequency),
+_step(other._step), _maxTicks(other._maxTicks),
+_accumulator(other._accumulator), _ticks(other._ticks),
+_totalTicks(other._totalTicks)
 {}
 
 StopwatchService::~StopwatchService()
@@ -15,6 +25,13 @@ StopwatchService::~StopwatchService()
 StopwatchService &StopwatchService::operator=(StopwatchService &&other) {
     _msOnReset = other._msOnReset;
     _active = other._active;
+    _counterOnAdvance = other._counterOnAdvance;
+    _counterFrequency = other._counterFrequency;
+    _step = other._step;
+    _maxTicks = other._maxTicks;
+    _accumulator = other._accumulator;
+    _ticks = other._ticks;
+    _totalTicks = other._totalTicks;
     return *this;
 }
 
@@ -41,3 +58,60 @@ bool StopwatchService::Toggle() {
 
     return _active;
 }
+
+void StopwatchService::SetStep(double step, unsigned maxTicks) {
+    _step = step;
+    _maxTicks = std::max(1u, maxTicks);
+    _accumulator = 0;
+}
+
+unsigned StopwatchService::Advance() {
+    // Measure the real time elapsed since the previous advance
+    const Uint64 counter = SDL_GetPerformanceCounter();
+    const double elapsed = 
+        static_cast<double>(counter - _counterOnAdvance) / _counterFrequency;
+    _counterOnAdvance = counter;
+
+    // Time doesn't pass while toggled off
+    if (!_active) {
+        _ticks = 0;
+        return _ticks;
+    }
+
+    // Spend whole ticks of the banked time, dropping whatever is
+    // beyond the most ticks allowed
+    _accumulator += elapsed;
+    _ticks = static_cast<unsigned>(
+        std::min<double>(std::floor(_accumulator / _step), _maxTicks)
+    );
+    _accumulator = std::min(_accumulator - _ticks * _step, _step);
+
+    _totalTicks += _ticks;
+    return _ticks;
+}
+
+void StopwatchService::AdvanceTicks(unsigned ticks) {
+    _counterOnAdvance = SDL_GetPerformanceCounter();
+    _accumulator = 0;
+    _ticks = _active ? ticks : 0;
+    _totalTicks += _ticks;
+}
+
+unsigned StopwatchService::Ticks() const
+{ return _ticks; }
+
+Uint64 StopwatchService::TotalTicks() const
+{ return _totalTicks; }
+
+double StopwatchService::Step() const
+{ return _step; }
+
+Until StopwatchService::After(double seconds) const {
+    const Uint64 target = _totalTicks +
+        static_cast<Uint64>(std::ceil(std::max(0.0, seconds) / _step));
+
+    return Until{[this, target] { return _totalTicks >= target; }};
+}
+
+double StopwatchService::Alpha() const
+{ return std::min(_accumulator / _step, 1.0); }
@@ -8,7 +8,13 @@
 // Core definition for service
 #include "ECS/ECS_Core.hpp"
 
+// Awaitable timers
+#include "ECS/ECS_Coroutines.hpp"
+
 /// @brief Timekeeping service 
+/// @remark Also paces the simulation in fixed steps: each sweep, Advance()
+/// banks the real time elapsed and turns it into whole ticks of a fixed
+/// step, keeping the remainder for the next sweep
 class StopwatchService : public Service {
     private:
         /// @brief Milliseconds elapsed from SDL initialization to
@@ -19,6 +25,28 @@ class StopwatchService : public Service {
         /// on or not
         bool _active = true;
 
+        /// @brief Performance counter value on the latest advance
+        Uint64 _counterOnAdvance = 0;
+
+        /// @brief Performance counter increments per second
+        Uint64 _counterFrequency = 1;
+
+        /// @brief Seconds simulated by every tick
+        double _step = 1.0 / 120.0;
+
+        /// @brief Most ticks simulated on a single sweep (so a slow sweep
+        /// doesn't snowball into ever slower ones)
+        unsigned _maxTicks = 8;
+
+        /// @brief Seconds elapsed but not yet simulated
+        double _accumulator = 0;
+
+        /// @brief Ticks to simulate on the current sweep
+        unsigned _ticks = 0;
+
+        /// @brief Ticks simulated since creation
+        Uint64 _totalTicks = 0;
+
     public:
         /// @brief Create and start a stopwatch
         StopwatchService();
@@ -50,7 +78,47 @@ class StopwatchService : public Service {
         /// @brief Toggle and then reset the timer. Future calls to retrieve
         /// the elapsed time yield zero until it is toggled back on
         /// @return Whether the timer is on or off after the toggle call
+        /// @remark No ticks are simulated while toggled off
         bool Toggle();
+
+        /// @brief Set the fixed step of the simulation
+        /// @param step Seconds simulated by every tick
+        /// @param maxTicks Most ticks simulated on a single sweep
+        void SetStep(double step, unsigned maxTicks = 8);
+
+        /// @brief Bank the real time elapsed since the previous advance,
+        /// and spend as many whole ticks of it as possible on this sweep
+        /// @return Ticks to simulate on this sweep
+        unsigned Advance();
+
+        /// @brief Simulate a set amount of ticks on this sweep, regardless
+        /// of the real time elapsed (e.g. faster than real time)
+        /// @param ticks Ticks to simulate on this sweep
+        /// @remark Keeps the simulation deterministic, since nothing
+        /// depends on the clock
+        void AdvanceTicks(unsigned ticks);
+
+        /// @brief Get the ticks to simulate on the current sweep
+        unsigned Ticks() const;
+
+        /// @brief Get the ticks simulated since creation
+        Uint64 TotalTicks() const;
+
+        /// @brief Get the seconds simulated by every tick
+        double Step() const;
+
+        /// @brief Awaitable resuming a coroutine service action once a given
+        /// amount of simulated time goes by
+        /// @param seconds Seconds to simulate before resuming (rounded up to
+        /// whole ticks)
+        /// @remark Driven by ticks, so it pauses along with the simulation.
+        /// The stopwatch must outlive the awaiting coroutine
+        Until After(double seconds) const;
+
+        /// @brief Get how far real time is between the latest two ticks
+        /// @return Fraction in [0, 1) to blend the latest two ticks' states
+        /// with when drawing
+        double Alpha() const;
 };
 
 static_assert(
@@ -0,0 +1,194 @@
+#include "Services/TextureAtlas.hpp"
+
+// Error output
+#include <SDL_log.h>
+#include <SDL_error.h>
+
+// Page lookup and clearing
+#include <algorithm>
+#include <vector>
+
+TextureAtlas::TextureAtlas(int pageSize) :
+_pageSize(pageSize)
+{}
+
+bool TextureAtlas::Reserve(Page &page, int width, int height, SDL_Rect &spot) {
+    // Pick the shortest row with room for the spot
+    Shelf* best = nullptr;
+    for (Shelf& shelf : page.shelves) {
+        if (shelf.height >= height && shelf.cursor + width <= _pageSize &&
+            (best == nullptr || shelf.height < best->height)) {
+            best = &shelf;
+        }
+    }
+
+    // Otherwise, open a new row as tall as the spot
+    if (best == nullptr) {
+        if (page.nextY + height > _pageSize || width > _pageSize) {
+            return false;
+        }
+
+        page.shelves.push_back(Shelf{page.nextY, height, 0});
+        page.nextY += height;
+        best = &page.shelves.back();
+    }
+
+    // Place the spot onto the row
+    spot = SDL_Rect{best->cursor, best->y, width, height};
+    best->cursor += width;
+
+    return true;
+}
+
+bool TextureAtlas::Clear(SDL_Texture *texture) {
+    // Upload transparent pixels a strip of rows at a time
+    constexpr int StripRows = 64;
+    const std::vector<Uint32> zeros(static_cast<std::size_t>(_pageSize) * StripRows, 0);
+
+    for (int y = 0; y < _pageSize; y += StripRows) {
+        const SDL_Rect strip{0, y, _pageSize, std::min(StripRows, _pageSize - y)};
+        if (SDL_UpdateTexture(texture, &strip, zeros.data(),
+            _pageSize * static_cast<int>(sizeof(Uint32))) != 0) {
+            SDL_Log("SDL_UpdateTexture error: %s\n", SDL_GetError());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+TextureAtlas::Page &TextureAtlas::Open(SDL_Texture *texture, bool evictable) {
+    // Account for however many bytes the renderer holds it with
+    Uint32 format = SDL_PIXELFORMAT_RGBA32;
+    int width = 0, height = 0;
+    SDL_QueryTexture(texture, &format, nullptr, &width, &height);
+
+    Page& page = _pages.emplace_back();
+    page.texture.reset(texture);
+    page.bytes = static_cast<std::size_t>(width) * height * SDL_BYTESPERPIXEL(format);
+    page.evictable = evictable;
+
+    _bytes += page.bytes;
+    return page;
+}
+
+TextureRegion TextureAtlas::Pack(SDL_Renderer *renderer, SDL_Surface *surface,
+    bool evictable) {
+    // Bring the surface onto the pages' pixel format
+    Memory::unique_ptr_with_deleter<SDL_Surface, SDL_FreeSurface> converted(
+        SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0)
+    );
+
+    if (converted == nullptr) {
+        SDL_Log("SDL_ConvertSurfaceFormat error: %s\n", SDL_GetError());
+        return TextureRegion{};
+    }
+
+    const int width = converted->w, height = converted->h;
+
+    // Keep surfaces larger than a page on their own texture
+    if (width + Padding > _pageSize || height + Padding > _pageSize) {
+        SDL_Texture* texture =
+        SDL_CreateTextureFromSurface(renderer, converted.get());
+
+        if (texture == nullptr) {
+            SDL_Log("SDL_CreateTextureFromSurface error: %s\n", SDL_GetError());
+            return TextureRegion{};
+        }
+
+        Open(texture, evictable).standalone = true;
+        return TextureRegion{texture, SDL_Rect{0, 0, width, height}};
+    }
+
+    // Find a spot on the open pages alike, latest first
+    SDL_Rect spot;
+    Page* target = nullptr;
+    for (auto page = _pages.rbegin(); page != _pages.rend(); ++page) {
+        if (page->standalone || page->sealed || page->evictable != evictable) {
+            continue;
+        }
+
+        if (Reserve(*page, width + Padding, height + Padding, spot)) {
+            target = &*page;
+            break;
+        }
+    }
+
+    // Otherwise, open a new page
+    if (target == nullptr) {
+        SDL_Texture* texture = SDL_CreateTexture(
+            renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+            _pageSize, _pageSize
+        );
+
+        if (texture == nullptr) {
+            SDL_Log("SDL_CreateTexture error: %s\n", SDL_GetError());
+            return TextureRegion{};
+        }
+
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+        // Static textures start out undefined, so clear it (padding and
+        // the unused ends of rows included) so filtering never bleeds
+        // garbage onto the edges of regions
+        if (!Clear(texture)) {
+            SDL_DestroyTexture(texture);
+            return TextureRegion{};
+        }
+
+        target = &Open(texture, evictable);
+        Reserve(*target, width + Padding, height + Padding, spot);
+    }
+
+    // Copy the pixels onto the spot (padding excluded)
+    const SDL_Rect region{spot.x, spot.y, width, height};
+    if (SDL_UpdateTexture(target->texture.get(), &region,
+        converted->pixels, converted->pitch) != 0) {
+        SDL_Log("SDL_UpdateTexture error: %s\n", SDL_GetError());
+        return TextureRegion{};
+    }
+
+    return TextureRegion{target->texture.get(), region};
+}
+
+size_t TextureAtlas::Textures() const
+{ return _pages.size(); }
+
+std::size_t TextureAtlas::Bytes() const
+{ return _bytes; }
+
+SDL_Texture *TextureAtlas::TextureAt(std::size_t page) const
+{ return _pages[page].texture.get(); }
+
+std::size_t TextureAtlas::BytesAt(std::size_t page) const
+{ return _pages[page].bytes; }
+
+bool TextureAtlas::Evictable(std::size_t page) const {
+    return _pages[page].evictable && !_pages[page].sealed;
+}
+
+void TextureAtlas::Seal(SDL_Texture *texture) {
+    for (Page& page : _pages) {
+        if (page.texture.get() == texture) {
+            page.sealed = true;
+        }
+    }
+}
+
+std::size_t TextureAtlas::Evict(SDL_Texture *texture) {
+    const auto page = std::find_if(_pages.begin(), _pages.end(),
+        [texture](const Page& candidate) {
+            return candidate.texture.get() == texture;
+        }
+    );
+
+    if (page == _pages.end()) {
+        return 0;
+    }
+
+    const std::size_t bytes = page->bytes;
+    _bytes -= bytes;
+    _pages.erase(page);
+
+    return bytes;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+// SDL texture and renderer
+#include <SDL_render.h>
+
+// SDL surface
+#include <SDL_surface.h>
+
+// Memory safe container for textures
+#include "Utils/MemoryAliases.hpp"
+
+// Page storage
+#include <cstddef>
+#include <vector>
+
+/// @brief Non-owning handle to a region of some texture (e.g. an atlas page)
+/// @remark Kept trivial so components may hold it, value-initialize it
+/// (i.e. TextureRegion{}) for an empty handle
+struct TextureRegion {
+    /// @brief Texture holding the region
+    SDL_Texture* page;
+    /// @brief Region coordinates within the texture
+    SDL_Rect region;
+
+    /// @brief Whether the handle refers to any texture
+    explicit operator bool() const
+    { return page != nullptr; }
+};
+
+/// @brief Packs many small surfaces onto a few large textures (pages)
+/// @remark Uses shelf packing: each page is split into rows as tall as
+/// the first region placed on them, and regions are placed onto the
+/// shortest row they fit on, left to right. Regions are never freed one by
+/// one, but pages holding only evictable regions (ones their owner may
+/// upload again) may be evicted whole. Evictable and pinned regions are
+/// never packed onto the same page
+class TextureAtlas {
+    private:
+        /// @brief Row of regions within a page
+        struct Shelf {
+            /// @brief Vertical offset of the row
+            int y;
+            /// @brief Height of the row
+            int height;
+            /// @brief Horizontal offset of the next free spot
+            int cursor;
+        };
+
+        /// @brief Texture along with its packed rows
+        struct Page {
+            /// @brief Underlying texture
+            Memory::unique_ptr_with_deleter<SDL_Texture, SDL_DestroyTexture>
+            texture;
+            /// @brief Rows opened so far
+            std::vector<Shelf> shelves;
+            /// @brief Vertical offset where the next row opens
+            int nextY = 0;
+            /// @brief Bytes of pixels the texture holds
+            std::size_t bytes = 0;
+            /// @brief Whether its regions may be evicted
+            bool evictable = false;
+            /// @brief Whether it holds a single texture too large for a page
+            bool standalone = false;
+            /// @brief Whether nothing else gets packed onto it (e.g. about
+            /// to be evicted)
+            bool sealed = false;
+        };
+
+        /// @brief Width and height of every page
+        int _pageSize;
+
+        /// @brief Pages opened so far (along with textures too large for a
+        /// page, kept on their own)
+        std::vector<Page> _pages;
+
+        /// @brief Bytes of pixels held by every page
+        std::size_t _bytes = 0;
+
+        /// @brief Open a page onto a texture, accounting for its size
+        /// @param texture Texture created for the page
+        /// @param evictable Whether its regions may be evicted
+        /// @return Opened page
+        Page& Open(SDL_Texture* texture, bool evictable);
+
+        /// @brief Fill a newly created page with transparent pixels
+        /// @param texture Texture created for the page
+        /// @return True if cleared, false otherwise (reported)
+        bool Clear(SDL_Texture* texture);
+
+        /// @brief Reserve a spot of a given size within a page
+        /// @param page Page to reserve onto
+        /// @param width Width of spot (padding included)
+        /// @param height Height of spot (padding included)
+        /// @param spot Returned-by-parameter reserved spot
+        /// @return True if reserved successfully, false if it didn't fit
+        bool Reserve(Page& page, int width, int height, SDL_Rect& spot);
+
+    public:
+        /// @brief Gap left between regions (kept transparent), so
+        /// filtering doesn't bleed
+        static constexpr int Padding = 1;
+
+        /// @brief Construct an empty atlas
+        /// @param pageSize Width and height of every page (pixels)
+        explicit TextureAtlas(int pageSize = 2048);
+
+        /// @brief Copy a surface onto some page, opening a new one if full
+        /// @param renderer Renderer to create pages with
+        /// @param surface Surface to copy from (not freed)
+        /// @param evictable Whether the region may be evicted later on
+        /// (pinned otherwise)
+        /// @return Handle to the packed region, or an empty handle on error
+        TextureRegion Pack(SDL_Renderer* renderer, SDL_Surface* surface,
+            bool evictable = false);
+
+        /// @brief Amount of textures created (pages and standalone ones)
+        size_t Textures() const;
+
+        /// @brief Bytes of pixels held by every texture
+        std::size_t Bytes() const;
+
+        /// @brief Texture of a page
+        /// @param page Position of the page, below Textures()
+        SDL_Texture* TextureAt(std::size_t page) const;
+
+        /// @brief Bytes of pixels held by a page
+        /// @param page Position of the page, below Textures()
+        std::size_t BytesAt(std::size_t page) const;
+
+        /// @brief Whether a page may be evicted (holding evictable regions
+        /// alone, and not sealed for eviction already)
+        /// @param page Position of the page, below Textures()
+        bool Evictable(std::size_t page) const;
+
+        /// @brief Stop packing onto a page (e.g. until evicted)
+        /// @param texture Texture of the page
+        void Seal(SDL_Texture* texture);
+
+        /// @brief Destroy a page, along with every region on it
+        /// @param texture Texture of the page
+        /// @return Bytes of pixels freed (zero if not a page)
+        /// @remark Nothing may draw from it anymore
+        std::size_t Evict(SDL_Texture* texture);
+};
@@ -3,15 +3,18 @@
 // Error throwing
 #include <stdexcept>
 
+// Instanced drawing
+#include "Services/GLRenderBackend.hpp"
+
 // Error output
 #include <SDL_log.h>
 #include <stdio.h>
-#include "WindowService.hpp"
 
 WindowService::WindowService(
     unsigned width, unsigned height, unsigned framerate, 
-    SDL_Color bgColor, const char *name): 
-_size(width, height) {
+    SDL_Color bgColor, const char *name, bool vsync): 
+_size(width, height), _viewport{{0, 0}, glm::dvec2(_size)}, _vsync(vsync),
+_commands(std::make_unique<DrawCommandBuffer>()) {
     // Create window with given size on the middle of the screen
     _window.reset(
         SDL_CreateWindow(
@@ -25,9 +28,11 @@ _size(width, height) {
         throw std::runtime_error("Unable to create window");
     }
 
-    // Create a renderer for said window
+    // Create a renderer for said window (in step with vertical sync
+    // if requested)
     _renderer.reset(
-        SDL_CreateRenderer(_window.get(), -1, SDL_RENDERER_ACCELERATED)
+        SDL_CreateRenderer(_window.get(), -1, SDL_RENDERER_ACCELERATED |
+            (vsync ? SDL_RENDERER_PRESENTVSYNC : 0))
     );
 
     if (_renderer == nullptr) {
@@ -35,6 +40,9 @@ _size(width, height) {
         throw std::runtime_error("Unable to create window renderer");
     }
 
+    // Draw through it by default
+    _backend = std::make_unique<SDLRenderBackend>(_renderer.get());
+
     // Assign the selected background color to it
     if (
         SDL_SetRenderDrawColor(_renderer.get(), 
@@ -46,32 +54,56 @@ _size(width, height) {
     // Clear screen anticipating next drawing calls
     SDL_RenderClear(_renderer.get());
 
+    // Follow the display's refresh rate while in vertical sync, since
+    // committing any faster would only get frames dropped
+    SDL_DisplayMode displayMode;
+    if (vsync && SDL_GetWindowDisplayMode(_window.get(), &displayMode) == 0
+        && displayMode.refresh_rate > 0) {
+        framerate = displayMode.refresh_rate;
+    }
+
     // Compute the milliseconds between frames
     _msPerFrame = 1000.0 / framerate;
 }
 
+WindowService::WindowService(const glm::uvec2 &size):
+_size(size), _viewport{{0, 0}, glm::dvec2(size)}, _msPerFrame(0), _commands(std::make_unique<DrawCommandBuffer>())
+{}
+
 WindowService::WindowService(WindowService &&other):
-    _size(other._size), _sinceCommit(other._sinceCommit),
+    _size(other._size), _viewport(other._viewport), _sinceCommit(other._sinceCommit),
     _msPerFrame(other._msPerFrame), _texturesPushed(other._texturesPushed),
     _onDrawFrame(other._onDrawFrame)
 {
-    // Steal the other window service's window and renderer
+    // Steal the other window service's window, renderer and commands
     _window = std::move(other._window);
     _renderer = std::move(other._renderer);
+    _backend = std::move(other._backend);
+    _commands = std::move(other._commands);
+    _vsync = other._vsync;
+    _presented = other._presented;
+    _textureUse = std::move(other._textureUse);
 }
 
 WindowService::~WindowService()
 {}
 
 WindowService& WindowService::operator=(WindowService &&other) {
-    // Steal the other window service's window and renderer
+    // Steal the other window service's window, renderer and commands
+    // (releasing the current backend before the renderer it draws with)
+    _backend = std::move(other._backend);
     _window = std::move(other._window);
     _renderer = std::move(other._renderer);
+    _commands = std::move(other._commands);
+    _presented = other._presented;
+    _textureUse = std::move(other._textureUse);
 
     // Keep track of its other statistics
     _size = other._size;
+    _viewport = other._viewport;
     _sinceCommit = other._sinceCommit;
     _msPerFrame = other._msPerFrame;
+    _vsync = other._vsync;
     _texturesPushed = other._texturesPushed;
     _onDrawFrame = other._onDrawFrame;
 
@@ -81,8 +113,25 @@ WindowService& WindowService::operator=(WindowService &&other) {
 const glm::uvec2 &WindowService::Size() const
 { return _size; }
 
+const Viewport &WindowService::View() const
+{ return _viewport; }
+
+void WindowService::MoveCamera(const glm::dvec2 &origin)
+{ _viewport.origin = origin; }
+
+bool WindowService::Headless() const
+{ return _renderer == nullptr; }
+
+bool WindowService::VSync() const
+{ return _vsync; }
+
 bool WindowService::AcquireDrawFrame()
 {
+    // Nothing gets drawn without a renderer
+    if (Headless()) {
+        return false;
+    }
+
     if ((SDL_GetTicks64() - _sinceCommit) >= _msPerFrame) {
         _onDrawFrame = true;
     }
@@ -96,7 +145,7 @@ bool WindowService::OnDrawFrame() const
 size_t WindowService::Pushed() const
 { return _texturesPushed; }
 
-bool WindowService::PushTexture(SDL_Texture *texture, 
+bool WindowService::PushTexture(const TextureRegion &texture, 
     const SDL_Rect &rect, double angle) {
     // Enforce being on a draw frame to call
     if (!_onDrawFrame) {
@@ -108,19 +157,58 @@ bool WindowService::PushTexture(SDL_Texture *texture,
         return false;
     }
 
-    // Attempt to queue drawing the texture rect and
-    // report any errors
-    if (SDL_RenderCopyEx(_renderer.get(), texture, NULL, &rect, 
-        angle, NULL, SDL_FLIP_NONE) != 0) {
-        SDL_Log("SDL_RenderCopy error: %s\n", SDL_GetError());
+    // Empty regions (unknown assets, failed loads, or the placeholder
+    // before it's uploaded) draw as nothing at all
+    if (!texture || texture.region.w <= 0 || texture.region.h <= 0) {
         return false;
     }
 
-    // Otherwise, update pushed statistic
+    // Record drawing the texture rect for the rendering thread
+    _commands->Back().push_back(
+        DrawCommand{texture.page, texture.region, rect, angle}
+    );
+
+    // Update pushed statistic
     _texturesPushed += 1;
     return true;
 }
 
+bool WindowService::PushText(const GlyphCache &glyphs,
+    std::string_view text, const SDL_Point &origin) {
+    // Enforce being on a draw frame to call
+    if (!_onDrawFrame) {
+        fprintf(
+            stderr, 
+            "WindowService: PushText called but not on draw frame\n"
+        );
+
+        return false;
+    }
+
+    // Record a quad per visible glyph, moving the pen along
+    int pen = origin.x;
+    for (char character : text) {
+        const Glyph* glyph = glyphs.Find(character);
+        if (glyph == nullptr) {
+            continue;
+        }
+
+        if (glyph->texture) {
+            const SDL_Rect& region = glyph->texture.region;
+            _commands->Back().push_back(DrawCommand{
+                glyph->texture.page, region,
+                SDL_Rect{pen, origin.y, region.w, region.h}, 0
+            });
+
+            _texturesPushed += 1;
+        }
+
+        pen += glyph->advance;
+    }
+
+    return true;
+}
+
 void WindowService::Commit() {
     // Enforce being on a draw frame to call
     if (!_onDrawFrame) {
@@ -132,11 +220,8 @@ void WindowService::Commit() {
         return;
     }
 
-    // Apply back-buffer to main buffer
-    SDL_RenderPresent(_renderer.get());
-
-    // Clear screen anticipating next drawing calls
-    SDL_RenderClear(_renderer.get());
+    // Publish the recorded commands to the rendering thread
+    _commands->Publish();
 
     // Update commit timestamp and pushed statistic
     _sinceCommit = SDL_GetTicks64();
@@ -145,3 +230,80 @@ void WindowService::Commit() {
     // Release draw frame permit
     _onDrawFrame = false;
 }
+
+bool WindowService::Present() {
+    // Skip if nothing new was committed since the last frame
+    const std::vector<DrawCommand>* commands = _commands->Acquire();
+    if (commands == nullptr) {
+        return false;
+    }
+
+    // Stamp textures with the commit being presented
+    _presented = _commands->Sequence();
+
+    // Clear screen anticipating drawing calls
+    SDL_RenderClear(_renderer.get());
+
+    // Replay every recorded drawing, stamping the textures drawn from
+    _drawn.clear();
+    _drawCalls = _backend->Draw(*commands, _drawn);
+
+    for (SDL_Texture* texture : _drawn) {
+        StampTexture(texture);
+    }
+
+    // Apply back-buffer to main buffer
+    SDL_RenderPresent(_renderer.get());
+    return true;
+}
+
+void WindowService::SetBatching(bool batching) {
+    if (_backend != nullptr) {
+        _backend->SetBatching(batching);
+    }
+}
+
+bool WindowService::UseInstancing() {
+    if (Headless()) {
+        return false;
+    }
+
+    // Keep drawing through SDL_Renderer if unable to
+    try {
+        _backend = std::make_unique<GLRenderBackend>(_renderer.get());
+    } catch (const std::exception& e) {
+        fprintf(
+            stderr,
+            "WindowService: UseInstancing falling back onto SDL_Renderer " \
+            "(%s)\n",
+            e.what()
+        );
+
+        return false;
+    }
+
+    return true;
+}
+
+const char *WindowService::Backend() const
+{ return _backend != nullptr ? _backend->Name() : ""; }
+
+size_t WindowService::DrawCalls() const
+{ return _drawCalls; }
+
+std::uint64_t WindowService::Committed() const
+{ return _commands->Published(); }
+
+std::uint64_t WindowService::Presented() const
+{ return _presented; }
+
+std::uint64_t WindowService::LastDrawn(SDL_Texture *texture) const {
+    const auto found = _textureUse.find(texture);
+    return found != _textureUse.end() ? found->second : 0;
+}
+
+void WindowService::StampTexture(SDL_Texture *texture)
+{ _textureUse[texture] = _presented; }
+
+void WindowService::ForgetTexture(SDL_Texture *texture)
+{ _textureUse.erase(texture); }
@@ -17,6 +17,25 @@
 
 // Memory safe container for resources
 #include "Utils/MemoryAliases.hpp"
+#include <memory>
+#include <vector>
+
+// Texture use stamps
+#include <cstdint>
+#include <unordered_map>
+
+// Draw command hand-over between threads
+#include "Services/DrawCommands.hpp"
+
+// Ways of drawing the handed over commands
+#include "Services/RenderBackend.hpp"
+
+// Texture region handles
+#include "Services/TextureAtlas.hpp"
+
+// Per-glyph text layout
+#include "Services/GlyphCache.hpp"
+#include <string_view>
 
 // Provide friendly access for asset store
 #include "Services/AssetStore.hpp" 
@@ -24,7 +43,32 @@
 // Forward declaration required (circular dependency)
 class AssetStore;
 
+/// @brief Area of the world shown on a window (in world coordinates)
+struct Viewport {
+    /// @brief Top-left corner coordinates
+    glm::dvec2 origin;
+    /// @brief Width and height
+    glm::dvec2 size;
+
+    /// @brief Whether a box overlaps the viewport
+    /// @param center Center coordinates of the box
+    /// @param extent Half of the width and height of the box
+    inline bool Overlaps(const glm::dvec2& center, const glm::dvec2& extent) const {
+        return
+            center.x + extent.x >= origin.x && center.x - extent.x <= origin.x + size.x &&
+            center.y + extent.y >= origin.y && center.y - extent.y <= origin.y + size.y;
+    }
+};
+
 /// @brief Window lifetime & drawing service 
+/// @remark Drawing is split between two threads: the simulation records
+/// draw commands (PushTexture, Commit), while the thread owning the
+/// renderer replays the latest committed ones (Present) through a render
+/// backend (SDL_Renderer by default, see UseInstancing()). Headless windows
+/// have no SDL window nor renderer: they only keep their size, and never
+/// acquire draw frames (so every drawing gets discarded). Drawings are
+/// pushed in window coordinates, while a camera picks the area of the world
+/// (the viewport) the window shows
 class WindowService : public Service {
     friend class AssetStore;
     private:
@@ -34,16 +78,41 @@ class WindowService : public Service {
         /// @brief Window renderer used across drawings
         Memory::unique_ptr_with_deleter<SDL_Renderer, SDL_DestroyRenderer>
         _renderer = nullptr;
+        /// @brief Backend replaying drawings (released before the renderer)
+        std::unique_ptr<RenderBackend> _backend;
         /// @brief Window width and height
         glm::uvec2 _size{0,0};
+        /// @brief Area of the world shown
+        Viewport _viewport{{0, 0}, {0, 0}};
         /// @brief If acquired a draw frame before a commit call 
         bool _onDrawFrame = false;
         /// @brief Millisecond timestamp for last draw commit call
         Uint64 _sinceCommit = 0;
         /// @brief Milliseconds between frame (for framerate)
         Uint64 _msPerFrame;
+        /// @brief Whether presenting waits for the display's vertical sync
+        bool _vsync = false;
         /// @brief Textures pushed before latest commit call
         size_t _texturesPushed = 0;
+        /// @brief Draw commands handed over to the rendering thread
+        std::unique_ptr<DrawCommandBuffer> _commands;
+        /// @brief Draw calls issued on the latest presented frame
+        size_t _drawCalls = 0;
+        /// @brief Textures drawn from on the latest presented frame
+        std::vector<SDL_Texture*> _drawn;
+        /// @brief Commit number of the latest presented frame
+        std::uint64_t _presented = 0;
+        /// @brief Commit number of the latest presented frame drawing from
+        /// each texture (render thread only)
+        std::unordered_map<SDL_Texture*, std::uint64_t> _textureUse;
+
+        /// @brief Stamp a texture as drawn on the frame being presented
+        /// @param texture Texture drawn from
+        void StampTexture(SDL_Texture* texture);
+
+        /// @brief Forget the stamp of a texture about to be destroyed
+        /// @param texture Texture to forget
+        void ForgetTexture(SDL_Texture* texture);
 
     public:
         /// @brief Construct a window
@@ -52,13 +121,22 @@ class WindowService : public Service {
         /// @param framerate Frames per second between rendering
         /// @param bgColor Color (RGBA)
         /// @param name Title name of the window (cstring)
+        /// @param vsync Whether to present in step with the display's
+        /// vertical sync (the framerate then follows the display's refresh
+        /// rate, if known)
         WindowService(
             unsigned width, unsigned height,
             unsigned framerate, 
             SDL_Color bgColor = SDL_Color{0, 0, 0}, 
-            const char* name = "New window"
+            const char* name = "New window",
+            bool vsync = false
         );
 
+        /// @brief Construct a headless window (no SDL window nor renderer,
+        /// so SDL's video subsystem isn't needed)
+        /// @param size Width and height (pixels) to simulate within
+        explicit WindowService(const glm::uvec2& size);
+
         /// @brief Construct a window by stealing the resources of another
         /// @param other Window to take underlying resources from
         WindowService(WindowService&& other);
@@ -75,6 +153,24 @@ class WindowService : public Service {
         /// @return 2D vector of width and height
         const glm::uvec2& Size() const;
 
+        /// @brief Get the area of the world currently shown
+        const Viewport& View() const;
+
+        /// @brief Move the camera so the window shows another area of the
+        /// world (same size as the window)
+        /// @param origin World coordinates of the top-left corner to show
+        /// @remark Takes effect on drawings pushed from then on
+        void MoveCamera(const glm::dvec2& origin);
+
+        /// @brief Whether the window is headless (e.g. nothing gets drawn,
+        /// and no textures may be created for it)
+        bool Headless() const;
+
+        /// @brief Whether presenting waits for the display's vertical sync
+        /// @remark If so, Present blocks the rendering thread until the
+        /// next refresh, pacing it without spinning
+        bool VSync() const;
+
         /// @brief Attempt to acquire the current frame as a draw frame
         /// @return True if conditions hold and a draw frame was acquired,
         /// false otherwise
@@ -90,16 +186,71 @@ class WindowService : public Service {
         size_t Pushed() const;
 
         /// @brief Queue a texture rect drawing to the underlying window
-        /// @param texture Texture to draw from
+        /// @param texture Texture region to draw from
         /// @param rect Destination rect coordinates
         /// @param angle Angle (in degrees) to rotate texture at
-        /// @return True if drawn succesfully, false otherwise
-        bool PushTexture(SDL_Texture* texture, const SDL_Rect& rect, double angle);
+        /// @return True if queued succesfully, false otherwise (e.g. for
+        /// empty regions, which draw nothing)
+        /// @remark Only records a draw command, no SDL call is made
+        bool PushTexture(const TextureRegion& texture, const SDL_Rect& rect, double angle);
 
-        /// @brief Apply the queue drawings to the current view
-        /// @param stopwatch Stopwatch service to check timer from
-        /// @return True if applied succesfully, false otherwise
+        /// @brief Queue a text drawing to the underlying window, one
+        /// glyph at a time
+        /// @param glyphs Glyphs to lay the text out with
+        /// @param text Text to draw (uncached glyphs are skipped)
+        /// @param origin Top-left coordinates of the text
+        /// @return True if queued succesfully, false otherwise
+        bool PushText(const GlyphCache& glyphs, std::string_view text,
+            const SDL_Point& origin);
+
+        /// @brief Hand the queued drawings over to the rendering thread
         void Commit();
+
+        /// @brief Set whether presented drawings are batched per texture
+        /// @param batching True to batch (the default), false to issue a
+        /// draw call per drawing
+        /// @remark Only takes effect on the thread calling Present, and
+        /// only through SDL_Renderer (instancing always batches)
+        void SetBatching(bool batching);
+
+        /// @brief Replay drawings through instanced OpenGL draw calls
+        /// (one per texture), falling back onto SDL_Renderer if unable
+        /// @return True if drawing through instancing, false otherwise
+        /// @remark Must be called from the thread that created the window.
+        /// Requires SDL's OpenGL renderer driver, so the render driver hint
+        /// should ask for "opengl" before creating the window
+        bool UseInstancing();
+
+        /// @brief Get the name of the backend replaying drawings (empty
+        /// if headless)
+        const char* Backend() const;
+
+        /// @brief Get the amount of draw calls issued on the latest
+        /// presented frame
+        size_t DrawCalls() const;
+
+        /// @brief Get the amount of frames committed so far (commit number
+        /// of the latest one)
+        /// @remark Only from the thread committing
+        std::uint64_t Committed() const;
+
+        /// @brief Get the commit number of the latest presented frame
+        /// (zero if none yet)
+        /// @remark Only from the thread calling Present
+        std::uint64_t Presented() const;
+
+        /// @brief Get the commit number of the latest presented frame that
+        /// drew from a given texture
+        /// @param texture Texture to look up
+        /// @return Commit number, or zero if never drawn from
+        /// @remark Only from the thread calling Present
+        std::uint64_t LastDrawn(SDL_Texture* texture) const;
+
+        /// @brief Draw and present the latest committed drawings, if any
+        /// were committed since the last call
+        /// @return True if a new frame was presented, false otherwise
+        /// @remark Must be called from the thread that created the window
+        bool Present();
 };
 
 static_assert(
@@ -0,0 +1,269 @@
+#include "Systems/PhysicsKernel.hpp"
+
+// Scalar math
+#include <cmath>
+#include <numbers>
+
+// Instruction set picked at build time (see Systems/CMakeLists.txt)
+#if !defined(GAME_SIMD_SCALAR) && defined(__AVX2__)
+    #define PHYSICS_KERNEL_AVX2
+    #include <immintrin.h>
+#elif !defined(GAME_SIMD_SCALAR) && defined(__ARM_NEON) && defined(__aarch64__)
+    #define PHYSICS_KERNEL_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace {
+    /// @brief Gap left between a bounced body and the border
+    constexpr double BorderGap = 5.0;
+
+    /// @brief Bring an angle within [0, 360] degrees
+    inline void WrapAngle(double& angle) {
+        if (angle < 0 || angle > 360.0) {
+            angle = std::fmod(angle, 360.0);
+            if (angle < 0) { angle += 360.0; }
+        }
+    }
+
+    /// @brief Absolute cosine and sine of a body's angle
+    inline void Orientation(Physics& body, double& cosine, double& sine) {
+        WrapAngle(body.angle);
+        const double radians = (body.angle * std::numbers::pi) / 180.0;
+        cosine = std::abs(std::cos(radians));
+        sine = std::abs(std::sin(radians));
+    }
+
+    /// @brief Offset a single axis needs to get back within bounds
+    /// @param low Lowest coordinate of the box along the axis
+    /// @param high Highest coordinate of the box along the axis
+    /// @param bound Window size along the axis
+    /// @param collides Returned-by-parameter whether it is out of bounds
+    inline double BorderOffset(double low, double high, double bound, bool& collides) {
+        const double lowOffset = low < 0 ? BorderGap - low : 0;
+        const double highOffset = high > bound ? bound - high - BorderGap : 0;
+
+        collides = low < 0 || high > bound;
+        return std::abs(lowOffset) >= std::abs(highOffset) ? lowOffset : highOffset;
+    }
+
+    /// @brief Integrate a single body (scalar path, also used for the
+    /// remainder of vectorized batches)
+    inline void IntegrateBody(Physics& body, double width, double height, double delta) {
+        double cosine, sine;
+        Orientation(body, cosine, sine);
+
+        const double halfWidth = body.size.x / 2.0, halfHeight = body.size.y / 2.0;
+        const double extentX = cosine * halfWidth + sine * halfHeight;
+        const double extentY = sine * halfWidth + cosine * halfHeight;
+
+        glm::dvec2& position = body.position;
+        glm::dvec2& velocity = body.velocity;
+
+        bool collidesX, collidesY;
+        const double offsetX = BorderOffset(
+            position.x - extentX, position.x + extentX, width, collidesX);
+        const double offsetY = BorderOffset(
+            position.y - extentY, position.y + extentY, height, collidesY);
+
+        if (collidesX) { velocity.x *= -1; }
+        if (collidesY) { velocity.y *= -1; }
+
+        position.x += velocity.x * delta + offsetX;
+        position.y += velocity.y * delta + offsetY;
+    }
+
+#if defined(PHYSICS_KERNEL_AVX2)
+    /// @brief Lanes per vector
+    constexpr std::size_t Lanes = 4;
+
+    /// @brief Offset a single axis needs to get back within bounds, and
+    /// velocity flipped if out of bounds
+    inline __m256d BorderOffset(__m256d position, __m256d extent,
+        __m256d bound, __m256d& velocity) {
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d gap = _mm256_set1_pd(BorderGap);
+        const __m256d signBit = _mm256_set1_pd(-0.0);
+
+        const __m256d low = _mm256_sub_pd(position, extent);
+        const __m256d high = _mm256_add_pd(position, extent);
+
+        const __m256d lowOut = _mm256_cmp_pd(low, zero, _CMP_LT_OQ);
+        const __m256d highOut = _mm256_cmp_pd(high, bound, _CMP_GT_OQ);
+
+        const __m256d lowOffset = _mm256_and_pd(lowOut, _mm256_sub_pd(gap, low));
+        const __m256d highOffset = _mm256_and_pd(highOut,
+            _mm256_sub_pd(_mm256_sub_pd(bound, high), gap));
+
+        // Keep the greatest offset
+        const __m256d keepLow = _mm256_cmp_pd(
+            _mm256_andnot_pd(signBit, lowOffset),
+            _mm256_andnot_pd(signBit, highOffset), _CMP_GE_OQ);
+
+        // Flip the velocity's sign on collision
+        velocity = _mm256_xor_pd(velocity,
+            _mm256_and_pd(_mm256_or_pd(lowOut, highOut), signBit));
+
+        return _mm256_blendv_pd(highOffset, lowOffset, keepLow);
+    }
+
+    /// @brief Integrate a group of bodies, one per lane
+    inline void IntegrateLanes(Physics* bodies, __m256d width, __m256d height,
+        __m256d delta) {
+        alignas(32) double px[Lanes], py[Lanes], vx[Lanes], vy[Lanes];
+        alignas(32) double hw[Lanes], hh[Lanes], cs[Lanes], sn[Lanes];
+
+        // Gather (sine and cosine stay scalar, once per body)
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+            Physics& body = bodies[lane];
+            Orientation(body, cs[lane], sn[lane]);
+
+            px[lane] = body.position.x; py[lane] = body.position.y;
+            vx[lane] = body.velocity.x; vy[lane] = body.velocity.y;
+            hw[lane] = body.size.x / 2.0; hh[lane] = body.size.y / 2.0;
+        }
+
+        const __m256d cosine = _mm256_load_pd(cs), sine = _mm256_load_pd(sn);
+        const __m256d halfWidth = _mm256_load_pd(hw), halfHeight = _mm256_load_pd(hh);
+        __m256d positionX = _mm256_load_pd(px), positionY = _mm256_load_pd(py);
+        __m256d velocityX = _mm256_load_pd(vx), velocityY = _mm256_load_pd(vy);
+
+        const __m256d extentX = _mm256_add_pd(
+            _mm256_mul_pd(cosine, halfWidth), _mm256_mul_pd(sine, halfHeight));
+        const __m256d extentY = _mm256_add_pd(
+            _mm256_mul_pd(sine, halfWidth), _mm256_mul_pd(cosine, halfHeight));
+
+        const __m256d offsetX = BorderOffset(positionX, extentX, width, velocityX);
+        const __m256d offsetY = BorderOffset(positionY, extentY, height, velocityY);
+
+        positionX = _mm256_add_pd(positionX,
+            _mm256_add_pd(_mm256_mul_pd(velocityX, delta), offsetX));
+        positionY = _mm256_add_pd(positionY,
+            _mm256_add_pd(_mm256_mul_pd(velocityY, delta), offsetY));
+
+        // Scatter
+        _mm256_store_pd(px, positionX); _mm256_store_pd(py, positionY);
+        _mm256_store_pd(vx, velocityX); _mm256_store_pd(vy, velocityY);
+
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+            Physics& body = bodies[lane];
+            body.position = {px[lane], py[lane]};
+            body.velocity = {vx[lane], vy[lane]};
+        }
+    }
+#elif defined(PHYSICS_KERNEL_NEON)
+    /// @brief Lanes per vector
+    constexpr std::size_t Lanes = 2;
+
+    /// @brief Offset a single axis needs to get back within bounds, and
+    /// velocity flipped if out of bounds
+    inline float64x2_t BorderOffset(float64x2_t position, float64x2_t extent,
+        float64x2_t bound, float64x2_t& velocity) {
+        const float64x2_t zero = vdupq_n_f64(0.0);
+        const float64x2_t gap = vdupq_n_f64(BorderGap);
+        const uint64x2_t signBit = vreinterpretq_u64_f64(vdupq_n_f64(-0.0));
+
+        const float64x2_t low = vsubq_f64(position, extent);
+        const float64x2_t high = vaddq_f64(position, extent);
+
+        const uint64x2_t lowOut = vcltq_f64(low, zero);
+        const uint64x2_t highOut = vcgtq_f64(high, bound);
+
+        const float64x2_t lowOffset = vbslq_f64(lowOut, vsubq_f64(gap, low), zero);
+        const float64x2_t highOffset = vbslq_f64(highOut,
+            vsubq_f64(vsubq_f64(bound, high), gap), zero);
+
+        // Keep the greatest offset
+        const uint64x2_t keepLow = vcgeq_f64(vabsq_f64(lowOffset), vabsq_f64(highOffset));
+
+        // Flip the velocity's sign on collision
+        velocity = vreinterpretq_f64_u64(veorq_u64(vreinterpretq_u64_f64(velocity),
+            vandq_u64(vorrq_u64(lowOut, highOut), signBit)));
+
+        return vbslq_f64(keepLow, lowOffset, highOffset);
+    }
+
+    /// @brief Integrate a group of bodies, one per lane
+    inline void IntegrateLanes(Physics* bodies, float64x2_t width, float64x2_t height,
+        float64x2_t delta) {
+        double px[Lanes], py[Lanes], vx[Lanes], vy[Lanes];
+        double hw[Lanes], hh[Lanes], cs[Lanes], sn[Lanes];
+
+        // Gather (sine and cosine stay scalar, once per body)
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+            Physics& body = bodies[lane];
+            Orientation(body, cs[lane], sn[lane]);
+
+            px[lane] = body.position.x; py[lane] = body.position.y;
+            vx[lane] = body.velocity.x; vy[lane] = body.velocity.y;
+            hw[lane] = body.size.x / 2.0; hh[lane] = body.size.y / 2.0;
+        }
+
+        const float64x2_t cosine = vld1q_f64(cs), sine = vld1q_f64(sn);
+        const float64x2_t halfWidth = vld1q_f64(hw), halfHeight = vld1q_f64(hh);
+        float64x2_t positionX = vld1q_f64(px), positionY = vld1q_f64(py);
+        float64x2_t velocityX = vld1q_f64(vx), velocityY = vld1q_f64(vy);
+
+        // (Unfused, and in the scalar path's order, so rounding matches it)
+        const float64x2_t extentX = vaddq_f64(
+            vmulq_f64(cosine, halfWidth), vmulq_f64(sine, halfHeight));
+        const float64x2_t extentY = vaddq_f64(
+            vmulq_f64(sine, halfWidth), vmulq_f64(cosine, halfHeight));
+
+        const float64x2_t offsetX = BorderOffset(positionX, extentX, width, velocityX);
+        const float64x2_t offsetY = BorderOffset(positionY, extentY, height, velocityY);
+
+        positionX = vaddq_f64(positionX,
+            vaddq_f64(vmulq_f64(velocityX, delta), offsetX));
+        positionY = vaddq_f64(positionY,
+            vaddq_f64(vmulq_f64(velocityY, delta), offsetY));
+
+        // Scatter
+        vst1q_f64(px, positionX); vst1q_f64(py, positionY);
+        vst1q_f64(vx, velocityX); vst1q_f64(vy, velocityY);
+
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+            Physics& body = bodies[lane];
+            body.position = {px[lane], py[lane]};
+            body.velocity = {vx[lane], vy[lane]};
+        }
+    }
+#endif
+}
+
+const char* PhysicsKernelTarget() {
+#if defined(PHYSICS_KERNEL_AVX2)
+    return "AVX2";
+#elif defined(PHYSICS_KERNEL_NEON)
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
+
+void IntegratePhysics(std::span<Physics> bodies,
+    const glm::uvec2& bounds, double delta) {
+    const double width = bounds.x, height = bounds.y;
+    std::size_t which = 0;
+
+    // Whole groups of lanes first...
+#if defined(PHYSICS_KERNEL_AVX2)
+    const __m256d widths = _mm256_set1_pd(width), heights = _mm256_set1_pd(height);
+    const __m256d deltas = _mm256_set1_pd(delta);
+
+    for (; which + Lanes <= bodies.size(); which += Lanes) {
+        IntegrateLanes(&bodies[which], widths, heights, deltas);
+    }
+#elif defined(PHYSICS_KERNEL_NEON)
+    const float64x2_t widths = vdupq_n_f64(width), heights = vdupq_n_f64(height);
+    const float64x2_t deltas = vdupq_n_f64(delta);
+
+    for (; which + Lanes <= bodies.size(); which += Lanes) {
+        IntegrateLanes(&bodies[which], widths, heights, deltas);
+    }
+#endif
+
+    // ... Then the remainder, one at a time
+    for (; which < bodies.size(); ++which) {
+        IntegrateBody(bodies[which], width, height, delta);
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+// Physics component
+#include "Components/Physics.hpp"
+
+// GLM vector math
+#include <glm/vec2.hpp>
+
+// Contiguous batches
+#include <span>
+
+/// @brief Instruction set the physics kernel was built for
+/// @return Name of the instruction set ("AVX2", "NEON" or "Scalar")
+const char* PhysicsKernelTarget();
+
+/// @brief Integrate a batch of bodies, bouncing them off the window borders
+/// @param bodies Densely-packed bodies to update
+/// @param bounds Width and height of the window
+/// @param delta Time step to scale velocities by
+/// @remark Each body's rotated box is bounded by its half-extents
+/// (|cos|*w + |sin|*h, |sin|*w + |cos|*h) / 2, so sine and cosine are
+/// computed once per body and the corners are never built. Lanes are
+/// gathered from the bodies in groups (4 on AVX2, 2 on NEON), and bounces
+/// are resolved with masks instead of branches. Every path multiplies and
+/// adds unfused, in the same order, so results match the scalar path bit
+/// for bit
+void IntegratePhysics(std::span<Physics> bodies,
+    const glm::uvec2& bounds, double delta);
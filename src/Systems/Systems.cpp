@@ -1,6 +1,9 @@
 // System's base definition
 #include "Systems/Systems.hpp"
 
+// Vectorized physics integration
+#include "Systems/PhysicsKernel.hpp"
+
 // Auxilary rotation math
 #include <cmath>
 
@@ -11,106 +14,94 @@
 #include <iostream>
 
 void PhysicsSystem(
-    std::tuple<Physics&> components, 
+    std::span<Physics> components, 
     std::tuple<const WindowService&, const StopwatchService&> services
 ) {
-    // Capture component and services
-    Physics& physicsComponent = std::get<0>(components);
+    // Capture services
     const WindowService& windowService = std::get<0>(services);
     const StopwatchService& stopwatch = std::get<1>(services);
 
-    
-    // For sanity, lets constraint the angle on edge cases
-    double& angle = physicsComponent.angle;
-    if (angle < 0 || angle > 360.0) {
-        angle = std::fmod(angle, 360.0);
-        if (angle < 0) { angle = + 360.0; }
-    }
-
-    // Get corners based on size...
-    const glm::dvec2 size = physicsComponent.size;
-
-    glm::dvec2 corners[4];
-    corners[0] = size / glm::dvec2{-2, -2};
-    corners[1] = size / glm::dvec2{2, -2};
-    corners[2] = size / glm::dvec2{-2, 2};
-    corners[3] = size / glm::dvec2{2, 2};
-
-    // Rotation...
-    const double radians = (angle * std::numbers::pi) / 180.0;
-
-    for (glm::dvec2& corner : corners) {
-        corner = {
-            corner.x * std::cos(radians) - corner.y * std::sin(radians),
-            corner.x * std::sin(radians) + corner.y * std::cos(radians)
-        };
-    }
-
-    // And position
-    glm::dvec2& position = physicsComponent.position;
-
-    for (glm::dvec2& corner : corners) {
-        corner += position;
-    }
-
-    // Check if it collides on a window border, and figure
-    // out the offset required
-    const glm::uvec2& windowSize = windowService.Size();
-
-    bool collidesX = false, collidesY = false;
-    glm::dvec2 collisionOffset {0,0};
-    for (const glm::dvec2& corner : corners) {
-        if (corner.x < 0 || corner.x > windowSize.x) {
-            // Calculate X offset
-            const double cornerOffset = corner.x < 0 ? 
-                -corner.x + 5 : (windowSize.x - corner.x) - 5;
-
-            // Keep greatest offset
-            if (std::abs(cornerOffset) > 
-                std::abs(collisionOffset.x)) {
-                collisionOffset.x = cornerOffset;
+    // Update positions according to speed (pixels per second), bouncing
+    // off the window borders. We'll step through as many fixed ticks as
+    // the stopwatch banked for this sweep
+    const unsigned ticks = stopwatch.Ticks();
+
+    for (unsigned tick = 0; tick < ticks; ++tick) {
+        // Remember where bodies were before the latest tick, so drawing
+        // can blend between both
+        if (tick + 1 == ticks) {
+            for (Physics& body : components) {
+                body.previousPosition = body.position;
             }
-
-            // Make note of collision
-            collidesX = true;
         }
 
-        if (corner.y < 0 || corner.y > windowSize.y) {
-            // Calculate Y offset
-            const double cornerOffset = corner.y < 0 ? 
-                -corner.y + 5 : (windowSize.y - corner.y) - 5;
+        IntegratePhysics(components, windowService.Size(), stopwatch.Step());
+    }
+}
 
-            // Keep greatest offset
-            if (std::abs(cornerOffset) > 
-                std::abs(collisionOffset.y)) {
-                collisionOffset.y = cornerOffset;
+void CollisionSystem(
+    std::uint64_t entity,
+    std::tuple<const Physics&> components,
+    std::tuple<BroadphaseService&, const GameWorld::ManagerService&> services
+) {
+    // Capture component and services
+    const Physics& physicsComponent = std::get<0>(components);
+    BroadphaseService& broadphase = std::get<0>(services);
+    const GameWorld::ManagerService& manager = std::get<1>(services);
+
+    const std::span<const Contact> contacts = broadphase.ContactsOf(entity);
+
+    // Respond to the overlaps found on the latest detection, on a copy
+    // installed back once the sweep ends (which also wakes it up)
+    if (!contacts.empty()) {
+        Physics pushed = physicsComponent;
+        glm::dvec2& velocity = pushed.velocity;
+
+        for (const Contact& contact : contacts) {
+            const glm::dvec2& normal = contact.normal;
+
+            // Move half the way apart (the other entity moves the other
+            // half), shifting the previous position alongside so drawing
+            // doesn't blend through the other entity
+            const glm::dvec2 push = normal * (contact.depth / 2.0);
+            pushed.position -= push;
+            pushed.previousPosition -= push;
+
+            // And bounce off if still heading towards the other entity
+            const double approach = velocity.x * normal.x + velocity.y * normal.y;
+            if (approach > 0) {
+                velocity -= normal * (2.0 * approach);
             }
-
-            // Make note of collision
-            collidesY = true;
         }
+
+        manager.Commands().Install(entity, pushed);
     }
 
-    // Flip the velocty and angle if it collides
-    glm::dvec2& velocity = physicsComponent.velocity;
-    
-    if (collidesX) { velocity.x *= -1; }
-    if (collidesY) { velocity.y *= -1; }
+    // Otherwise, put bodies at rest to sleep (so physics skips them)
+    else if (
+        physicsComponent.velocity == glm::dvec2(0.0) &&
+        !manager.Asleep<Physics>(entity)
+    ) {
+        manager.Commands().Sleep<Physics>(entity);
+    }
 
-    // Update position according to speed and offset
-    // We'll scale by delta time elapsed since the last sweep
-    const double delta = stopwatch.Milliseconds() / 4.5E6;
-    position += velocity * glm::dvec2{delta, delta} + collisionOffset;
+    // Then record where it is now, for the next detection (sleeping or not)
+    broadphase.Record(
+        entity, physicsComponent.position, physicsComponent.size,
+        physicsComponent.angle
+    );
 }
 
 void DrawingSystem(
     std::tuple<const Drawing&, const Physics&> components, 
-    std::tuple<WindowService&> services
+    std::tuple<WindowService&, const AssetStore&, const StopwatchService&> services
 ) {
     // Capture component and services
     const Drawing& drawingComponent = std::get<0>(components);
     const Physics& physicsComponent = std::get<1>(components);
     WindowService& windowService = std::get<0>(services);
+    const AssetStore& assetStore = std::get<1>(services);
+    const StopwatchService& stopwatch = std::get<2>(services);
 
     // Only consider drawing if the drawing service recommends we do
     // for the current frame (saves us some slack)
@@ -118,10 +109,21 @@ void DrawingSystem(
         return;
     }
 
-    // Compute the rectangle on which to draw the entity's image...
+    // Blend the latest two ticks, by how far real time is between them
+    const double alpha = stopwatch.Alpha();
+    const glm::dvec2 worldPosition = physicsComponent.previousPosition +
+        (physicsComponent.position - physicsComponent.previousPosition) * alpha;
+
+    // Skip entities entirely out of view, before building anything
+    const Viewport& viewport = windowService.View();
+    if (!viewport.Overlaps(worldPosition, drawingComponent.extent)) {
+        return;
+    }
+
+    // Compute the rectangle on which to draw the entity's image (relative
+    // to the camera)...
+    const glm::dvec2 position = worldPosition - viewport.origin;
     const glm::uvec2& imageSize = drawingComponent.imageSize;
-    const glm::uvec2& textSize = drawingComponent.textSize;
-    const glm::dvec2& position = physicsComponent.position;
 
     const SDL_Rect imageBounds{
         .x = (int) (position.x - (imageSize.x / 2.0)),
@@ -130,25 +132,18 @@ void DrawingSystem(
         .h = (int) imageSize.y
     };
 
-    // And display text
-    const SDL_Rect textBounds{
-        // Offset the horizontal position to match the image's center
-        // This keep the text nice and cented
-        .x = (int) (imageBounds.x + ((imageSize.x - textSize.x) / 2.0)),
-        // Offset the vertical position by the radius of the image 
-        // This aids in avoiding overlap regardless of rotation
-        .y = (int) (position.y + (
-                std::sqrt(std::pow(imageSize.x, 2) + std::pow(imageSize.y, 2))
-            ) / 2.0),
-        .w = (int) textSize.x,
-        .h = (int) textSize.y
+    // And display text (laid out beforehand, see Drawing::Layout())
+    const SDL_Point textOrigin{
+        .x = (int) position.x + drawingComponent.labelOffset.x,
+        .y = (int) position.y + drawingComponent.labelOffset.y
     };
 
     // Queue the drawing and text for rendering
     const double& angle = physicsComponent.angle;
-    SDL_Texture* image = drawingComponent.imageRef;
-    SDL_Texture* text = drawingComponent.textRef;
+    const TextureRegion& image = assetStore.Texture(drawingComponent.image);
 
     windowService.PushTexture(image, imageBounds, angle);
-    windowService.PushTexture(text, textBounds, 0);
+    windowService.PushText(
+        assetStore.GetGlyphs(), drawingComponent.label.data(), textOrigin
+    );
 }
@@ -3,9 +3,24 @@
 // Window rendering service
 #include "Services/WindowService.hpp"
 
+// Asset store service (for glyphs)
+#include "Services/AssetStore.hpp"
+
+// Entity-entity collision detection service
+#include "Services/BroadphaseService.hpp"
+
 // Timekeeping stopwatch service
 #include "Services/StopwatchService.hpp"
 
+// Parallel job service
+#include "Services/JobService.hpp"
+
+// Input handoff service
+#include "Services/InputService.hpp"
+
+// Configuration live-reloading service
+#include "Services/ReloadService.hpp"
+
 // Drawing component
 #include "Components/Drawing.hpp"
 
@@ -15,12 +30,39 @@
 // Parameter packing in tuple
 #include <tuple>
 
+// Contiguous component batches
+#include <span>
+
+// Entity-component systems' manager
+#include "ECS/ECS.hpp"
+
+/// @brief Components and services of the game's ECS (its systems aside,
+/// so they may take the manager service)
+using GameWorld = ECS<
+    Physics,
+    Drawing
+>::WithServices<
+    StopwatchService,
+    AssetStore,
+    WindowService,
+    JobService,
+    BroadphaseService,
+    InputService,
+    ReloadService
+>;
+
 void PhysicsSystem(
-    std::tuple<Physics&> components, 
+    std::span<Physics> components, 
     std::tuple<const WindowService&, const StopwatchService&> services
 );
 
+void CollisionSystem(
+    std::uint64_t entity,
+    std::tuple<const Physics&> components,
+    std::tuple<BroadphaseService&, const GameWorld::ManagerService&> services
+);
+
 void DrawingSystem(
     std::tuple<const Drawing&, const Physics&> components, 
-    std::tuple<WindowService&> services
+    std::tuple<WindowService&, const AssetStore&, const StopwatchService&> services
 );
@@ -0,0 +1,117 @@
+#include "Utils/FileWatch.hpp"
+
+// Write time errors and file names
+#include <string>
+#include <system_error>
+
+// File change notifications
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__linux__)
+    #define FILE_WATCH_INOTIFY
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #include <climits>
+    #include <cstring>
+#endif
+
+FileWatch::FileWatch(const std::filesystem::path &path) :
+_path(path) {
+    std::error_code error;
+    _written = std::filesystem::last_write_time(_path, error);
+
+    const std::filesystem::path directory = _path.has_parent_path() ?
+        _path.parent_path() : std::filesystem::path(".");
+
+#if defined(FILE_WATCH_INOTIFY)
+    _descriptor = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_descriptor >= 0 && ::inotify_add_watch(_descriptor,
+        directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        Close();
+    }
+#elif defined(_WIN32)
+    const HANDLE notification = ::FindFirstChangeNotificationW(directory.c_str(),
+        FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+    if (notification != INVALID_HANDLE_VALUE) {
+        _notification = notification;
+    }
+#endif
+}
+
+FileWatch::~FileWatch()
+{ Close(); }
+
+void FileWatch::Close() {
+#if defined(FILE_WATCH_INOTIFY)
+    if (_descriptor >= 0) {
+        ::close(_descriptor);
+        _descriptor = -1;
+    }
+#elif defined(_WIN32)
+    if (_notification != nullptr) {
+        ::FindCloseChangeNotification(static_cast<HANDLE>(_notification));
+        _notification = nullptr;
+    }
+#endif
+}
+
+bool FileWatch::Rewritten() {
+    std::error_code error;
+    const std::filesystem::file_time_type written =
+        std::filesystem::last_write_time(_path, error);
+
+    // Files missing midway through being replaced get seen later on
+    if (error || written == _written) {
+        return false;
+    }
+
+    _written = written;
+    return true;
+}
+
+bool FileWatch::Changed() {
+#if defined(FILE_WATCH_INOTIFY)
+    if (_descriptor >= 0) {
+        // Drain every pending event, looking for the file's name
+        alignas(inotify_event) char buffer[16 * (sizeof(inotify_event) + NAME_MAX + 1)];
+        const std::string name = _path.filename().string();
+        bool changed = false;
+
+        for (ssize_t length; (length = ::read(_descriptor, buffer, sizeof(buffer))) > 0;) {
+            for (ssize_t offset = 0; offset < length;) {
+                const inotify_event* event =
+                    reinterpret_cast<const inotify_event*>(buffer + offset);
+
+                changed = changed ||
+                    (event->len > 0 && name == event->name);
+                offset += sizeof(inotify_event) + event->len;
+            }
+        }
+
+        // (Saving the same contents still counts as a change)
+        if (changed) {
+            Rewritten();
+        }
+
+        return changed;
+    }
+#elif defined(_WIN32)
+    if (_notification != nullptr) {
+        // Something changed within the directory, so check the file
+        const HANDLE notification = static_cast<HANDLE>(_notification);
+        if (::WaitForSingleObject(notification, 0) != WAIT_OBJECT_0) {
+            return false;
+        }
+
+        ::FindNextChangeNotification(notification);
+    }
+#endif
+
+    return Rewritten();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// Paths and write times
+#include <filesystem>
+
+/// @brief Non-blocking watch over changes to a single file
+/// @remark Watches the directory holding the file rather than the file
+/// itself, so it keeps working when editors save by replacing the file.
+/// Relies on inotify on Linux and on change notifications on Windows
+/// (checked against the file's write time), and on polling the write time
+/// alone everywhere else. Platform headers stay within FileWatch.cpp
+class FileWatch {
+    private:
+        /// @brief Path to the watched file
+        std::filesystem::path _path;
+
+        /// @brief Write time of the file as of the latest change seen
+        std::filesystem::file_time_type _written{};
+
+        /// @brief Descriptor of the inotify instance (negative if unavailable)
+        int _descriptor = -1;
+
+        /// @brief Change notification over the directory, i.e. a HANDLE on
+        /// Windows (null if unavailable)
+        void* _notification = nullptr;
+
+        /// @brief Release the underlying notifications, if any
+        void Close();
+
+        /// @brief Whether the write time of the file moved since the latest
+        /// change seen (remembering it, if so)
+        bool Rewritten();
+
+    public:
+        /// @brief Start watching a given file
+        /// @param path Path to the file
+        explicit FileWatch(const std::filesystem::path& path);
+
+        FileWatch(const FileWatch&) = delete;
+        FileWatch& operator=(const FileWatch&) = delete;
+
+        /// @brief Stop watching the file
+        ~FileWatch();
+
+        /// @brief Whether the file changed since the previous check (or
+        /// since watching started)
+        /// @remark Never blocks. Several changes in between count as one
+        bool Changed();
+
+        /// @brief Path to the watched file
+        const std::filesystem::path& Path() const
+        { return _path; }
+};
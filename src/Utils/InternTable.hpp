@@ -0,0 +1,162 @@
+#pragma once
+
+// Fixed-width handles
+#include <cstddef>
+#include <cstdint>
+
+// Name storage
+#include <string_view>
+#include <vector>
+
+/// @brief Map from names onto caller-assigned 32-bit IDs, by open
+/// addressing (linear probing) over a power-of-two table
+/// @remark Names are copied onto a single flat buffer, and each entry keeps
+/// its full hash, so probing only compares names on hash matches. Entries
+/// are never erased
+class InternTable {
+    public:
+        /// @brief ID returned for names not in the table
+        static constexpr std::uint32_t Missing = UINT32_MAX;
+
+    private:
+        /// @brief Interned name, along with its ID
+        struct Entry {
+            /// @brief Full hash of the name
+            std::uint64_t hash;
+            /// @brief Offset of the name's bytes within the buffer
+            std::uint32_t offset;
+            /// @brief Length of the name
+            std::uint32_t length;
+            /// @brief ID assigned to the name
+            std::uint32_t id;
+        };
+
+        /// @brief Every interned entry, in insertion order
+        std::vector<Entry> _entries;
+
+        /// @brief Bytes of every interned name, back to back
+        std::vector<char> _bytes;
+
+        /// @brief Index plus one of the entry on each bucket (zero if empty)
+        std::vector<std::uint32_t> _buckets;
+
+        /// @brief Hash of a name (64-bit FNV-1a)
+        static std::uint64_t Hash(std::string_view name) {
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+            for (char character : name) {
+                hash ^= static_cast<unsigned char>(character);
+                hash *= 0x100000001b3ull;
+            }
+
+            return hash;
+        }
+
+        /// @brief Name of an entry
+        std::string_view NameOf(const Entry& entry) const
+        { return std::string_view(_bytes.data() + entry.offset, entry.length); }
+
+        /// @brief Find the bucket holding a name, or the empty one it would
+        /// be inserted at
+        /// @param name Name to look for
+        /// @param hash Hash of the name
+        /// @return Index of the bucket
+        std::size_t Probe(std::string_view name, std::uint64_t hash) const {
+            const std::size_t mask = _buckets.size() - 1;
+
+            for (std::size_t bucket = hash & mask;; bucket = (bucket + 1) & mask) {
+                const std::uint32_t slot = _buckets[bucket];
+                if (slot == 0) {
+                    return bucket;
+                }
+
+                const Entry& entry = _entries[slot - 1];
+                if (entry.hash == hash && NameOf(entry) == name) {
+                    return bucket;
+                }
+            }
+        }
+
+        /// @brief Change the amount of buckets, placing every entry again
+        /// @param buckets New amount of buckets (a power of two, more than
+        /// the amount of entries)
+        void Rehash(std::size_t buckets) {
+            _buckets.assign(buckets, 0);
+
+            const std::size_t mask = _buckets.size() - 1;
+            for (std::size_t which = 0; which < _entries.size(); ++which) {
+                std::size_t bucket = _entries[which].hash & mask;
+                while (_buckets[bucket] != 0) {
+                    bucket = (bucket + 1) & mask;
+                }
+
+                _buckets[bucket] = static_cast<std::uint32_t>(which + 1);
+            }
+        }
+
+    public:
+        /// @brief Look a name up
+        /// @param name Name to look for
+        /// @return ID assigned to it, or Missing if not interned
+        std::uint32_t Find(std::string_view name) const {
+            if (_buckets.empty()) {
+                return Missing;
+            }
+
+            const std::uint32_t slot = _buckets[Probe(name, Hash(name))];
+            return slot == 0 ? Missing : _entries[slot - 1].id;
+        }
+
+        /// @brief Intern a name under some ID, unless already interned
+        /// @param name Name to intern (copied)
+        /// @param id ID to assign to it
+        /// @return ID assigned to the name (the existing one, if interned
+        /// already)
+        std::uint32_t Insert(std::string_view name, std::uint32_t id) {
+            // Keep at most half of the buckets taken
+            if ((_entries.size() + 1) * 2 > _buckets.size()) {
+                Rehash(_buckets.empty() ? 16 : _buckets.size() * 2);
+            }
+
+            const std::uint64_t hash = Hash(name);
+            const std::size_t bucket = Probe(name, hash);
+
+            if (_buckets[bucket] != 0) {
+                return _entries[_buckets[bucket] - 1].id;
+            }
+
+            // Copy its bytes over, then take the bucket
+            _entries.push_back(Entry{
+                hash,
+                static_cast<std::uint32_t>(_bytes.size()),
+                static_cast<std::uint32_t>(name.size()),
+                id
+            });
+            _bytes.insert(_bytes.end(), name.begin(), name.end());
+            _buckets[bucket] = static_cast<std::uint32_t>(_entries.size());
+
+            return id;
+        }
+
+        /// @brief Whether a name is interned
+        bool Contains(std::string_view name) const
+        { return Find(name) != Missing; }
+
+        /// @brief Amount of names interned
+        std::size_t Size() const
+        { return _entries.size(); }
+
+        /// @brief Reserve room for a given amount of names
+        /// @param names Amount of names to reserve room for
+        void Reserve(std::size_t names) {
+            _entries.reserve(names);
+
+            std::size_t buckets = _buckets.empty() ? 16 : _buckets.size();
+            while (names * 2 > buckets) {
+                buckets *= 2;
+            }
+
+            if (buckets != _buckets.size()) {
+                Rehash(buckets);
+            }
+        }
+};
@@ -0,0 +1,119 @@
+#include "Utils/MappedFile.hpp"
+
+// Fallback for platforms without memory mapping
+#include <fstream>
+
+// Memory mapping
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+    #define MAPPED_FILE_POSIX
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+void MappedFile::ReadWhole(const char *path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return;
+    }
+
+    _buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(_buffer.data(), _buffer.size());
+
+    _data = _buffer.data();
+    _size = _buffer.size();
+    _open = true;
+}
+
+MappedFile::MappedFile(const char *path) {
+#if defined(MAPPED_FILE_POSIX)
+    const int descriptor = ::open(path, O_RDONLY);
+    if (descriptor < 0) {
+        return;
+    }
+
+    struct stat status;
+    const bool known = ::fstat(descriptor, &status) == 0;
+
+    if (known && status.st_size > 0) {
+        void* mapped = ::mmap(nullptr, static_cast<std::size_t>(status.st_size),
+            PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        if (mapped != MAP_FAILED) {
+            // It'll be read front to back
+            ::madvise(mapped, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+
+            _data = static_cast<const char*>(mapped);
+            _size = static_cast<std::size_t>(status.st_size);
+            _open = true;
+        }
+    } else if (known) {
+        // Empty files can't be mapped, but are valid nonetheless
+        _open = true;
+    }
+
+    // The mapping outlives the descriptor
+    ::close(descriptor);
+#elif defined(_WIN32)
+    const HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ,
+        nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    LARGE_INTEGER size;
+    const bool known = ::GetFileSizeEx(file, &size) != 0;
+
+    if (known && size.QuadPart > 0) {
+        const HANDLE mapping =
+            ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (mapping != nullptr) {
+            _data = static_cast<const char*>(
+                ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            _size = static_cast<std::size_t>(size.QuadPart);
+            _open = _data != nullptr;
+
+            if (_open) {
+                _mapping = mapping;
+            } else {
+                ::CloseHandle(mapping);
+            }
+        }
+    } else if (known) {
+        // Empty files can't be mapped, but are valid nonetheless
+        _open = true;
+    }
+
+    // The mapping outlives the file handle
+    ::CloseHandle(file);
+#endif
+
+    // Fall back to reading, if mapping wasn't possible
+    if (!_open) {
+        ReadWhole(path);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (_data == nullptr || !_buffer.empty()) {
+        return;
+    }
+
+#if defined(MAPPED_FILE_POSIX)
+    ::munmap(const_cast<char*>(_data), _size);
+#elif defined(_WIN32)
+    ::UnmapViewOfFile(_data);
+    ::CloseHandle(static_cast<HANDLE>(_mapping));
+#endif
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+// Views onto the contents
+#include <cstddef>
+#include <string_view>
+
+// Fallback for platforms without memory mapping
+#include <vector>
+
+/// @brief Read-only view onto the whole contents of a file
+/// @remark The file gets mapped onto memory where the platform allows it
+/// (so it is paged in on demand, without copies), and read onto a buffer
+/// otherwise. Platform headers stay within MappedFile.cpp
+class MappedFile {
+    private:
+        /// @brief First byte of the contents
+        const char* _data = nullptr;
+
+        /// @brief Amount of bytes of the contents
+        std::size_t _size = 0;
+
+        /// @brief Whether the file could be opened
+        bool _open = false;
+
+        /// @brief Contents read onto memory (if not mapped)
+        std::vector<char> _buffer;
+
+        /// @brief Mapping backing the view, on platforms that hand out one
+        /// (i.e. a HANDLE on Windows)
+        void* _mapping = nullptr;
+
+        /// @brief Read the whole file onto a buffer instead
+        /// @param path Path to the file
+        void ReadWhole(const char* path);
+
+    public:
+        /// @brief Open and map a given file
+        /// @param path Path to the file
+        explicit MappedFile(const char* path);
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /// @brief Unmap the file
+        ~MappedFile();
+
+        /// @brief Whether the file could be opened
+        bool IsOpen() const
+        { return _open; }
+
+        /// @brief View onto the whole contents of the file
+        std::string_view View() const
+        { return std::string_view(_data, _size); }
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+// Views onto tokens
+#include <string_view>
+
+// Number conversion without copies nor locales
+#include <charconv>
+#include <system_error>
+#include <type_traits>
+
+/// @brief Cursor over the whitespace-delimited tokens of a line
+/// @remark Tokens are views onto the line, so it must outlive them.
+/// Numbers are converted in place via std::from_chars
+class TokenCursor {
+    private:
+        /// @brief Remainder of the line yet to be tokenized
+        std::string_view _rest;
+
+        /// @brief Whether a character delimits tokens
+        static constexpr bool IsSpace(char character) {
+            return character == ' ' || character == '\t' ||
+                character == '\r' || character == '\v' || character == '\f';
+        }
+
+    public:
+        /// @brief Start tokenizing a given line
+        /// @param line Line to tokenize (without its line break)
+        explicit TokenCursor(std::string_view line) : _rest(line) {}
+
+        /// @brief Take the next token on the line
+        /// @param token Returned-by-parameter view onto the token
+        /// @return True if there was one, false if the line ran out
+        bool Next(std::string_view& token) {
+            std::size_t first = 0;
+            while (first < _rest.size() && IsSpace(_rest[first])) {
+                ++first;
+            }
+
+            std::size_t last = first;
+            while (last < _rest.size() && !IsSpace(_rest[last])) {
+                ++last;
+            }
+
+            token = _rest.substr(first, last - first);
+            _rest.remove_prefix(last);
+
+            return !token.empty();
+        }
+
+        /// @brief Take the next token on the line, as a number
+        /// @tparam Number Arithmetic type to convert the token to
+        /// @param value Returned-by-parameter value of the token
+        /// @return True if there was a token and it was wholly a number
+        /// of that type, false otherwise
+        template <typename Number>
+        requires std::is_arithmetic_v<Number>
+        bool Next(Number& value) {
+            std::string_view token;
+            if (!Next(token)) {
+                return false;
+            }
+
+            // Accept explicit positive signs (like stream extraction does)
+            if (token.size() > 1 && token.front() == '+') {
+                token.remove_prefix(1);
+            }
+
+            const char* end = token.data() + token.size();
+            const auto [stop, error] = std::from_chars(token.data(), end, value);
+
+            return error == std::errc{} && stop == end;
+        }
+};